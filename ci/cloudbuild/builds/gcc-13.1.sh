@@ -26,6 +26,9 @@ mapfile -t cmake_args < <(cmake::common_args)
 mapfile -t vcpkg_args < <(vcpkg::cmake_args)
 io::run cmake "${cmake_args[@]}" "${vcpkg_args[@]}" \
   -DFUNCTIONS_FRAMEWORK_CPP_ENABLE_WERROR=ON \
+  -DFUNCTIONS_FRAMEWORK_CPP_ENABLE_HTTP2=ON \
+  -DFUNCTIONS_FRAMEWORK_CPP_ENABLE_COMPRESSION=ON \
+  -DFUNCTIONS_FRAMEWORK_CPP_ENABLE_SIMDJSON=ON \
   -DCMAKE_BUILD_TYPE=Release \
   -DCMAKE_CXX_COMPILER=g++
 io::run cmake --build cmake-out
@@ -0,0 +1,48 @@
+# ~~~
+# Copyright 2026 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ~~~
+
+#
+# Find the nghttp2 library and define the `Nghttp2::nghttp2` imported target.
+#
+# nghttp2 does not install a CMake package configuration file, so we search
+# for the header and library directly.
+#
+find_path(Nghttp2_INCLUDE_DIR NAMES nghttp2/nghttp2.h)
+find_library(Nghttp2_LIBRARY NAMES nghttp2)
+mark_as_advanced(Nghttp2_INCLUDE_DIR Nghttp2_LIBRARY)
+
+if (Nghttp2_INCLUDE_DIR AND EXISTS
+                            "${Nghttp2_INCLUDE_DIR}/nghttp2/nghttp2ver.h")
+    file(STRINGS "${Nghttp2_INCLUDE_DIR}/nghttp2/nghttp2ver.h" _version_line
+         REGEX "^#define NGHTTP2_VERSION \"[^\"]*\"")
+    string(REGEX REPLACE "^#define NGHTTP2_VERSION \"([^\"]*)\"" "\\1"
+                         Nghttp2_VERSION "${_version_line}")
+    unset(_version_line)
+endif ()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+    Nghttp2
+    REQUIRED_VARS Nghttp2_LIBRARY Nghttp2_INCLUDE_DIR
+    VERSION_VAR Nghttp2_VERSION)
+
+if (Nghttp2_FOUND AND NOT TARGET Nghttp2::nghttp2)
+    add_library(Nghttp2::nghttp2 UNKNOWN IMPORTED)
+    set_target_properties(
+        Nghttp2::nghttp2
+        PROPERTIES IMPORTED_LOCATION "${Nghttp2_LIBRARY}"
+                   INTERFACE_INCLUDE_DIRECTORIES "${Nghttp2_INCLUDE_DIR}")
+endif ()
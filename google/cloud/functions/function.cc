@@ -29,6 +29,24 @@ Function MakeFunction(UserHttpFunction function) {
           std::move(function)));
 }
 
+Function MakeFunction(UserHttpViewFunction function) {
+  return functions_internal::FunctionImpl::MakeFunction(
+      std::make_shared<functions_internal::BaseFunctionImpl>(
+          std::move(function)));
+}
+
+Function MakeFunction(UserHttpStreamingFunction function) {
+  return functions_internal::FunctionImpl::MakeFunction(
+      std::make_shared<functions_internal::BaseFunctionImpl>(
+          std::move(function)));
+}
+
+Function MakeFunction(UserHttpWriterFunction function) {
+  return functions_internal::FunctionImpl::MakeFunction(
+      std::make_shared<functions_internal::BaseFunctionImpl>(
+          std::move(function)));
+}
+
 Function MakeFunction(UserCloudEventFunction function) {
   return functions_internal::FunctionImpl::MakeFunction(
       std::make_shared<functions_internal::BaseFunctionImpl>(
@@ -41,5 +59,11 @@ Function MakeFunction(std::map<std::string, Function> mapping) {
           std::move(mapping)));
 }
 
+Function WithPreBodyHook(Function function, UserPreBodyHook hook) {
+  return functions_internal::FunctionImpl::MakeFunction(
+      std::make_shared<functions_internal::PreBodyHookFunctionImpl>(
+          std::move(function), std::move(hook)));
+}
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions
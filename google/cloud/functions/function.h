@@ -79,9 +79,40 @@ class Function {
 /// Wraps an `http` handler.
 Function MakeFunction(UserHttpFunction function);
 
+/// Wraps an `http` handler that reads a view of the request, see
+/// `HttpRequestView`.
+Function MakeFunction(UserHttpViewFunction function);
+
+/// Wraps an `http` handler that reads the request body incrementally.
+Function MakeFunction(UserHttpStreamingFunction function);
+
+/// Wraps an `http` handler that writes the response incrementally.
+Function MakeFunction(UserHttpWriterFunction function);
+
 /// Wraps a `cloud event` handler.
 Function MakeFunction(UserCloudEventFunction function);
 
+/**
+ * Adds a hook to inspect each request before its body is read.
+ *
+ * @par Example
+ * @code
+ * namespace gcf = ::google::cloud::functions;
+ * auto MyFunction() {
+ *   return gcf::WithPreBodyHook(
+ *       gcf::MakeFunction(Upload),
+ *       [](gcf::HttpRequest const& r) -> std::optional<gcf::HttpResponse> {
+ *         if (r.headers().count("Authorization") != 0) return std::nullopt;
+ *         return gcf::HttpResponse{}.set_result(
+ *             gcf::HttpResponse::kUnauthorized);
+ *       });
+ * }
+ * @endcode
+ *
+ * @see UserPreBodyHook for the requirements on @p hook.
+ */
+Function WithPreBodyHook(Function function, UserPreBodyHook hook);
+
 /**
  * Creates a function with support for runtime-assigned targets.
  *
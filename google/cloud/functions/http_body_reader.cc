@@ -0,0 +1,23 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_body_reader.h"
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+HttpBodyReader::Impl::~Impl() = default;
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
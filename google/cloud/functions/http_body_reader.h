@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_BODY_READER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_BODY_READER_H
+
+#include "google/cloud/functions/version.h"
+#include <cstddef>
+#include <memory>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Reads the body of an HTTP request incrementally.
+ *
+ * Functions created from a `UserHttpStreamingFunction` receive an object of
+ * this type. The function can process large request bodies in constant
+ * memory, reading the body as it arrives over the connection.
+ *
+ * The reader is only valid while the function runs. Any part of the body not
+ * read by the function is discarded, and the connection is closed after the
+ * response is sent.
+ */
+class HttpBodyReader {
+ public:
+  /**
+   * Reads up to @p size bytes of the request body into @p buffer.
+   *
+   * Blocks until some data is available. Each call waits at most for the
+   * configured `--body-read-timeout`.
+   *
+   * @return the number of bytes read, 0 once the full body has been read.
+   * @throws std::runtime_error if the body cannot be read, e.g., because the
+   *     client closed the connection, the read timed out, or the body exceeds
+   *     `--max-body-bytes`.
+   */
+  std::size_t Read(char* buffer, std::size_t size) {
+    return impl_->Read(buffer, size);
+  }
+
+  class Impl {
+   public:
+    virtual ~Impl() = 0;
+    virtual std::size_t Read(char* buffer, std::size_t size) = 0;
+  };
+
+  explicit HttpBodyReader(std::unique_ptr<Impl> impl)
+      : impl_(std::move(impl)) {}
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_BODY_READER_H
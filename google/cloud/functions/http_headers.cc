@@ -0,0 +1,200 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_headers.h"
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// Field names are ASCII tokens, a locale-independent `tolower()` is enough.
+char ToLower(char c) {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Loads 8 bytes as a big-endian integer, so comparing the integers gives the
+// same order as comparing the bytes.
+std::uint64_t Load(char const* p) {
+  std::uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return boost::endian::big_to_native(v);
+}
+
+// Converts the ASCII uppercase letters in 8 bytes to lowercase.
+std::uint64_t ToLower(std::uint64_t v) {
+  auto constexpr kOnes = ~std::uint64_t{0} / 0xFF;
+  auto constexpr kHigh = kOnes * 0x80;
+  auto const heptets = v & ~kHigh;
+  // The high bit of each byte is set if the byte is in `[A-Z]`.
+  auto const ge_a = heptets + kOnes * (0x80 - 'A');
+  auto const gt_z = heptets + kOnes * (0x80 - 'Z' - 1);
+  auto const upper = (ge_a ^ gt_z) & ~v & kHigh;
+  return v | (upper >> 2);
+}
+
+auto constexpr kKeySize = sizeof(std::uint64_t);
+
+// The first 8 bytes of the lowercase name, zero padded. Comparing two keys
+// gives the same order as comparing the prefixes, as names do not contain
+// NUL characters.
+std::uint64_t NameKey(std::string_view name) {
+  if (name.size() >= kKeySize) return ToLower(Load(name.data()));
+  std::uint64_t key = 0;
+  for (std::size_t i = 0; i != kKeySize; ++i) {
+    auto const c = i < name.size() ? ToLower(name[i]) : '\0';
+    key = (key << 8) | static_cast<unsigned char>(c);
+  }
+  return key;
+}
+
+// Compares the names ignoring case, 8 bytes at a time. Most names have the
+// same case, and the exact comparison skips the conversions.
+int CompareIgnoreCase(std::string_view a, std::string_view b) {
+  auto const n = std::min(a.size(), b.size());
+  std::size_t i = 0;
+  for (; i + kKeySize <= n; i += kKeySize) {
+    auto x = Load(a.data() + i);
+    auto y = Load(b.data() + i);
+    if (x == y) continue;
+    x = ToLower(x);
+    y = ToLower(y);
+    if (x != y) return x < y ? -1 : 1;
+  }
+  for (; i != n; ++i) {
+    auto const x = static_cast<unsigned char>(ToLower(a[i]));
+    auto const y = static_cast<unsigned char>(ToLower(b[i]));
+    if (x != y) return x < y ? -1 : 1;
+  }
+  if (a.size() == b.size()) return 0;
+  return a.size() < b.size() ? -1 : 1;
+}
+
+// Compares the names after the key, if the keys are equal.
+int CompareSuffix(std::string_view a, std::string_view b) {
+  return CompareIgnoreCase(a.substr(std::min(a.size(), kKeySize)),
+                           b.substr(std::min(b.size(), kKeySize)));
+}
+
+}  // namespace
+
+HttpHeaders::HttpHeaders(std::initializer_list<value_type> fields) {
+  reserve(fields.size());
+  for (auto const& f : fields) insert(f.first, f.second);
+}
+
+HttpHeaders::const_iterator HttpHeaders::find(std::string_view name) const {
+  auto const key = NameKey(name);
+  auto const l = LowerBound(key, name);
+  if (l == slots_.end() || Compare(*l, key, name) != 0) return end();
+  return At(static_cast<std::size_t>(l - slots_.begin()));
+}
+
+HttpHeaders::size_type HttpHeaders::count(std::string_view name) const {
+  auto const [begin, end] = SlotRange(name);
+  return static_cast<size_type>(end - begin);
+}
+
+std::pair<HttpHeaders::const_iterator, HttpHeaders::const_iterator>
+HttpHeaders::equal_range(std::string_view name) const {
+  auto const [begin, end] = SlotRange(name);
+  return {At(static_cast<std::size_t>(begin - slots_.begin())),
+          At(static_cast<std::size_t>(end - slots_.begin()))};
+}
+
+HttpHeaders::const_iterator HttpHeaders::insert(std::string name,
+                                                std::string value) {
+  auto const key = NameKey(name);
+  auto const end = UpperBound(key, name);
+  auto const pos = static_cast<std::size_t>(end - slots_.begin());
+  slots_.insert(end, Slot{key, fields_.size()});
+  fields_.emplace_back(std::move(name), std::move(value));
+  return At(pos);
+}
+
+HttpHeaders::const_iterator HttpHeaders::set(std::string name,
+                                             std::string value) {
+  auto const [begin, end] = SlotRange(name);
+  if (begin == end) return insert(std::move(name), std::move(value));
+  auto const pos = static_cast<std::size_t>(begin - slots_.begin());
+  fields_[begin->index] = value_type(std::move(name), std::move(value));
+  EraseSlots(std::next(begin), end);
+  return At(pos);
+}
+
+HttpHeaders::size_type HttpHeaders::erase(std::string_view name) {
+  auto const [begin, end] = SlotRange(name);
+  auto const n = static_cast<size_type>(end - begin);
+  EraseSlots(begin, end);
+  return n;
+}
+
+std::pair<HttpHeaders::SlotIterator, HttpHeaders::SlotIterator>
+HttpHeaders::SlotRange(std::string_view name) const {
+  auto const key = NameKey(name);
+  auto const lower = LowerBound(key, name);
+  auto const upper =
+      std::partition_point(lower, slots_.end(), [&](Slot const& s) {
+        return Compare(s, key, name) == 0;
+      });
+  return {lower, upper};
+}
+
+HttpHeaders::SlotIterator HttpHeaders::LowerBound(
+    std::uint64_t key, std::string_view name) const {
+  return std::partition_point(
+      slots_.begin(), slots_.end(),
+      [&](Slot const& s) { return Compare(s, key, name) < 0; });
+}
+
+HttpHeaders::SlotIterator HttpHeaders::UpperBound(
+    std::uint64_t key, std::string_view name) const {
+  return std::partition_point(
+      slots_.begin(), slots_.end(),
+      [&](Slot const& s) { return Compare(s, key, name) <= 0; });
+}
+
+int HttpHeaders::Compare(Slot const& slot, std::uint64_t key,
+                         std::string_view name) const {
+  if (slot.key != key) return slot.key < key ? -1 : 1;
+  return CompareSuffix(fields_[slot.index].first, name);
+}
+
+void HttpHeaders::EraseSlots(SlotIterator first, SlotIterator last) {
+  if (first == last) return;
+  // Compact the fields in a single pass, recording the new position of each
+  // field, then renumber the remaining slots.
+  auto constexpr kErased = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> position(fields_.size(), 0);
+  for (auto i = first; i != last; ++i) position[i->index] = kErased;
+  std::size_t n = 0;
+  for (std::size_t i = 0; i != fields_.size(); ++i) {
+    if (position[i] == kErased) continue;
+    if (n != i) fields_[n] = std::move(fields_[i]);
+    position[i] = n++;
+  }
+  fields_.resize(n);
+  slots_.erase(first, last);
+  for (auto& s : slots_) s.index = position[s.index];
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,202 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_HEADERS_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_HEADERS_H
+
+#include "google/cloud/functions/version.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * The header fields in an HTTP request or response.
+ *
+ * Field names are case-insensitive (RFC 7230 3.2), for example,
+ * `find("content-type")` finds a `Content-Type` field. Fields with the same
+ * name keep the order in which they were inserted.
+ *
+ * The fields are stored in a vector, in the order they were inserted, with a
+ * separate index sorted by name. Lookups are a binary search over the index,
+ * without allocations, and inserting a field moves a few bytes per field,
+ * instead of the (name, value) pairs. Iterating visits the fields sorted by
+ * name.
+ *
+ * @par Compatibility
+ * Before v1.3.0 `HttpRequest::HeadersType` was a
+ * `std::multimap<std::string, std::string>`, and `HttpResponse::HeadersType`
+ * a `std::map<std::string, std::string>`. This class provides the same
+ * read-only members, and converts implicitly to either type, so existing code
+ * that stores the headers in those types continues to work.
+ */
+class HttpHeaders {
+  // An entry in the sorted index. `key` holds the first bytes of the
+  // lowercase name, so most comparisons do not need to look at the name.
+  struct Slot {
+    std::uint64_t key;
+    std::size_t index;
+  };
+
+ public:
+  using key_type = std::string;
+  using mapped_type = std::string;
+  using value_type = std::pair<std::string, std::string>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type const&;
+  using const_reference = value_type const&;
+  using pointer = value_type const*;
+  using const_pointer = value_type const*;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = HttpHeaders::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type const*;
+    using reference = value_type const&;
+
+    const_iterator() = default;
+
+    reference operator*() const { return fields_[slot_->index]; }
+    pointer operator->() const { return &fields_[slot_->index]; }
+
+    const_iterator& operator++() {
+      ++slot_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto tmp = *this;
+      ++slot_;
+      return tmp;
+    }
+    const_iterator& operator--() {
+      --slot_;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      auto tmp = *this;
+      --slot_;
+      return tmp;
+    }
+
+    friend bool operator==(const_iterator a, const_iterator b) {
+      return a.slot_ == b.slot_;
+    }
+    friend bool operator!=(const_iterator a, const_iterator b) {
+      return !(a == b);
+    }
+
+   private:
+    friend class HttpHeaders;
+    const_iterator(value_type const* fields, Slot const* slot)
+        : fields_(fields), slot_(slot) {}
+
+    value_type const* fields_ = nullptr;
+    Slot const* slot_ = nullptr;
+  };
+  using iterator = const_iterator;
+
+  HttpHeaders() = default;
+  HttpHeaders(std::initializer_list<value_type> fields);
+
+  [[nodiscard]] const_iterator begin() const { return At(0); }
+  [[nodiscard]] const_iterator end() const { return At(slots_.size()); }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+  [[nodiscard]] size_type size() const { return fields_.size(); }
+  [[nodiscard]] bool empty() const { return fields_.empty(); }
+
+  /// The first field named @p name, or `end()` if there is none.
+  [[nodiscard]] const_iterator find(std::string_view name) const;
+
+  /// The number of fields named @p name.
+  [[nodiscard]] size_type count(std::string_view name) const;
+
+  /// All the fields named @p name.
+  [[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(
+      std::string_view name) const;
+
+  /// Adds a field, after any other fields with the same name.
+  const_iterator insert(std::string name, std::string value);
+  const_iterator emplace(std::string name, std::string value) {
+    return insert(std::move(name), std::move(value));
+  }
+
+  /// Replaces all the fields named @p name with a single field.
+  const_iterator set(std::string name, std::string value);
+
+  /// Removes all the fields named @p name, returns the number removed.
+  size_type erase(std::string_view name);
+
+  void clear() {
+    fields_.clear();
+    slots_.clear();
+  }
+  void reserve(size_type n) {
+    fields_.reserve(n);
+    slots_.reserve(n);
+  }
+
+  /// Converts to the `HttpRequest::HeadersType` used before v1.3.0.
+  operator std::multimap<std::string, std::string>() const {  // NOLINT
+    return {begin(), end()};
+  }
+  /// Converts to the `HttpResponse::HeadersType` used before v1.3.0, keeping
+  /// the first field for each name.
+  operator std::map<std::string, std::string>() const {  // NOLINT
+    return {begin(), end()};
+  }
+
+  friend bool operator==(HttpHeaders const& lhs, HttpHeaders const& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+  friend bool operator!=(HttpHeaders const& lhs, HttpHeaders const& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  using SlotIterator = std::vector<Slot>::const_iterator;
+
+  [[nodiscard]] const_iterator At(std::size_t slot) const {
+    return const_iterator(fields_.data(), slots_.data() + slot);
+  }
+  [[nodiscard]] std::pair<SlotIterator, SlotIterator> SlotRange(
+      std::string_view name) const;
+  [[nodiscard]] SlotIterator LowerBound(std::uint64_t key,
+                                        std::string_view name) const;
+  [[nodiscard]] SlotIterator UpperBound(std::uint64_t key,
+                                        std::string_view name) const;
+  [[nodiscard]] int Compare(Slot const& slot, std::uint64_t key,
+                            std::string_view name) const;
+  void EraseSlots(SlotIterator first, SlotIterator last);
+
+  std::vector<value_type> fields_;
+  std::vector<Slot> slots_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_HEADERS_H
@@ -0,0 +1,150 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_headers.h"
+#include <gmock/gmock.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using value_type = HttpHeaders::value_type;
+
+TEST(HttpHeadersTest, Empty) {
+  HttpHeaders const actual;
+  EXPECT_THAT(actual, IsEmpty());
+  EXPECT_EQ(actual.size(), 0);
+  EXPECT_EQ(actual.find("content-type"), actual.end());
+  EXPECT_EQ(actual.count("content-type"), 0);
+}
+
+TEST(HttpHeadersTest, FindIgnoresCase) {
+  HttpHeaders actual;
+  actual.insert("Content-Type", "application/json");
+  actual.insert("x-goog-test", "a");
+  for (auto const* name : {"content-type", "Content-Type", "CONTENT-TYPE"}) {
+    auto const f = actual.find(name);
+    ASSERT_NE(f, actual.end()) << name;
+    EXPECT_EQ(f->first, "Content-Type");
+    EXPECT_EQ(f->second, "application/json");
+    EXPECT_EQ(actual.count(name), 1);
+  }
+  EXPECT_EQ(actual.find("content"), actual.end());
+  EXPECT_EQ(actual.find("content-type-x"), actual.end());
+  EXPECT_EQ(actual.find("X-Goog-Test")->second, "a");
+}
+
+TEST(HttpHeadersTest, InsertKeepsOrder) {
+  HttpHeaders actual;
+  actual.insert("x-repeated", "1");
+  actual.insert("Accept", "*/*");
+  actual.insert("X-Repeated", "2");
+  actual.insert("b-header", "b");
+  actual.emplace("x-repeated", "3");
+  EXPECT_THAT(actual, ElementsAre(value_type("Accept", "*/*"),
+                                  value_type("b-header", "b"),
+                                  value_type("x-repeated", "1"),
+                                  value_type("X-Repeated", "2"),
+                                  value_type("x-repeated", "3")));
+  auto const [begin, end] = actual.equal_range("X-REPEATED");
+  EXPECT_EQ(std::distance(begin, end), 3);
+  EXPECT_EQ(actual.find("x-repeated")->second, "1");
+}
+
+TEST(HttpHeadersTest, Set) {
+  HttpHeaders actual{{"x-repeated", "1"}, {"x-repeated", "2"}, {"a", "a"}};
+  auto const f = actual.set("X-Repeated", "3");
+  EXPECT_EQ(f->second, "3");
+  EXPECT_THAT(actual, ElementsAre(value_type("a", "a"),
+                                  value_type("X-Repeated", "3")));
+  actual.set("b", "b");
+  EXPECT_THAT(actual, ElementsAre(value_type("a", "a"), value_type("b", "b"),
+                                  value_type("X-Repeated", "3")));
+}
+
+TEST(HttpHeadersTest, Erase) {
+  HttpHeaders actual{{"x-repeated", "1"}, {"X-Repeated", "2"}, {"a", "a"}};
+  EXPECT_EQ(actual.erase("x-REPEATED"), 2);
+  EXPECT_EQ(actual.erase("missing"), 0);
+  EXPECT_THAT(actual, ElementsAre(value_type("a", "a")));
+  actual.clear();
+  EXPECT_THAT(actual, IsEmpty());
+}
+
+TEST(HttpHeadersTest, EraseMany) {
+  HttpHeaders actual;
+  for (int i = 0; i != 100; ++i) {
+    actual.insert(i % 2 == 0 ? "x-even" : "x-odd", std::to_string(i));
+  }
+  actual.insert("a", "a");
+  EXPECT_EQ(actual.erase("x-even"), 50);
+  EXPECT_EQ(actual.size(), 51);
+  EXPECT_EQ(actual.find("a")->second, "a");
+  auto const [begin, end] = actual.equal_range("x-odd");
+  std::vector<std::string> values;
+  for (auto i = begin; i != end; ++i) values.push_back(i->second);
+  ASSERT_EQ(values.size(), 50);
+  EXPECT_EQ(values.front(), "1");
+  EXPECT_EQ(values.back(), "99");
+}
+
+TEST(HttpHeadersTest, ConvertsToStandardMaps) {
+  HttpHeaders const headers{
+      {"b", "1"}, {"a", "2"}, {"x-repeated", "3"}, {"x-repeated", "4"}};
+  std::multimap<std::string, std::string> const multimap = headers;
+  EXPECT_THAT(multimap, ElementsAre(value_type("a", "2"), value_type("b", "1"),
+                                    value_type("x-repeated", "3"),
+                                    value_type("x-repeated", "4")));
+  std::map<std::string, std::string> const map = headers;
+  EXPECT_THAT(map, ElementsAre(value_type("a", "2"), value_type("b", "1"),
+                               value_type("x-repeated", "3")));
+}
+
+TEST(HttpHeadersTest, LongNames) {
+  // These names share a prefix longer than the index keys.
+  HttpHeaders actual{{"x-forwarded-proto", "https"},
+                     {"X-Forwarded-For", "10.0.0.1"},
+                     {"x-forwarded-for", "10.0.0.2"},
+                     {"x-forwarded", "-"}};
+  EXPECT_THAT(actual, ElementsAre(value_type("x-forwarded", "-"),
+                                  value_type("X-Forwarded-For", "10.0.0.1"),
+                                  value_type("x-forwarded-for", "10.0.0.2"),
+                                  value_type("x-forwarded-proto", "https")));
+  EXPECT_EQ(actual.count("X-FORWARDED-FOR"), 2);
+  EXPECT_EQ(actual.find("x-forwarded-fo"), actual.end());
+
+  // Removing fields keeps the remaining fields in place.
+  EXPECT_EQ(actual.erase("x-forwarded-for"), 2);
+  actual.insert("x-forwarded-for", "10.0.0.3");
+  EXPECT_THAT(actual, ElementsAre(value_type("x-forwarded", "-"),
+                                  value_type("x-forwarded-for", "10.0.0.3"),
+                                  value_type("x-forwarded-proto", "https")));
+}
+
+TEST(HttpHeadersTest, Equality) {
+  HttpHeaders const a{{"b", "1"}, {"a", "2"}};
+  HttpHeaders const b{{"a", "2"}, {"b", "1"}};
+  HttpHeaders const c{{"a", "2"}};
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,70 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_request.h"
+#include <memory>
+#include <utility>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// Splits the target into the (encoded) path and query. Servers see
+// absolute-form targets, e.g. `http://host/path`, only from proxies, but they
+// are valid (RFC 7230 5.3.2).
+std::pair<std::string_view, std::string_view> SplitTarget(
+    std::string_view target) {
+  target = target.substr(0, target.find('#'));
+  auto const q = target.find('?');
+  auto path = target.substr(0, q);
+  auto const query = q == std::string_view::npos ? std::string_view{}
+                                                 : target.substr(q + 1);
+  if (!path.empty() && path.front() != '/') {
+    auto const scheme = path.find("://");
+    if (scheme != std::string_view::npos) {
+      auto const slash = path.find('/', scheme + 3);
+      path = slash == std::string_view::npos ? std::string_view{"/"}
+                                             : path.substr(slash);
+    }
+  }
+  return {path, query};
+}
+
+}  // namespace
+
+std::string const& HttpRequest::path() const {
+  return path_.Get([this] {
+    return std::make_shared<std::string const>(
+        PercentDecode(SplitTarget(target_).first));
+  });
+}
+
+std::string_view HttpRequest::query() const {
+  return SplitTarget(target_).second;
+}
+
+QueryParameters const& HttpRequest::query_parameters() const {
+  return query_parameters_.Get([this] {
+    return std::make_shared<QueryParameters const>(
+        ParseFormUrlEncoded(query()));
+  });
+}
+
+JsonBody const& HttpRequest::json() const {
+  return json_.Get(
+      [this] { return std::make_shared<JsonBody const>(payload_); });
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
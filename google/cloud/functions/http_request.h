@@ -15,10 +15,14 @@
 #ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_REQUEST_H
 #define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_REQUEST_H
 
+#include "google/cloud/functions/http_headers.h"
+#include "google/cloud/functions/json_body.h"
+#include "google/cloud/functions/url_encoding.h"
 #include "google/cloud/functions/version.h"
-#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace google::cloud::functions {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -30,7 +34,7 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
  */
 class HttpRequest {
  public:
-  using HeadersType = std::multimap<std::string, std::string>;
+  using HeadersType = HttpHeaders;
 
   HttpRequest() = default;
 
@@ -40,11 +44,43 @@ class HttpRequest {
   /// The target object for the request, e.g, `/index.html`.
   [[nodiscard]] std::string const& target() const { return target_; }
 
+  /**
+   * The path in `target()`, with any `%XX` escapes decoded.
+   *
+   * For example, the path for `/a%20b/c?q=1` is `/a b/c`. The path is decoded
+   * on the first call, and cached until the target changes.
+   */
+  [[nodiscard]] std::string const& path() const;
+
+  /// The query string in `target()`, without the `?`, and not decoded.
+  [[nodiscard]] std::string_view query() const;
+
+  /**
+   * The decoded query parameters in `target()`.
+   *
+   * The parameters are parsed on the first call, and cached until the target
+   * changes.
+   */
+  [[nodiscard]] QueryParameters const& query_parameters() const;
+
   /// The request payload
   [[nodiscard]] std::string const& payload() const& { return payload_; }
-  [[nodiscard]] std::string&& payload() && { return std::move(payload_); }
+  [[nodiscard]] std::string&& payload() && {
+    json_.reset();
+    return std::move(payload_);
+  }
 
-  /// The request HTTP headers
+  /**
+   * The request payload, parsed as JSON.
+   *
+   * The payload is parsed on the first call, and cached until the payload
+   * changes. Copies of the request share the parsed payload.
+   *
+   * @throws std::invalid_argument if the payload is not valid JSON.
+   */
+  [[nodiscard]] JsonBody const& json() const;
+
+  /// The request HTTP headers, names are compared case-insensitively.
   [[nodiscard]] HeadersType const& headers() const { return headers_; }
 
   /// The HTTP version for the request
@@ -61,6 +97,8 @@ class HttpRequest {
 
   HttpRequest& set_target(std::string v) & {
     target_ = std::move(v);
+    path_.reset();
+    query_parameters_.reset();
     return *this;
   }
   HttpRequest&& set_target(std::string v) && {
@@ -69,6 +107,7 @@ class HttpRequest {
 
   HttpRequest& set_payload(std::string v) & {
     payload_ = std::move(v);
+    json_.reset();
     return *this;
   }
   HttpRequest&& set_payload(std::string v) && {
@@ -82,7 +121,7 @@ class HttpRequest {
   HttpRequest&& clear_headers() && { return std::move(clear_headers()); }
 
   HttpRequest& add_header(std::string k, std::string v) & {
-    headers_.emplace(std::move(k), std::move(v));
+    headers_.insert(std::move(k), std::move(v));
     return *this;
   }
   HttpRequest&& add_header(std::string k, std::string v) && {
@@ -107,12 +146,58 @@ class HttpRequest {
   }
 
  private:
+  /**
+   * A value computed on first use, and shared by the copies of the request.
+   *
+   * The value is published with an atomic compare-and-swap, so concurrent
+   * `const` calls are safe. If two threads compute the value at the same time
+   * both get the value stored first.
+   */
+  template <typename T>
+  class Lazy {
+   public:
+    Lazy() = default;
+    Lazy(Lazy const& rhs) : value_(rhs.Load()) {}
+    Lazy& operator=(Lazy const& rhs) {
+      value_ = rhs.Load();
+      return *this;
+    }
+    Lazy(Lazy&&) noexcept = default;
+    Lazy& operator=(Lazy&&) noexcept = default;
+    ~Lazy() = default;
+
+    /// Returns the value, calling @p make to create it on the first call.
+    template <typename Make>
+    T const& Get(Make&& make) const {
+      auto value = Load();
+      if (!value) {
+        auto created = std::forward<Make>(make)();
+        if (std::atomic_compare_exchange_strong(&value_, &value, created)) {
+          value = std::move(created);
+        }
+      }
+      return *value;
+    }
+
+    void reset() { value_.reset(); }
+
+   private:
+    std::shared_ptr<T const> Load() const { return std::atomic_load(&value_); }
+
+    mutable std::shared_ptr<T const> value_;
+  };
+
   std::string verb_;
   std::string target_;
   std::string payload_;
   HeadersType headers_;
   int version_major_ = 1;
   int version_minor_ = 1;
+  // Lazily parsed from `target_`.
+  Lazy<std::string> path_;
+  Lazy<QueryParameters> query_parameters_;
+  // Lazily parsed from `payload_`.
+  Lazy<JsonBody> json_;
 };
 
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
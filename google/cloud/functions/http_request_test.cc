@@ -14,6 +14,10 @@
 
 #include "google/cloud/functions/http_request.h"
 #include <gmock/gmock.h>
+#include <future>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace google::cloud::functions {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -21,6 +25,7 @@ namespace {
 
 using ::testing::ElementsAre;
 using ::testing::IsEmpty;
+using ::testing::Pair;
 
 TEST(HttpRequestTest, Default) {
   auto const actual = HttpRequest{};
@@ -67,12 +72,117 @@ TEST(HttpRequestTest, RemoveHeader) {
   EXPECT_THAT(actual.headers(), ElementsAre(value_type("abc-header", "2")));
 }
 
+TEST(HttpRequestTest, HeadersIgnoreCase) {
+  auto const actual = HttpRequest{}
+                          .add_header("Content-Type", "application/json")
+                          .add_header("X-Repeated", "1");
+  auto const f = actual.headers().find("content-type");
+  ASSERT_NE(f, actual.headers().end());
+  EXPECT_EQ(f->second, "application/json");
+  auto copy = actual;
+  copy.remove_header("x-repeated");
+  EXPECT_EQ(copy.headers().count("X-Repeated"), 0);
+}
+
 TEST(HttpRequestTest, ClearHeaders) {
   auto const actual =
       HttpRequest{}.add_header("abc-header", "2").clear_headers();
   EXPECT_THAT(actual.headers(), IsEmpty());
 }
 
+TEST(HttpRequestTest, PathAndQuery) {
+  auto const actual =
+      HttpRequest{}.set_target("/api/v1/a%20b?name=Jane+Doe&tag=x&tag=y");
+  EXPECT_EQ(actual.path(), "/api/v1/a b");
+  EXPECT_EQ(actual.query(), "name=Jane+Doe&tag=x&tag=y");
+  auto const& params = actual.query_parameters();
+  EXPECT_THAT(params, ElementsAre(Pair("name", "Jane Doe"), Pair("tag", "x"),
+                                  Pair("tag", "y")));
+  // The values are cached.
+  EXPECT_EQ(&actual.query_parameters(), &params);
+  EXPECT_EQ(&actual.path(), &actual.path());
+}
+
+TEST(HttpRequestTest, PathAndQueryEdgeCases) {
+  auto actual = HttpRequest{}.set_target("/index.html");
+  EXPECT_EQ(actual.path(), "/index.html");
+  EXPECT_THAT(actual.query(), IsEmpty());
+  EXPECT_THAT(actual.query_parameters(), IsEmpty());
+
+  // Changing the target discards any cached values.
+  actual.set_target("/search?q=a%2Bb#results");
+  EXPECT_EQ(actual.path(), "/search");
+  EXPECT_EQ(actual.query(), "q=a%2Bb");
+  EXPECT_THAT(actual.query_parameters(), ElementsAre(Pair("q", "a+b")));
+
+  actual.set_target("http://example.com/a/b?x=1");
+  EXPECT_EQ(actual.path(), "/a/b");
+  EXPECT_EQ(actual.query(), "x=1");
+  actual.set_target("http://example.com?x=1");
+  EXPECT_EQ(actual.path(), "/");
+  actual.set_target("*");
+  EXPECT_EQ(actual.path(), "*");
+}
+
+TEST(HttpRequestTest, PathAndQueryConcurrent) {
+  auto const request = HttpRequest{}.set_target("/a%20b?x=1&y=2");
+  // All the threads see the same cached values.
+  std::vector<std::future<std::pair<void const*, void const*>>> tasks;
+  for (int i = 0; i != 8; ++i) {
+    tasks.push_back(std::async(std::launch::async, [&request] {
+      return std::make_pair<void const*, void const*>(
+          &request.path(), &request.query_parameters());
+    }));
+  }
+  for (auto& t : tasks) {
+    auto const [path, params] = t.get();
+    EXPECT_EQ(path, &request.path());
+    EXPECT_EQ(params, &request.query_parameters());
+  }
+
+  // Copies share the cached values.
+  auto const copy = request;
+  EXPECT_EQ(&copy.path(), &request.path());
+  EXPECT_EQ(copy.path(), "/a b");
+}
+
+TEST(HttpRequestTest, Json) {
+  HttpRequest actual;
+  actual.set_payload(R"js({"topic": "a", "count": 1})js");
+  auto const& json = actual.json();
+  EXPECT_EQ(&json, &actual.json());
+  EXPECT_EQ(json.GetString("/topic").value_or(""), "a");
+  EXPECT_EQ(json.GetInt64("/count").value_or(0), 1);
+
+  // Copies share the parsed body, changing the payload discards it.
+  auto copy = actual;
+  EXPECT_EQ(&copy.json(), &json);
+  copy.set_payload(R"js({"topic": "b"})js");
+  EXPECT_EQ(copy.json().GetString("/topic").value_or(""), "b");
+  EXPECT_EQ(actual.json().GetString("/topic").value_or(""), "a");
+
+  // Moving the payload out discards the parsed body.
+  auto moved = std::move(copy).payload();
+  EXPECT_EQ(moved, R"js({"topic": "b"})js");
+  EXPECT_THROW((void)copy.json(),  // NOLINT(bugprone-use-after-move)
+               std::invalid_argument);
+
+  actual.set_payload("not json");
+  EXPECT_THROW((void)actual.json().GetString("/topic"), std::invalid_argument);
+}
+
+TEST(HttpRequestTest, JsonConcurrent) {
+  auto const request = HttpRequest{}.set_payload(R"js({"topic": "a"})js");
+  // All the threads see the same parsed body.
+  std::vector<std::future<JsonBody const*>> tasks;
+  for (int i = 0; i != 8; ++i) {
+    tasks.push_back(std::async(std::launch::async,
+                               [&request] { return &request.json(); }));
+  }
+  for (auto& t : tasks) EXPECT_EQ(t.get(), &request.json());
+  EXPECT_EQ(request.json().GetString("/topic").value_or(""), "a");
+}
+
 }  // namespace
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions
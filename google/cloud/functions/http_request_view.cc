@@ -0,0 +1,78 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_request_view.h"
+#include <string>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+class RequestViewImpl : public HttpRequestView::Impl {
+ public:
+  explicit RequestViewImpl(HttpRequest const& request) : request_(request) {}
+  ~RequestViewImpl() override = default;
+
+  [[nodiscard]] std::string_view verb() const override {
+    return request_.verb();
+  }
+  [[nodiscard]] std::string_view target() const override {
+    return request_.target();
+  }
+  [[nodiscard]] std::string_view payload() const override {
+    return request_.payload();
+  }
+  [[nodiscard]] int version_major() const override {
+    return request_.version_major();
+  }
+  [[nodiscard]] int version_minor() const override {
+    return request_.version_minor();
+  }
+  [[nodiscard]] std::optional<std::string_view> header(
+      std::string_view name) const override {
+    auto const f = request_.headers().find(name);
+    if (f == request_.headers().end()) return std::nullopt;
+    return f->second;
+  }
+  void ForEachHeader(
+      HttpRequestView::HeaderVisitor const& visitor) const override {
+    for (auto const& [k, v] : request_.headers()) visitor(k, v);
+  }
+
+ private:
+  HttpRequest const& request_;
+};
+
+}  // namespace
+
+HttpRequestView::Impl::~Impl() = default;
+
+HttpRequestView::HttpRequestView(HttpRequest const& request)
+    : owner_(std::make_shared<RequestViewImpl>(request)),
+      impl_(owner_.get()) {}
+
+HttpRequest HttpRequestView::ToHttpRequest() const {
+  auto request = HttpRequest{}
+                     .set_verb(std::string(verb()))
+                     .set_target(std::string(target()))
+                     .set_payload(std::string(payload()))
+                     .set_version(version_major(), version_minor());
+  ForEachHeader([&request](std::string_view name, std::string_view value) {
+    request.add_header(std::string(name), std::string(value));
+  });
+  return request;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
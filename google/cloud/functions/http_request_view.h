@@ -0,0 +1,105 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_REQUEST_VIEW_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_REQUEST_VIEW_H
+
+#include "google/cloud/functions/http_request.h"
+#include "google/cloud/functions/version.h"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A read-only view of an HTTP request.
+ *
+ * Functions created from a `UserHttpViewFunction` receive an object of this
+ * type. Unlike `HttpRequest`, the accessors return `std::string_view`s into
+ * the buffers where the framework parsed the request, so the framework does
+ * not copy the request line or header before calling the function.
+ *
+ * The view is only valid while the function runs. Use `ToHttpRequest()` to
+ * keep a copy of the request.
+ */
+class HttpRequestView {
+ public:
+  /// Receives the name and value of each header field, see `ForEachHeader()`.
+  using HeaderVisitor =
+      std::function<void(std::string_view name, std::string_view value)>;
+
+  /// Creates a view of @p request, which must outlive the view.
+  explicit HttpRequestView(HttpRequest const& request);
+
+  /// The HTTP verb (GET, PUT, POST, etc) in the request
+  [[nodiscard]] std::string_view verb() const { return impl_->verb(); }
+
+  /// The target object for the request, e.g, `/index.html`.
+  [[nodiscard]] std::string_view target() const { return impl_->target(); }
+
+  /// The request payload
+  [[nodiscard]] std::string_view payload() const { return impl_->payload(); }
+
+  /// The HTTP version for the request
+  [[nodiscard]] int version_major() const { return impl_->version_major(); }
+  [[nodiscard]] int version_minor() const { return impl_->version_minor(); }
+
+  /**
+   * The value of the header field @p name, compared case-insensitively.
+   *
+   * If the header contains multiple fields with this name, returns the value
+   * of the first one.
+   */
+  [[nodiscard]] std::optional<std::string_view> header(
+      std::string_view name) const {
+    return impl_->header(name);
+  }
+
+  /// Calls @p visitor for each header field, in the order they were received.
+  void ForEachHeader(HeaderVisitor const& visitor) const {
+    impl_->ForEachHeader(visitor);
+  }
+
+  /// Copies the request, including its payload.
+  [[nodiscard]] HttpRequest ToHttpRequest() const;
+
+  class Impl {
+   public:
+    virtual ~Impl() = 0;
+    [[nodiscard]] virtual std::string_view verb() const = 0;
+    [[nodiscard]] virtual std::string_view target() const = 0;
+    [[nodiscard]] virtual std::string_view payload() const = 0;
+    [[nodiscard]] virtual int version_major() const = 0;
+    [[nodiscard]] virtual int version_minor() const = 0;
+    [[nodiscard]] virtual std::optional<std::string_view> header(
+        std::string_view name) const = 0;
+    virtual void ForEachHeader(HeaderVisitor const& visitor) const = 0;
+  };
+
+  /// Creates a view over @p impl, which must outlive the view.
+  explicit HttpRequestView(Impl const& impl) : impl_(&impl) {}
+
+ private:
+  // Owns the implementation for views of an `HttpRequest`.
+  std::shared_ptr<Impl const> owner_;
+  Impl const* impl_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_REQUEST_VIEW_H
@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_request_view.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(HttpRequestViewTest, FromHttpRequest) {
+  auto const request = HttpRequest{}
+                           .set_version(1, 0)
+                           .set_verb("POST")
+                           .set_target("/index.html")
+                           .set_payload("Hello")
+                           .add_header("Content-Type", "text/plain")
+                           .add_header("x-repeated", "1")
+                           .add_header("x-repeated", "2");
+  HttpRequestView const actual(request);
+  EXPECT_EQ(actual.verb(), "POST");
+  EXPECT_EQ(actual.target(), "/index.html");
+  EXPECT_EQ(actual.payload(), "Hello");
+  EXPECT_EQ(actual.payload().data(), request.payload().data());
+  EXPECT_EQ(actual.version_major(), 1);
+  EXPECT_EQ(actual.version_minor(), 0);
+  EXPECT_EQ(actual.header("content-type"), "text/plain");
+  EXPECT_EQ(actual.header("X-REPEATED"), "1");
+  EXPECT_EQ(actual.header("x-missing"), std::nullopt);
+
+  std::vector<std::pair<std::string, std::string>> headers;
+  actual.ForEachHeader([&headers](std::string_view k, std::string_view v) {
+    headers.emplace_back(k, v);
+  });
+  EXPECT_THAT(headers, ElementsAre(std::make_pair("Content-Type", "text/plain"),
+                                   std::make_pair("x-repeated", "1"),
+                                   std::make_pair("x-repeated", "2")));
+}
+
+TEST(HttpRequestViewTest, ToHttpRequest) {
+  auto const request = HttpRequest{}
+                           .set_verb("PUT")
+                           .set_target("/a")
+                           .set_payload("data")
+                           .add_header("x-header", "v");
+  // The copy outlives the view.
+  auto const copy = HttpRequestView(request).ToHttpRequest();
+  EXPECT_EQ(copy.verb(), "PUT");
+  EXPECT_EQ(copy.target(), "/a");
+  EXPECT_EQ(copy.payload(), "data");
+  EXPECT_EQ(copy.headers(), request.headers());
+  EXPECT_EQ(copy.version_major(), request.version_major());
+  EXPECT_EQ(copy.version_minor(), request.version_minor());
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -15,8 +15,8 @@
 #ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_RESPONSE_H
 #define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_RESPONSE_H
 
+#include "google/cloud/functions/http_headers.h"
 #include "google/cloud/functions/version.h"
-#include <map>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -37,7 +37,7 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
  */
 class HttpResponse {
  public:
-  using HeadersType = std::map<std::string, std::string>;
+  using HeadersType = HttpHeaders;
 
   HttpResponse();
 
@@ -59,7 +59,7 @@ class HttpResponse {
   HttpResponse&& set_result(int code) && { return std::move(set_result(code)); }
   [[nodiscard]] int result() const { return impl_->result(); }
 
-  /// The request HTTP headers
+  /// The response HTTP headers, names are compared case-insensitively.
   HttpResponse& set_header(std::string_view name, std::string_view value) & {
     impl_->set_header(name, value);
     return *this;
@@ -67,7 +67,15 @@ class HttpResponse {
   HttpResponse&& set_header(std::string_view name, std::string_view value) && {
     return std::move(set_header(name, value));
   }
-  [[nodiscard]] HeadersType headers() const { return impl_->headers(); }
+  /**
+   * Returns the fields set with `set_header()`.
+   *
+   * The result does not include the fields that the framework adds when it
+   * sends the response, such as `Content-Length` or `Server`.
+   */
+  [[nodiscard]] HeadersType const& headers() const {
+    return impl_->headers();
+  }
 
   /// The HTTP version for the request
   HttpResponse& set_version(int major, int minor) & {
@@ -162,7 +170,7 @@ class HttpResponse {
     virtual void set_result(int code) = 0;
     [[nodiscard]] virtual int result() const = 0;
     virtual void set_header(std::string_view name, std::string_view value) = 0;
-    [[nodiscard]] virtual HeadersType headers() const = 0;
+    [[nodiscard]] virtual HeadersType const& headers() const = 0;
     virtual void set_version(int major, int minor) = 0;
     [[nodiscard]] virtual int version_major() const = 0;
     [[nodiscard]] virtual int version_minor() const = 0;
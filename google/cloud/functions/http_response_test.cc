@@ -55,6 +55,31 @@ TEST(WrapResponseTest, Headers) {
                           std::make_pair("x-goog-test", "b")));
 }
 
+TEST(WrapResponseTest, HeadersIgnoreCase) {
+  auto response = functions::HttpResponse{}
+                      .set_header("Content-Type", "text/plain")
+                      .set_header("content-type", "application/json");
+  auto const& headers = response.headers();
+  EXPECT_THAT(headers,
+              ElementsAre(std::make_pair("content-type", "application/json")));
+  auto const f = headers.find("CONTENT-TYPE");
+  ASSERT_NE(f, headers.end());
+  EXPECT_EQ(f->second, "application/json");
+}
+
+TEST(WrapResponseTest, HeadersOnlySetHeader) {
+  // Only `set_header()` adds fields, the framework adds `Content-Length` and
+  // the other fields when it sends the response.
+  auto response = functions::HttpResponse{}
+                      .set_payload("Hello")
+                      .set_result(functions::HttpResponse::kNotFound)
+                      .set_version(1, 0);
+  EXPECT_THAT(response.headers(), IsEmpty());
+  response.set_header("x-goog-test", "a");
+  EXPECT_THAT(response.headers(),
+              ElementsAre(std::make_pair("x-goog-test", "a")));
+}
+
 TEST(WrapResponseTest, Version) {
   auto r = functions::HttpResponse{};
   EXPECT_EQ(r.version_major(), 1);
@@ -0,0 +1,48 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_response_writer.h"
+#include <string>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+void HttpResponseWriter::WriteEvent(std::string_view data,
+                                    std::string_view event,
+                                    std::string_view id) {
+  std::string buffer;
+  auto field = [&buffer](std::string_view name, std::string_view value) {
+    buffer.append(name.data(), name.size());
+    buffer += ": ";
+    buffer.append(value.data(), value.size());
+    buffer += '\n';
+  };
+  if (!event.empty()) field("event", event);
+  if (!id.empty()) field("id", id);
+  // Each line in the data is a separate field, the client joins them.
+  for (;;) {
+    auto const eol = data.find('\n');
+    field("data", data.substr(0, eol));
+    if (eol == std::string_view::npos) break;
+    data.remove_prefix(eol + 1);
+  }
+  // A blank line terminates the event.
+  buffer += '\n';
+  Write(buffer);
+}
+
+HttpResponseWriter::Impl::~Impl() = default;
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,122 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_RESPONSE_WRITER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_RESPONSE_WRITER_H
+
+#include "google/cloud/functions/version.h"
+#include <memory>
+#include <string_view>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Writes an HTTP response incrementally.
+ *
+ * Functions created from a `UserHttpWriterFunction` receive an object of this
+ * type. The status and headers are sent with the first write, or with
+ * `SendHeaders()`, each write is then sent to the client immediately, using
+ * `Transfer-Encoding: chunked`. The response completes when the function
+ * returns.
+ *
+ * If the function throws after the headers are sent, the connection is closed
+ * before the end of the response, so the client can detect the error. If the
+ * function never writes to the response, the status and headers are sent as a
+ * response with an empty body.
+ *
+ * The writer is only valid while the function runs.
+ *
+ * @par Example
+ * @code
+ * namespace gcf = ::google::cloud::functions;
+ * void Tokens(gcf::HttpRequest const&, gcf::HttpResponseWriter writer) {
+ *   writer.set_header("Content-Type", "text/event-stream");
+ *   for (auto const& t : GenerateTokens()) writer.WriteEvent(t);
+ * }
+ * @endcode
+ */
+class HttpResponseWriter {
+ public:
+  /**
+   * Sets the response status.
+   *
+   * @throws std::logic_error if the headers were already sent.
+   */
+  HttpResponseWriter& set_result(int code) {
+    impl_->set_result(code);
+    return *this;
+  }
+
+  /**
+   * Sets a response header.
+   *
+   * @throws std::logic_error if the headers were already sent.
+   */
+  HttpResponseWriter& set_header(std::string_view name,
+                                 std::string_view value) {
+    impl_->set_header(name, value);
+    return *this;
+  }
+
+  /**
+   * Sends the status and headers, if they were not sent already.
+   *
+   * @throws std::runtime_error if the headers cannot be sent, e.g., because
+   *     the client closed the connection.
+   */
+  void SendHeaders() { impl_->SendHeaders(); }
+
+  /**
+   * Sends @p data to the client, as a single chunk.
+   *
+   * Empty writes are ignored.
+   *
+   * @throws std::runtime_error if the data cannot be sent, e.g., because the
+   *     client closed the connection, or the write timed out.
+   */
+  void Write(std::string_view data) { impl_->Write(data); }
+
+  /**
+   * Sends a [Server-Sent Event][sse-spec].
+   *
+   * Each line in @p data is sent as a `data:` field. The @p event and @p id
+   * fields are omitted if empty. The function should set the `Content-Type`
+   * header to `text/event-stream` before the first event.
+   *
+   * [sse-spec]: https://html.spec.whatwg.org/multipage/server-sent-events.html
+   */
+  void WriteEvent(std::string_view data, std::string_view event = {},
+                  std::string_view id = {});
+
+  class Impl {
+   public:
+    virtual ~Impl() = 0;
+    virtual void set_result(int code) = 0;
+    virtual void set_header(std::string_view name, std::string_view value) = 0;
+    virtual void SendHeaders() = 0;
+    virtual void Write(std::string_view data) = 0;
+  };
+
+  explicit HttpResponseWriter(std::unique_ptr<Impl> impl)
+      : impl_(std::move(impl)) {}
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_HTTP_RESPONSE_WRITER_H
@@ -0,0 +1,60 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/http_response_writer.h"
+#include "google/cloud/functions/internal/wrap_response.h"
+#include <gmock/gmock.h>
+#include <stdexcept>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+TEST(HttpResponseWriterTest, Write) {
+  BeastResponse response;
+  auto writer = MakeBufferedResponseWriter(response);
+  writer.set_result(functions::HttpResponse::kCreated)
+      .set_header("Content-Type", "text/plain");
+  writer.Write("Hello ");
+  writer.Write("");
+  writer.Write("World");
+  EXPECT_EQ(response.result_int(), functions::HttpResponse::kCreated);
+  EXPECT_EQ(response["Content-Type"], "text/plain");
+  EXPECT_EQ(response.body(), "Hello World");
+}
+
+TEST(HttpResponseWriterTest, HeadersAfterWrite) {
+  BeastResponse response;
+  auto writer = MakeBufferedResponseWriter(response);
+  writer.SendHeaders();
+  EXPECT_THROW(writer.set_result(functions::HttpResponse::kNotFound),
+               std::logic_error);
+  EXPECT_THROW(writer.set_header("x-test", "value"), std::logic_error);
+}
+
+TEST(HttpResponseWriterTest, WriteEvent) {
+  BeastResponse response;
+  auto writer = MakeBufferedResponseWriter(response);
+  writer.WriteEvent("token");
+  writer.WriteEvent("line 1\nline 2", "update", "42");
+  writer.WriteEvent("");
+  EXPECT_EQ(response.body(),
+            "data: token\n\n"
+            "event: update\nid: 42\ndata: line 1\ndata: line 2\n\n"
+            "data: \n\n");
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,64 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/adaptive_limit.h"
+#include <algorithm>
+#include <cmath>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+// The baseline averages about this many windows.
+auto constexpr kLongWindows = 600.0;
+auto constexpr kSmoothing = 0.2;
+}  // namespace
+
+AdaptiveLimit::AdaptiveLimit(std::size_t initial_limit, std::size_t min_limit,
+                             std::size_t max_limit)
+    : min_limit_(static_cast<double>(std::max<std::size_t>(1, min_limit))),
+      max_limit_(static_cast<double>(std::max(min_limit, max_limit))),
+      limit_(std::clamp(static_cast<double>(initial_limit), min_limit_,
+                        max_limit_)) {}
+
+void AdaptiveLimit::OnSample(std::chrono::nanoseconds latency,
+                             std::size_t in_flight) {
+  window_sum_ += static_cast<double>(latency.count());
+  window_in_flight_ = std::max(window_in_flight_, in_flight);
+  if (++window_count_ < kWindowSamples) return;
+  auto const short_latency = std::max(1.0, window_sum_ / window_count_);
+  auto const app_limited =
+      static_cast<double>(window_in_flight_) < limit_ / 2;
+  window_sum_ = 0;
+  window_count_ = 0;
+  window_in_flight_ = 0;
+
+  if (long_latency_ == 0) {
+    long_latency_ = short_latency;
+  } else {
+    long_latency_ += (short_latency - long_latency_) * 2 / (kLongWindows + 1);
+  }
+  // After a sustained latency increase the baseline drifts up, let it recover
+  // faster once the latency drops back.
+  if (long_latency_ / short_latency > 2) long_latency_ *= 0.95;
+  if (app_limited) return;
+
+  auto const gradient =
+      std::clamp(kTolerance * long_latency_ / short_latency, 0.5, 1.0);
+  auto const target = limit_ * gradient + std::sqrt(limit_);
+  limit_ = std::clamp(limit_ * (1 - kSmoothing) + target * kSmoothing,
+                      min_limit_, max_limit_);
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
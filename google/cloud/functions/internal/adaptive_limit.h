@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_ADAPTIVE_LIMIT_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_ADAPTIVE_LIMIT_H
+
+#include "google/cloud/functions/version.h"
+#include <chrono>
+#include <cstddef>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Estimates the concurrency limit from the observed function latency.
+ *
+ * This is a gradient algorithm, similar to the "Gradient2" limit in Netflix's
+ * concurrency-limits library. The samples are averaged over short windows,
+ * and a long-term exponential average of those windows is the baseline
+ * latency. While the window latency stays within `kTolerance` of the
+ * baseline the limit grows by `sqrt(limit)` per window. Once the latency
+ * exceeds that, the limit shrinks in proportion to the excess. The changes
+ * are smoothed, so a single slow window does not halve the limit.
+ *
+ * Windows where fewer than half of the slots are in use do not change the
+ * limit, as the latency does not say anything about a higher concurrency.
+ *
+ * This class is not thread-safe, `RequestLimiter` serializes the calls.
+ */
+class AdaptiveLimit {
+ public:
+  AdaptiveLimit(std::size_t initial_limit, std::size_t min_limit,
+                std::size_t max_limit);
+
+  /**
+   * Records a completed request.
+   *
+   * @param latency how long the function ran.
+   * @param in_flight the number of requests running, including this one.
+   */
+  void OnSample(std::chrono::nanoseconds latency, std::size_t in_flight);
+
+  /// The current limit, always in the `[min_limit, max_limit]` range.
+  std::size_t limit() const { return static_cast<std::size_t>(limit_); }
+
+  static auto constexpr kWindowSamples = 10;
+  static auto constexpr kTolerance = 1.5;
+
+ private:
+  double const min_limit_;
+  double const max_limit_;
+  double limit_;
+  // The baseline latency, in nanoseconds, 0 until the first window completes.
+  double long_latency_ = 0;
+  double window_sum_ = 0;
+  int window_count_ = 0;
+  std::size_t window_in_flight_ = 0;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_ADAPTIVE_LIMIT_H
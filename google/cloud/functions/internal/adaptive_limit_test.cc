@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/adaptive_limit.h"
+#include <gmock/gmock.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using std::chrono::milliseconds;
+
+/// Feeds @p windows full windows of samples, with all the slots in use.
+void Feed(AdaptiveLimit& limit, milliseconds latency, int windows) {
+  for (int i = 0; i != windows * AdaptiveLimit::kWindowSamples; ++i) {
+    limit.OnSample(latency, limit.limit());
+  }
+}
+
+TEST(AdaptiveLimitTest, Initial) {
+  EXPECT_EQ(AdaptiveLimit(20, 1, 100).limit(), 20);
+  EXPECT_EQ(AdaptiveLimit(200, 1, 100).limit(), 100);
+  EXPECT_EQ(AdaptiveLimit(0, 0, 100).limit(), 1);
+}
+
+TEST(AdaptiveLimitTest, GrowsWithStableLatency) {
+  AdaptiveLimit limit(10, 1, 1000);
+  Feed(limit, milliseconds(10), 20);
+  EXPECT_GT(limit.limit(), 20);
+  Feed(limit, milliseconds(10), 1000);
+  EXPECT_EQ(limit.limit(), 1000);
+}
+
+TEST(AdaptiveLimitTest, ShrinksWithHigherLatency) {
+  AdaptiveLimit limit(100, 1, 1000);
+  Feed(limit, milliseconds(10), 1);
+  auto const before = limit.limit();
+  // The latency grows well past the tolerance, as if the function was CPU
+  // bound and the server oversubscribed.
+  Feed(limit, milliseconds(100), 10);
+  EXPECT_LT(limit.limit(), before / 2);
+  Feed(limit, milliseconds(100), 200);
+  EXPECT_GE(limit.limit(), 1);
+}
+
+TEST(AdaptiveLimitTest, IgnoresPartialWindows) {
+  AdaptiveLimit limit(100, 1, 1000);
+  Feed(limit, milliseconds(10), 1);
+  auto const before = limit.limit();
+  for (int i = 0; i + 1 < AdaptiveLimit::kWindowSamples; ++i) {
+    limit.OnSample(milliseconds(1000), limit.limit());
+  }
+  EXPECT_EQ(limit.limit(), before);
+}
+
+TEST(AdaptiveLimitTest, ApplicationLimited) {
+  AdaptiveLimit limit(100, 1, 1000);
+  // With only a few requests in flight the limit does not change, in either
+  // direction.
+  for (int i = 0; i != 100 * AdaptiveLimit::kWindowSamples; ++i) {
+    limit.OnSample(milliseconds(10 + i), 4);
+  }
+  EXPECT_EQ(limit.limit(), 100);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,256 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/async_server.h"
+#include "google/cloud/functions/internal/drain_controller.h"
+#include "google/cloud/functions/internal/handler_pool.h"
+#include "google/cloud/functions/internal/http_session.h"
+#include "google/cloud/functions/internal/output_flusher.h"
+#include "google/cloud/functions/internal/request_limiter.h"
+#include "google/cloud/functions/internal/server_stats.h"
+#include "google/cloud/functions/internal/session_registry.h"
+#include "google/cloud/functions/internal/static_headers.h"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/beast/core.hpp>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+namespace be = boost::beast;
+namespace asio = boost::asio;
+
+void ReportError(be::error_code ec, char const* what) {
+  // TODO(#35) - maybe replace with Boost.Log
+  std::cerr << what << ": " << ec.message() << "\n";
+}
+
+/**
+ * An I/O event loop with its own listening socket, threads and handler pool.
+ *
+ * When the server runs multiple reactors, each reactor listens on the same
+ * port using `SO_REUSEPORT`, and the kernel balances the new connections across
+ * them. The reactors do not share any state on the request path.
+ */
+struct Reactor {
+  Reactor(int threads, ServerConfig const& config, std::size_t max_sessions,
+          std::size_t max_requests, std::size_t max_queued_requests)
+      : registry(max_sessions, config.max_queued_sessions,
+                 config.reject_when_full, stats),
+        limiter(max_requests, max_queued_requests, stats,
+                config.adaptive_concurrency, config.request_queue_timeout),
+        ioc(threads),
+        threads(threads) {}
+
+  // The sessions notify the registry when they are destroyed, which may happen
+  // as the event loop is destroyed. The registry must outlive the event loop.
+  // So must the limiter, as the sessions hold permits, but its queue must be
+  // cleared while the event loop exists, see `AsyncServer::Run()`.
+  ServerStats stats;
+  SessionRegistry registry;
+  RequestLimiter limiter;
+  asio::io_context ioc;
+  Acceptor acceptor{asio::make_strand(ioc)};
+  int threads;
+  std::unique_ptr<HandlerPool> pool;
+  SessionContext context;
+};
+
+class AsyncServer {
+ public:
+  AsyncServer(ServerConfig const& config, ListenEndpoint endpoint,
+              Handler handler, StreamingHandler streaming_handler,
+              WriterHandler writer_handler, PreBodyHook pre_body_hook,
+              std::function<bool()> const& shutdown)
+      : shutdown_(shutdown),
+        handle_signals_(config.handle_signals),
+        static_headers_(config.static_headers, config.date_header),
+        output_(config.output_mode),
+        drain_(config.drain_timeout) {
+    // With a single reactor all the I/O threads share a listening socket,
+    // otherwise each reactor gets one thread and its own listening socket.
+    auto const per_core = config.reactors > 1;
+    auto const count = per_core ? config.reactors : 1;
+    auto const threads = per_core ? 1 : config.io_threads;
+    auto const split = [count](std::size_t limit) {
+      return (limit + count - 1) / count;
+    };
+    for (int i = 0; i != count; ++i) {
+      auto r = std::make_unique<Reactor>(
+          threads, config, split(config.max_sessions),
+          split(config.max_concurrent_requests),
+          split(config.max_queued_requests));
+      if (config.handler_threads != 0) {
+        r->pool = std::make_unique<HandlerPool>(config.handler_threads,
+                                                config.handler_queue_size);
+      }
+      r->context = SessionContext{handler,
+                                  streaming_handler,
+                                  writer_handler,
+                                  pre_body_hook,
+                                  config,
+                                  r->pool.get(),
+                                  &r->stats,
+                                  &r->registry,
+                                  &static_headers_,
+                                  &output_,
+                                  &drain_,
+                                  &r->limiter};
+      Listen(r->acceptor, endpoint, config, per_core);
+      // All the listeners must share the port, even if the application asked
+      // for an ephemeral port.
+      endpoint = r->acceptor.local_endpoint();
+      reactors_.push_back(std::move(r));
+    }
+    socket_remover_.emplace(endpoint);
+    if (config.stats_log_interval.count() != 0) {
+      std::vector<std::pair<std::string, ServerStats const*>> stats;
+      for (auto const& r : reactors_) {
+        stats.emplace_back("reactor-" + std::to_string(stats.size()),
+                           &r->stats);
+      }
+      stats_logger_ = std::make_unique<StatsLogger>(config.stats_log_interval,
+                                                    std::move(stats));
+    }
+  }
+
+  int port() const {
+    return ListenPort(reactors_.front()->acceptor.local_endpoint());
+  }
+
+  int Run() {
+    if (handle_signals_) {
+      signals_ = std::make_unique<asio::signal_set>(reactors_.front()->ioc,
+                                                    SIGINT, SIGTERM);
+      signals_->async_wait([this](be::error_code ec, int /*signal*/) {
+        if (!ec) StartDrain();
+      });
+    }
+    std::vector<std::thread> threads;
+    for (auto& r : reactors_) {
+      DoAccept(*r);
+      for (int i = 0; i != r->threads; ++i) {
+        threads.emplace_back([&ioc = r->ioc] { ioc.run(); });
+      }
+    }
+    for (auto& t : threads) t.join();
+    if (drainer_.joinable()) drainer_.join();
+    for (auto& r : reactors_) {
+      r->registry.Shutdown();
+      r->limiter.Shutdown();
+      if (r->pool) r->pool->Shutdown();
+    }
+    return status_;
+  }
+
+ private:
+  void DoAccept(Reactor& r) {
+    if (!r.acceptor.is_open()) return;
+    r.acceptor.async_accept(
+        asio::make_strand(r.ioc),
+        [this, &r](be::error_code ec, SessionSocket socket) {
+          OnAccept(r, ec, std::move(socket));
+        });
+  }
+
+  void OnAccept(Reactor& r, be::error_code ec, SessionSocket socket) {
+    if (shutdown_()) return Stop();
+    if (ec == asio::error::operation_aborted && !r.acceptor.is_open()) return;
+    if (ec) {
+      ReportError(ec, "accept");
+    } else {
+      r.stats.connections_accepted.fetch_add(1, std::memory_order_relaxed);
+      ConfigureSocket(socket, r.context.config);
+      auto s = std::make_shared<SessionSocket>(std::move(socket));
+      auto const admission = r.registry.Admit([s, &r] {
+        std::make_shared<HttpSession>(std::move(*s), r.context)->Start();
+      });
+      if (admission == SessionRegistry::Admission::kRejected) {
+        RejectSession(std::move(*s));
+      }
+    }
+    // Stop accepting connections until a session completes, the new
+    // connections wait in the listen backlog.
+    auto const paused = r.registry.PauseAccept([this, &r] {
+      asio::post(r.acceptor.get_executor(), [this, &r] { DoAccept(r); });
+    });
+    if (paused) return;
+    DoAccept(r);
+  }
+
+  // Stop accepting connections, and stop the server once the requests in
+  // flight complete. The sessions close their connections after the current
+  // response. If the deadline expires first the server stops anyway, and
+  // `Run()` waits for the functions still running in the handler pools.
+  void StartDrain() {
+    if (!drain_.Start()) return;
+    for (auto& r : reactors_) {
+      asio::post(r->acceptor.get_executor(), [&r = *r] {
+        be::error_code ec;
+        r.acceptor.close(ec);
+      });
+    }
+    drainer_ = std::thread([this] {
+      if (!drain_.WaitForIdle()) status_ = ReportDrainTimeout(drain_);
+      // Reject the requests still queued, while their sessions can respond.
+      for (auto& r : reactors_) r->limiter.Shutdown();
+      output_.Flush();
+      Stop();
+    });
+  }
+
+  void Stop() {
+    for (auto& r : reactors_) r->ioc.stop();
+  }
+
+  std::function<bool()> const& shutdown_;
+  bool const handle_signals_;
+  StaticHeaders static_headers_;
+  OutputFlusher output_;
+  DrainController drain_;
+  // Declared before the reactors, the socket is removed once they are closed.
+  std::optional<UnixSocketRemover> socket_remover_;
+  std::vector<std::unique_ptr<Reactor>> reactors_;
+  std::unique_ptr<StatsLogger> stats_logger_;
+  std::unique_ptr<asio::signal_set> signals_;
+  std::thread drainer_;
+  // Set by `drainer_`, and read only once it is joined.
+  int status_ = 0;
+};
+
+}  // namespace
+
+int RunAsyncServer(ServerConfig const& config, ListenEndpoint const& endpoint,
+                   Handler handler, StreamingHandler streaming_handler,
+                   WriterHandler writer_handler, PreBodyHook pre_body_hook,
+                   std::function<bool()> const& shutdown,
+                   std::function<void(int)> const& actual_port) {
+  AsyncServer server(config, endpoint, std::move(handler),
+                     std::move(streaming_handler), std::move(writer_handler),
+                     std::move(pre_body_hook), shutdown);
+  actual_port(server.port());
+  return server.Run();
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,58 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_ASYNC_SERVER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_ASYNC_SERVER_H
+
+#include "google/cloud/functions/internal/function_impl.h"
+#include "google/cloud/functions/internal/listener.h"
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/version.h"
+#include <functional>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Serve @p handler using the asynchronous session engine.
+ *
+ * All the connections are multiplexed over `config.io_threads` threads, each
+ * connection runs in its own strand. Idle connections do not consume a thread.
+ * The handler runs in the I/O thread that read the request, unless
+ * `config.handler_threads` is set, in which case it runs in a separate thread
+ * pool and the I/O threads are free to read and write other connections.
+ *
+ * As with the thread-per-connection engine, @p shutdown is checked each time a
+ * new connection is accepted. Once it returns `true` the server stops. Unless
+ * `config.handle_signals` is false, on `SIGINT` or `SIGTERM` the server
+ * drains: it stops accepting connections and returns once the requests in
+ * flight complete, see `DrainController`. It returns a non-zero status if the
+ * drain deadline expires first.
+ *
+ * If @p streaming_handler or @p writer_handler is not null it serves all the
+ * requests, and the function reads the request body, or writes the response,
+ * incrementally. If @p pre_body_hook is not null it inspects each request
+ * before its body is read.
+ */
+int RunAsyncServer(ServerConfig const& config,
+                   ListenEndpoint const& endpoint,
+                   Handler handler, StreamingHandler streaming_handler,
+                   WriterHandler writer_handler, PreBodyHook pre_body_hook,
+                   std::function<bool()> const& shutdown,
+                   std::function<void(int)> const& actual_port);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_ASYNC_SERVER_H
@@ -29,6 +29,9 @@ struct UnwrapResponse {
   static BeastResponse unwrap(functions::HttpResponse response) {
     auto impl = std::move(response).impl_;
     auto& wrap = dynamic_cast<WrapResponseImpl&>(*impl);
+    for (auto const& [name, value] : wrap.headers_) {
+      wrap.response_.insert(name, value);
+    }
     return std::move(wrap).response_;
   }
 };
@@ -78,6 +81,55 @@ BeastResponse CallUserFunction(functions::UserHttpFunction const& function,
   return ReportUnknownExceptionInFunction();
 }
 
+BeastResponse CallUserFunction(functions::UserHttpViewFunction const& function,
+                               BeastRequest const& request) try {
+  if (request.target() == "/favicon.ico" || request.target() == "/robots.txt") {
+    BeastResponse response;
+    response.result(be::http::status::not_found);
+    return response;
+  }
+  WrapRequestView const view(request);
+  auto response = function(functions::HttpRequestView(view));
+  return UnwrapResponse::unwrap(std::move(response));
+} catch (std::exception const& ex) {
+  return ReportExceptionInFunction(ex);
+} catch (...) {
+  return ReportUnknownExceptionInFunction();
+}
+
+BeastResponse CallUserFunction(
+    functions::UserHttpStreamingFunction const& function, BeastRequest request,
+    functions::HttpBodyReader reader) try {
+  if (request.target() == "/favicon.ico" || request.target() == "/robots.txt") {
+    BeastResponse response;
+    response.result(be::http::status::not_found);
+    return response;
+  }
+  auto response =
+      function(MakeHttpRequest(std::move(request)), std::move(reader));
+  return UnwrapResponse::unwrap(std::move(response));
+} catch (std::exception const& ex) {
+  return ReportExceptionInFunction(ex);
+} catch (...) {
+  return ReportUnknownExceptionInFunction();
+}
+
+std::optional<BeastResponse> CallUserFunction(
+    functions::UserHttpWriterFunction const& function, BeastRequest request,
+    functions::HttpResponseWriter writer) try {
+  if (request.target() == "/favicon.ico" || request.target() == "/robots.txt") {
+    BeastResponse response;
+    response.result(be::http::status::not_found);
+    return response;
+  }
+  function(MakeHttpRequest(std::move(request)), std::move(writer));
+  return std::nullopt;
+} catch (std::exception const& ex) {
+  return ReportExceptionInFunction(ex);
+} catch (...) {
+  return ReportUnknownExceptionInFunction();
+}
+
 BeastResponse CallUserFunction(
     functions::UserCloudEventFunction const& function,
     BeastRequest const& request) try {
@@ -97,5 +149,16 @@ BeastResponse CallUserFunction(
   return ReportUnknownExceptionInFunction();
 }
 
+std::optional<BeastResponse> CallPreBodyHook(
+    functions::UserPreBodyHook const& hook, BeastRequest const& request) try {
+  auto response = hook(MakeHttpRequest(request));
+  if (!response) return std::nullopt;
+  return UnwrapResponse::unwrap(*std::move(response));
+} catch (std::exception const& ex) {
+  return ReportExceptionInFunction(ex);
+} catch (...) {
+  return ReportUnknownExceptionInFunction();
+}
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
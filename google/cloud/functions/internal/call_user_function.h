@@ -17,6 +17,7 @@
 
 #include "google/cloud/functions/internal/http_message_types.h"
 #include "google/cloud/functions/user_functions.h"
+#include <optional>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -24,10 +25,37 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
 BeastResponse CallUserFunction(functions::UserHttpFunction const& function,
                                BeastRequest request);
 
+/// Calls @p function with a view of @p request, without copying it.
+BeastResponse CallUserFunction(functions::UserHttpViewFunction const& function,
+                               BeastRequest const& request);
+
+/// Calls @p function with the request header in @p request.
+BeastResponse CallUserFunction(
+    functions::UserHttpStreamingFunction const& function, BeastRequest request,
+    functions::HttpBodyReader reader);
+
+/**
+ * Calls @p function, which writes its response to @p writer.
+ *
+ * Returns a response if the function did not run, or if it threw an exception.
+ */
+std::optional<BeastResponse> CallUserFunction(
+    functions::UserHttpWriterFunction const& function, BeastRequest request,
+    functions::HttpResponseWriter writer);
+
 BeastResponse CallUserFunction(
     functions::UserCloudEventFunction const& function,
     BeastRequest const& request);
 
+/**
+ * Calls @p hook with the request header in @p request.
+ *
+ * Returns the response rejecting the request, if any. Exceptions thrown by the
+ * hook reject the request too.
+ */
+std::optional<BeastResponse> CallPreBodyHook(
+    functions::UserPreBodyHook const& hook, BeastRequest const& request);
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
 
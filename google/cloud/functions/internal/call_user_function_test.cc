@@ -55,6 +55,30 @@ TEST(CallUserFunctionHttpTest, ReturnError) {
   EXPECT_EQ(response.result_int(), functions::HttpResponse::kNotFound);
 }
 
+TEST(CallUserFunctionHttpTest, View) {
+  auto func = [](functions::HttpRequestView request) {
+    EXPECT_EQ(request.payload(), "Hello, is there anybody out there?");
+    EXPECT_EQ(request.verb(), "PUT");
+    EXPECT_EQ(request.target(), "/foo/bar");
+    EXPECT_EQ(request.header("X-Goog-Test"), "test-value");
+    return functions::HttpResponse{}.set_payload("just nod if you can hear me");
+  };
+  BeastRequest request;
+  request.target("/foo/bar");
+  request.method(boost::beast::http::verb::put);
+  request.body() = "Hello, is there anybody out there?";
+  request.set("x-goog-test", "test-value");
+  auto response =
+      CallUserFunction(functions::UserHttpViewFunction(func), request);
+  EXPECT_EQ(response.result_int(), functions::HttpResponse::kOkay);
+  EXPECT_EQ(response.body(), "just nod if you can hear me");
+
+  auto throws = [](functions::HttpRequestView const& /*request*/)
+      -> functions::HttpResponse { throw std::runtime_error("uh-oh"); };
+  response = CallUserFunction(functions::UserHttpViewFunction(throws), request);
+  EXPECT_EQ(response.result(), http::status::internal_server_error);
+}
+
 functions::HttpResponse HttpAlwaysThrow(
     functions::HttpRequest const& /*request*/) {
   throw std::runtime_error("uh-oh");
@@ -0,0 +1,73 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/drain_controller.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+void DrainController::InFlight::Reset() {
+  if (controller_ == nullptr) return;
+  controller_->Finish();
+  controller_ = nullptr;
+}
+
+DrainController::DrainController(std::chrono::seconds timeout)
+    : timeout_(timeout) {}
+
+bool DrainController::Start() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (draining_.load(std::memory_order_relaxed)) return false;
+  deadline_ = std::chrono::steady_clock::now() + timeout_;
+  draining_.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+DrainController::InFlight DrainController::Track() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (closed_) return {};
+  ++in_flight_;
+  return InFlight(this);
+}
+
+std::size_t DrainController::in_flight() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return in_flight_;
+}
+
+bool DrainController::WaitForIdle() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!cv_.wait_until(lk, deadline_, [this] { return in_flight_ == 0; })) {
+    return false;
+  }
+  closed_ = true;
+  return true;
+}
+
+void DrainController::Finish() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (--in_flight_ == 0) cv_.notify_all();
+}
+
+int ReportDrainTimeout(DrainController const& drain) {
+  // TODO(#35) - maybe replace with Boost.Log
+  std::cerr << "drain timeout expired with " << drain.in_flight()
+            << " request(s) in flight" << std::endl;
+  return EXIT_FAILURE;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
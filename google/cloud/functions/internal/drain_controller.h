@@ -0,0 +1,118 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_DRAIN_CONTROLLER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_DRAIN_CONTROLLER_H
+
+#include "google/cloud/functions/version.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Coordinates the graceful shutdown (drain) of the server.
+ *
+ * Sessions hold an `InFlight` token for each request, from the first byte of
+ * the request until its response is sent. Once the server receives a
+ * termination signal it calls `Start()`, stops accepting connections, and
+ * calls `WaitForIdle()`. Meanwhile, the sessions close each connection after
+ * its current response.
+ *
+ * Once `WaitForIdle()` succeeds no new requests can start, `Track()` returns
+ * an empty token, and the session must close the connection instead of
+ * serving the request.
+ */
+class DrainController {
+ public:
+  /// Tracks a request in flight, see `Track()`.
+  class InFlight {
+   public:
+    InFlight() = default;
+    ~InFlight() { Reset(); }
+
+    InFlight(InFlight&& rhs) noexcept : controller_(rhs.controller_) {
+      rhs.controller_ = nullptr;
+    }
+    InFlight& operator=(InFlight&& rhs) noexcept {
+      if (this == &rhs) return *this;
+      Reset();
+      controller_ = rhs.controller_;
+      rhs.controller_ = nullptr;
+      return *this;
+    }
+
+    InFlight(InFlight const&) = delete;
+    InFlight& operator=(InFlight const&) = delete;
+
+    explicit operator bool() const { return controller_ != nullptr; }
+
+   private:
+    friend class DrainController;
+    explicit InFlight(DrainController* c) : controller_(c) {}
+    void Reset();
+
+    DrainController* controller_ = nullptr;
+  };
+
+  /// @p timeout bounds the time between `Start()` and the end of the drain.
+  explicit DrainController(std::chrono::seconds timeout);
+
+  /// Starts the drain, returns `false` if it was already started.
+  bool Start();
+
+  /// Returns `true` once the drain has started.
+  bool draining() const { return draining_.load(std::memory_order_relaxed); }
+
+  /// Starts tracking a request, the token is empty if the drain completed.
+  InFlight Track();
+
+  /// The number of requests in flight.
+  std::size_t in_flight() const;
+
+  /**
+   * Blocks until no requests are in flight, or the drain deadline expires.
+   *
+   * @return `true` if all the requests completed before the deadline.
+   */
+  bool WaitForIdle();
+
+ private:
+  void Finish();
+
+  std::chrono::seconds const timeout_;
+  std::atomic<bool> draining_{false};
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::chrono::steady_clock::time_point deadline_;
+  std::size_t in_flight_ = 0;
+  bool closed_ = false;
+};
+
+/**
+ * Logs the number of requests still in flight after the drain deadline expires.
+ *
+ * @return the status returned by the server, which must not report success
+ *     once it gave up on some requests.
+ */
+int ReportDrainTimeout(DrainController const& drain);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_DRAIN_CONTROLLER_H
@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/drain_controller.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <thread>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+TEST(DrainControllerTest, Start) {
+  DrainController drain(std::chrono::seconds(0));
+  EXPECT_FALSE(drain.draining());
+  EXPECT_TRUE(drain.Start());
+  EXPECT_TRUE(drain.draining());
+  EXPECT_FALSE(drain.Start());
+}
+
+TEST(DrainControllerTest, TracksRequests) {
+  DrainController drain(std::chrono::seconds(0));
+  auto a = drain.Track();
+  EXPECT_TRUE(a);
+  {
+    auto b = drain.Track();
+    EXPECT_EQ(drain.in_flight(), 2);
+    auto c = std::move(b);
+    EXPECT_EQ(drain.in_flight(), 2);
+  }
+  EXPECT_EQ(drain.in_flight(), 1);
+  a = {};
+  EXPECT_EQ(drain.in_flight(), 0);
+}
+
+TEST(DrainControllerTest, WaitsForRequests) {
+  DrainController drain(std::chrono::seconds(30));
+  auto token = drain.Track();
+  ASSERT_TRUE(drain.Start());
+  auto idle =
+      std::async(std::launch::async, [&] { return drain.WaitForIdle(); });
+  EXPECT_EQ(idle.wait_for(std::chrono::milliseconds(50)),
+            std::future_status::timeout);
+  // New requests may start while the drain waits.
+  auto late = drain.Track();
+  EXPECT_TRUE(late);
+  token = {};
+  late = {};
+  EXPECT_TRUE(idle.get());
+  // Once the drain completes no new requests can start.
+  EXPECT_FALSE(drain.Track());
+  EXPECT_EQ(drain.in_flight(), 0);
+}
+
+TEST(DrainControllerTest, Deadline) {
+  DrainController drain(std::chrono::seconds(1));
+  auto token = drain.Track();
+  ASSERT_TRUE(drain.Start());
+  auto const start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(drain.WaitForIdle());
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(900));
+  EXPECT_EQ(drain.in_flight(), 1);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -13,57 +13,104 @@
 // limitations under the License.
 
 #include "google/cloud/functions/internal/framework_impl.h"
+#include "google/cloud/functions/internal/async_server.h"
+#include "google/cloud/functions/internal/drain_controller.h"
 #include "google/cloud/functions/internal/function_impl.h"
+#include "google/cloud/functions/internal/handler_pool.h"
+#include "google/cloud/functions/internal/http_session.h"
+#include "google/cloud/functions/internal/listener.h"
+#include "google/cloud/functions/internal/output_flusher.h"
 #include "google/cloud/functions/internal/parse_options.h"
+#include "google/cloud/functions/internal/request_limiter.h"
+#ifdef FUNCTIONS_FRAMEWORK_CPP_HAVE_COMPRESSION
+#include "google/cloud/functions/internal/request_decompressor.h"
+#include "google/cloud/functions/internal/response_compressor.h"
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_COMPRESSION
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/internal/server_stats.h"
+#include "google/cloud/functions/internal/session_registry.h"
+#include "google/cloud/functions/internal/static_headers.h"
 #include "google/cloud/functions/version.h"
-#include <boost/asio/ip/tcp.hpp>
-#include <boost/asio/strand.hpp>
-#include <boost/beast/core.hpp>
-#include <boost/beast/http.hpp>
-#include <boost/beast/version.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/signal_set.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
+#include <csignal>
 #include <functional>
-#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
-namespace be = boost::beast;
 namespace asio = boost::asio;
-using tcp = boost::asio::ip::tcp;
 
-void HandleSession(tcp::socket socket, Handler const& handler) {
-  auto report_error = [](be::error_code ec, char const* what) {
-    // TODO(#35) - maybe replace with Boost.Log
-    std::cerr << what << ": " << ec.message() << "\n";
-  };
+/**
+ * The threads running the event loop of each session.
+ *
+ * The sessions reference state owned by `RunForTestImpl()`, so all the
+ * threads must be joined before it returns. Sessions may start from other
+ * session threads, when they take over a slot in the `SessionRegistry`.
+ */
+class SessionThreads {
+ public:
+  SessionThreads() = default;
+  SessionThreads(SessionThreads const&) = delete;
+  SessionThreads& operator=(SessionThreads const&) = delete;
+  ~SessionThreads() { Join(); }
 
-  be::error_code ec;
-  for (;;) {
-    be::flat_buffer buffer;
-    // Read a request
-    BeastRequest request;
-    be::http::read(socket, buffer, request, ec);
-    if (ec == be::http::error::end_of_stream) break;
-    if (ec) return report_error(ec, "read");
-    auto const keep_alive = request.keep_alive();
-    auto response = handler(std::move(request));
-    // Flush any buffered output, as the application may be shutdown immediately
-    // after the HTTP response is sent.
-    std::cout << std::flush;
-    std::clog << std::flush;
-    std::cerr << std::flush;
-    // Send the response
-    response.set(be::http::field::server, BOOST_BEAST_VERSION_STRING);
-    response.prepare_payload();
-    response.keep_alive(keep_alive);
-    be::http::write(socket, response, ec);
-    if (ec) return report_error(ec, "write");
+  /// Runs @p ioc in a new thread, and joins any threads that completed.
+  void Run(std::shared_ptr<asio::io_context> ioc) {
+    std::weak_ptr<asio::io_context> w = ioc;
+    std::thread t([ioc = std::move(ioc)]() mutable {
+      ioc->run();
+      // Releasing the event loop marks this thread as done.
+      ioc.reset();
+    });
+    std::vector<std::thread> done;
+    std::unique_lock<std::mutex> lk(mu_);
+    auto const i =
+        std::partition(threads_.begin(), threads_.end(),
+                       [](auto const& e) { return !e.ioc.expired(); });
+    for (auto j = i; j != threads_.end(); ++j) {
+      done.push_back(std::move(j->thread));
+    }
+    threads_.erase(i, threads_.end());
+    threads_.push_back(Entry{std::move(w), std::move(t)});
+    lk.unlock();
+    for (auto& d : done) d.join();
+  }
+
+  /// Stops the event loops that are still running.
+  void Stop() {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto const& e : threads_) {
+      if (auto ioc = e.ioc.lock()) ioc->stop();
+    }
+  }
+
+  /// Joins all the threads.
+  void Join() {
+    std::unique_lock<std::mutex> lk(mu_);
+    auto threads = std::move(threads_);
+    threads_.clear();
+    lk.unlock();
+    for (auto& e : threads) e.thread.join();
   }
-  socket.shutdown(tcp::socket::shutdown_send, ec);
-}
+
+ private:
+  struct Entry {
+    std::weak_ptr<asio::io_context> ioc;
+    std::thread thread;
+  };
+  std::mutex mu_;
+  std::vector<Entry> threads_;
+};
 
 int RunForTestImpl(int argc, char const* const argv[],
                    functions::Function const& function,
@@ -72,58 +119,168 @@ int RunForTestImpl(int argc, char const* const argv[],
   auto vm = ParseOptions(argc, argv);
   if (vm.count("help") != 0) return 0;
 
-  auto address = asio::ip::make_address(vm["address"].as<std::string>());
-  auto port = vm["port"].as<int>();
   auto target = vm["target"].as<std::string>();
+  auto const config = MakeServerConfig(vm);
+  auto const endpoint =
+      config.unix_socket.empty()
+          ? MakeTcpEndpoint(
+                asio::ip::make_address(vm["address"].as<std::string>()),
+                vm["port"].as<int>())
+          : MakeUnixEndpoint(config.unix_socket);
+
+  auto const impl = FunctionImpl::GetImpl(function);
+  auto handler = impl->GetHandler(target);
+  auto streaming_handler = impl->GetStreamingHandler(target);
+  auto writer_handler = impl->GetWriterHandler(target);
+  auto const pre_body_hook = impl->GetPreBodyHook(target);
+#ifdef FUNCTIONS_FRAMEWORK_CPP_HAVE_COMPRESSION
+  if (config.decompress_requests) {
+    if (handler) handler = DecompressRequests(std::move(handler), config);
+    if (streaming_handler) {
+      streaming_handler =
+          DecompressRequests(std::move(streaming_handler), config);
+    }
+    if (writer_handler) {
+      writer_handler = DecompressRequests(std::move(writer_handler), config);
+    }
+  }
+  if (config.compression) {
+    if (handler) handler = CompressResponses(std::move(handler), config);
+    if (streaming_handler) {
+      streaming_handler =
+          CompressResponses(std::move(streaming_handler), config);
+    }
+  }
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_COMPRESSION
+  if (config.engine == SessionEngine::kAsync) {
+    return RunAsyncServer(config, endpoint, handler, streaming_handler,
+                          writer_handler, pre_body_hook, shutdown, actual_port);
+  }
 
   asio::io_context ioc{1};
-  tcp::acceptor acceptor{ioc, {address, static_cast<std::uint16_t>(port)}};
-  acceptor.listen(boost::asio::socket_base::max_connections);
-  actual_port(acceptor.local_endpoint().port());
+  Acceptor acceptor{ioc};
+  Listen(acceptor, endpoint, config, /*reuse_port=*/false);
+  UnixSocketRemover const socket_remover(endpoint);
+  actual_port(ListenPort(acceptor.local_endpoint()));
+
+  std::unique_ptr<HandlerPool> pool;
+  if (config.handler_threads != 0) {
+    pool = std::make_unique<HandlerPool>(config.handler_threads,
+                                         config.handler_queue_size);
+  }
+
+  ServerStats stats;
+  std::unique_ptr<StatsLogger> stats_logger;
+  if (config.stats_log_interval.count() != 0) {
+    stats_logger = std::make_unique<StatsLogger>(
+        config.stats_log_interval,
+        std::vector<std::pair<std::string, ServerStats const*>>{
+            {"sessions", &stats}});
+  }
+
+  SessionRegistry registry(config.max_sessions, config.max_queued_sessions,
+                           config.reject_when_full, stats);
+  RequestLimiter limiter(config.max_concurrent_requests,
+                         config.max_queued_requests, stats,
+                         config.adaptive_concurrency,
+                         config.request_queue_timeout);
+
+  StaticHeaders const static_headers(config.static_headers,
+                                     config.date_header);
+
+  OutputFlusher output(config.output_mode);
 
-  auto handler = FunctionImpl::GetImpl(function)->GetHandler(target);
+  DrainController drain(config.drain_timeout);
 
-  auto handle_session = [h = std::move(handler)](tcp::socket socket) {
-    HandleSession(std::move(socket), h);
+  SessionContext const context{handler,
+                               streaming_handler,
+                               writer_handler,
+                               pre_body_hook,
+                               config,
+                               pool.get(),
+                               &stats,
+                               &registry,
+                               &static_headers,
+                               &output,
+                               &drain,
+                               &limiter};
+
+  // The accept loop runs in `ioc`, until the application shuts down the
+  // server, or the process receives a termination signal.
+  auto work = asio::make_work_guard(ioc);
+  asio::signal_set signals(ioc);
+  if (config.handle_signals) {
+    signals.add(SIGINT);
+    signals.add(SIGTERM);
+  }
+  auto stop_accepting = [&] {
+    boost::system::error_code ec;
+    acceptor.close(ec);
+    signals.cancel(ec);
+    work.reset();
   };
+  signals.async_wait([&](boost::system::error_code const& ec, int /*signal*/) {
+    if (ec) return;
+    drain.Start();
+    stop_accepting();
+  });
 
-  auto cleanup = [](std::vector<std::future<void>> sessions, auto wait) {
-    std::vector<std::future<void>> running;
-    for (auto& s : sessions) {
-      if (s.wait_for(wait) == std::future_status::timeout) {
-        running.push_back(std::move(s));
-        continue;
+  // Declared after the state referenced by the sessions, so the session
+  // threads are joined first.
+  SessionThreads sessions;
+  std::function<void()> do_accept = [&] {
+    if (!acceptor.is_open()) return;
+    auto session_ioc = std::make_shared<asio::io_context>(1);
+    acceptor.async_accept(*session_ioc, [&, session_ioc](
+                                            boost::system::error_code const& ec,
+                                            SessionSocket s) {
+      if (ec == asio::error::operation_aborted) return;
+      if (ec) {
+        // TODO(#35) - maybe replace with Boost.Log
+        std::cerr << "accept: " << ec.message() << "\n";
+      } else {
+        stats.connections_accepted.fetch_add(1, std::memory_order_relaxed);
+        ConfigureSocket(s, config);
+        auto socket = std::make_shared<SessionSocket>(std::move(s));
+        // Each session thread runs its own event loop, serving only the
+        // connection accepted into that loop.
+        auto const admission =
+            registry.Admit([session_ioc, socket, &context, &sessions] {
+              std::make_shared<HttpSession>(std::move(*socket), context)
+                  ->Start();
+              sessions.Run(session_ioc);
+            });
+        if (admission == SessionRegistry::Admission::kRejected) {
+          RejectSession(std::move(*socket));
+          sessions.Run(session_ioc);
+        }
       }
-      s.get();
-    }
-    return running;
+      if (shutdown()) return stop_accepting();
+      // Stop accepting connections until a session completes, the new
+      // connections wait in the listen backlog.
+      auto const paused =
+          registry.PauseAccept([&] { asio::post(ioc, do_accept); });
+      if (!paused) do_accept();
+    });
   };
+  if (!shutdown()) do_accept();
+  ioc.run();
 
-  // Reaching this number of sessions triggers a cleanup of any sessions that
-  // may have finished already. We allow up to 80 sessions to start without
-  // blocking, this should be enough for Cloud Run and Cloud Functions:
-  //     https://cloud.google.com/run/docs/about-concurrency#concurrency_values
-  auto constexpr kSessionCleanupThreshold = 80;
-
-  // If we reach this number of sessions we block until we are below the cleanup
-  // threshold.
-  auto constexpr kMaximumSessions = 160;
-
-  std::vector<std::future<void>> sessions;
-  while (!shutdown()) {
-    if (sessions.size() >= kSessionCleanupThreshold) {
-      sessions = cleanup(std::move(sessions), std::chrono::milliseconds(0));
-    }
-    while (sessions.size() >= kMaximumSessions) {
-      sessions = cleanup(std::move(sessions), std::chrono::seconds(1));
-    }
-    auto socket = acceptor.accept(ioc);
-    if (!socket.is_open()) break;
-    // Run a thread per-session, transferring ownership of the socket
-    sessions.push_back(
-        std::async(std::launch::async, handle_session, std::move(socket)));
+  registry.Shutdown();
+  auto status = 0;
+  if (drain.draining()) {
+    if (!drain.WaitForIdle()) status = ReportDrainTimeout(drain);
+    // Reject the requests still queued, while their sessions can respond.
+    limiter.Shutdown();
+    // The functions still running in the pool resume their sessions, which
+    // must not be stopped before then.
+    if (pool) pool->Shutdown();
+    output.Flush();
+    sessions.Stop();
   }
-  return 0;
+  registry.WaitForIdle();
+  sessions.Join();
+  return status;
 }
 
 int RunImpl(int argc, char const* const argv[],
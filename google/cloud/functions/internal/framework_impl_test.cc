@@ -16,26 +16,51 @@
 #include "google/cloud/functions/framework.h"
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
 #include <boost/beast.hpp>
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
 #include <future>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
+using ::testing::ElementsAre;
+using ::testing::EndsWith;
+using ::testing::HasSubstr;
 using ::testing::IsEmpty;
 
+volatile std::sig_atomic_t signal_received = 0;
+
 char const* const kTestArgv[] = {"unused", "--port=0"};
 auto constexpr kTestArgc = sizeof(kTestArgv) / sizeof(kTestArgv[0]);
 
+char const* const kTestAsyncArgv[] = {"unused", "--port=0",
+                                      "--session-engine=async",
+                                      "--io-threads=2"};
+auto constexpr kTestAsyncArgc =
+    sizeof(kTestAsyncArgv) / sizeof(kTestAsyncArgv[0]);
+
 char const* const kTestInvalidArgv[] = {"unused", "--port=12345467"};
 auto constexpr kTestInvalidArgc =
     sizeof(kTestInvalidArgv) / sizeof(kTestInvalidArgv[0]);
 
-std::string HttpGet(std::string const& host, std::string const& port,
-                    std::string const& target) {
+auto HttpGetResponse(std::string const& host, std::string const& port,
+                     std::string const& target) {
   namespace beast = boost::beast;
   namespace http = beast::http;
   using tcp = boost::asio::ip::tcp;
@@ -59,8 +84,12 @@ std::string HttpGet(std::string const& host, std::string const& port,
   http::read(stream, buffer, res);
   stream.socket().shutdown(tcp::socket::shutdown_both);
 
-  // Return the body.
-  return std::move(res.body());
+  return res;
+}
+
+std::string HttpGet(std::string const& host, std::string const& port,
+                    std::string const& target) {
+  return std::move(HttpGetResponse(host, port, target).body());
 }
 
 std::string CloudEventGet(std::string const& host, std::string const& port,
@@ -130,6 +159,1342 @@ TEST(FrameworkTest, Http) {
   EXPECT_EQ(done.get(), 0);
 }
 
+std::vector<std::string> HttpGetKeepAlive(
+    std::string const& host, std::string const& port,
+    std::vector<std::string> const& targets) {
+  namespace beast = boost::beast;
+  namespace http = beast::http;
+  using tcp = boost::asio::ip::tcp;
+
+  boost::asio::io_context ioc;
+  tcp::resolver resolver(ioc);
+  beast::tcp_stream stream(ioc);
+  auto const results = resolver.resolve(host, port);
+  stream.connect(results);
+
+  // Send all the requests over the same connection.
+  auto constexpr kHttpVersion = 11;  // 1.1 as Boost.Beast spells it
+  beast::flat_buffer buffer;
+  std::vector<std::string> bodies;
+  for (auto const& target : targets) {
+    http::request<http::string_body> req{http::verb::get, target,
+                                         kHttpVersion};
+    req.set(http::field::host, host);
+    req.keep_alive(true);
+    req.prepare_payload();
+    http::write(stream, req);
+    http::response<http::string_body> res;
+    http::read(stream, buffer, res);
+    bodies.push_back(std::move(res.body()));
+  }
+  stream.socket().shutdown(tcp::socket::shutdown_both);
+  return bodies;
+}
+
+/// Sends all the requests in a single write, then reads all the responses.
+std::vector<std::string> HttpGetPipelined(
+    std::string const& host, std::string const& port,
+    std::vector<std::string> const& targets) {
+  namespace beast = boost::beast;
+  namespace http = beast::http;
+  using tcp = boost::asio::ip::tcp;
+
+  boost::asio::io_context ioc;
+  tcp::resolver resolver(ioc);
+  beast::tcp_stream stream(ioc);
+  auto const results = resolver.resolve(host, port);
+  stream.connect(results);
+
+  std::string requests;
+  for (auto const& target : targets) {
+    requests += "GET " + target + " HTTP/1.1\r\nHost: " + host + "\r\n\r\n";
+  }
+  // Split the last request, the server must wait for the rest of it.
+  auto const split = requests.size() - 4;
+  boost::asio::write(stream, boost::asio::buffer(requests.data(), split));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  boost::asio::write(stream, boost::asio::buffer(requests.data() + split,
+                                                 requests.size() - split));
+
+  beast::flat_buffer buffer;
+  std::vector<std::string> bodies;
+  for (std::size_t i = 0; i != targets.size(); ++i) {
+    http::response<http::string_body> res;
+    http::read(stream, buffer, res);
+    bodies.push_back(std::move(res.body()));
+  }
+  stream.socket().shutdown(tcp::socket::shutdown_both);
+  return bodies;
+}
+
+void CheckPipelined(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, hello);
+  auto port = std::to_string(port_f.get());
+
+  auto actual = HttpGetPipelined("localhost", port, {"/a", "/b", "/c", "/d"});
+  EXPECT_THAT(actual,
+              ElementsAre("Hello World from /a", "Hello World from /b",
+                          "Hello World from /c", "Hello World from /d"));
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, PipelinedThreads) {
+  CheckPipelined({"unused", "--port=0"});
+}
+
+TEST(FrameworkTest, PipelinedAsync) {
+  CheckPipelined({"unused", "--port=0", "--session-engine=async",
+                  "--handler-threads=2"});
+}
+
+TEST(FrameworkTest, HttpAsync) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}
+        .set_header("content-type", "text/plain")
+        .set_payload("Hello World from " + r.target());
+  };
+  auto run = [&](int argc, char const* const argv[],
+                 functions::UserHttpFunction f) {
+    return RunForTest(
+        argc, argv, functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run,
+                         static_cast<int>(kTestAsyncArgc), kTestAsyncArgv,
+                         hello);
+
+  auto port = port_f.get();
+  auto actual = HttpGetKeepAlive("localhost", std::to_string(port),
+                                 {"/say/hello", "/say/goodbye"});
+  EXPECT_THAT(actual, ElementsAre("Hello World from /say/hello",
+                                  "Hello World from /say/goodbye"));
+  shutdown.store(true);
+  // Making a second request guarantees the change in `shutdown` is seen, but
+  // can fail.
+  try {
+    (void)HttpGet("localhost", std::to_string(port), "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, HttpReactors) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](int argc, char const* const argv[],
+                 functions::UserHttpFunction f) {
+    return RunForTest(
+        argc, argv, functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  char const* const argv[] = {"unused", "--port=0", "--session-engine=async",
+                              "--reactors=3", "--handler-threads=1"};
+  auto done = std::async(std::launch::async, run,
+                         static_cast<int>(sizeof(argv) / sizeof(argv[0])),
+                         argv, hello);
+
+  auto port = std::to_string(port_f.get());
+  // The kernel picks a reactor for each connection, any of them should work.
+  for (int i = 0; i != 6; ++i) {
+    auto const target = "/say/hello/" + std::to_string(i);
+    EXPECT_EQ(HttpGet("localhost", port, target), "Hello World from " + target);
+  }
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, HttpHandlerPoolOverloaded) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  std::promise<void> started;
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  auto hello = [&started, released](functions::HttpRequest const& r) {
+    if (r.target() == "/block") {
+      started.set_value();
+      released.wait();
+    }
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](int argc, char const* const argv[],
+                 functions::UserHttpFunction f) {
+    return RunForTest(
+        argc, argv, functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  char const* const argv[] = {
+      "unused",           "--port=0",          "--session-engine=async",
+      "--io-threads=2",   "--handler-threads=1", "--handler-queue-size=0",
+  };
+  auto done = std::async(std::launch::async, run,
+                         static_cast<int>(sizeof(argv) / sizeof(argv[0])),
+                         argv, hello);
+
+  auto port = std::to_string(port_f.get());
+  // Occupy the only handler thread, with no room in the queue any other request
+  // is rejected.
+  auto blocked = std::async(std::launch::async, HttpGet, "localhost", port,
+                            "/block");
+  started.get_future().wait();
+  auto const overloaded = HttpGetResponse("localhost", port, "/rejected");
+  EXPECT_EQ(overloaded.result(),
+            boost::beast::http::status::service_unavailable);
+
+  release.set_value();
+  EXPECT_EQ(blocked.get(), "Hello World from /block");
+  EXPECT_EQ(HttpGet("localhost", port, "/accepted"),
+            "Hello World from /accepted");
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+/// Sends @p partial_request and returns how long until the server disconnects.
+std::chrono::milliseconds WaitForDisconnect(
+    std::string const& host, std::string const& port,
+    std::string const& partial_request) {
+  namespace beast = boost::beast;
+  using tcp = boost::asio::ip::tcp;
+
+  boost::asio::io_context ioc;
+  tcp::resolver resolver(ioc);
+  tcp::socket socket(ioc);
+  boost::asio::connect(socket, resolver.resolve(host, port));
+  auto const start = std::chrono::steady_clock::now();
+  if (!partial_request.empty()) {
+    boost::asio::write(socket, boost::asio::buffer(partial_request));
+  }
+  beast::error_code ec;
+  std::array<char, 1024> buffer;
+  while (!ec) socket.read_some(boost::asio::buffer(buffer), ec);
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+void CheckTimeouts(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, hello);
+  auto port = std::to_string(port_f.get());
+
+  // The timeouts are configured to 1 second, we tolerate up to 5.
+  auto constexpr kTolerance = std::chrono::seconds(5);
+  EXPECT_LE(WaitForDisconnect("localhost", port, ""), kTolerance);
+  EXPECT_LE(WaitForDisconnect("localhost", port, "GET / HTTP/1.1\r\n"),
+            kTolerance);
+  EXPECT_LE(WaitForDisconnect("localhost", port,
+                              "POST / HTTP/1.1\r\nHost: localhost\r\n"
+                              "Content-Length: 100\r\n\r\nincomplete"),
+            kTolerance);
+  // Requests that complete in time are not affected.
+  EXPECT_EQ(HttpGet("localhost", port, "/say/hello"),
+            "Hello World from /say/hello");
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, TimeoutsThreads) {
+  CheckTimeouts({"unused", "--port=0", "--idle-timeout=1",
+                 "--header-read-timeout=1", "--body-read-timeout=1",
+                 "--write-timeout=1"});
+}
+
+TEST(FrameworkTest, TimeoutsAsync) {
+  CheckTimeouts({"unused", "--port=0", "--session-engine=async",
+                 "--idle-timeout=1", "--header-read-timeout=1",
+                 "--body-read-timeout=1", "--write-timeout=1"});
+}
+
+/// Runs a server limited to a single session, blocking that session.
+void CheckSessionLimit(std::vector<char const*> argv, bool reject) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  std::promise<void> started;
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  auto hello = [&started, released](functions::HttpRequest const& r) {
+    if (r.target() == "/block") {
+      started.set_value();
+      released.wait();
+    }
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, hello);
+  auto port = std::to_string(port_f.get());
+
+  auto blocked = std::async(std::launch::async, HttpGet, "localhost", port,
+                            "/block");
+  started.get_future().wait();
+  if (reject) {
+    auto const rejected = HttpGetResponse("localhost", port, "/rejected");
+    EXPECT_EQ(rejected.result(),
+              boost::beast::http::status::service_unavailable);
+  } else {
+    // The connection waits until the blocked session completes.
+    auto paused = std::async(std::launch::async, HttpGet, "localhost", port,
+                             "/paused");
+    EXPECT_EQ(paused.wait_for(std::chrono::milliseconds(200)),
+              std::future_status::timeout);
+    release.set_value();
+    EXPECT_EQ(paused.get(), "Hello World from /paused");
+  }
+  if (reject) release.set_value();
+  EXPECT_EQ(blocked.get(), "Hello World from /block");
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, SessionLimitRejectThreads) {
+  CheckSessionLimit({"unused", "--port=0", "--max-sessions=1",
+                     "--session-limit-action=reject"},
+                    /*reject=*/true);
+}
+
+TEST(FrameworkTest, SessionLimitRejectAsync) {
+  CheckSessionLimit({"unused", "--port=0", "--session-engine=async",
+                     "--io-threads=2", "--max-sessions=1",
+                     "--session-limit-action=reject"},
+                    /*reject=*/true);
+}
+
+TEST(FrameworkTest, SessionLimitPauseThreads) {
+  CheckSessionLimit({"unused", "--port=0", "--max-sessions=1"},
+                    /*reject=*/false);
+}
+
+TEST(FrameworkTest, SessionLimitPauseAsync) {
+  CheckSessionLimit({"unused", "--port=0", "--session-engine=async",
+                     "--io-threads=2", "--max-sessions=1"},
+                    /*reject=*/false);
+}
+
+TEST(FrameworkTest, StaticHeaders) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}
+        .set_header("Server", "overridden-by-the-framework")
+        .set_payload("Hello World from " + r.target());
+  };
+  char const* const argv[] = {"unused", "--port=0",
+                              "--static-header=X-Instance: test-instance",
+                              "--date-header"};
+  auto done = std::async(std::launch::async, [&] {
+    return RunForTest(
+        static_cast<int>(sizeof(argv) / sizeof(argv[0])), argv,
+        functions::MakeFunction(functions::UserHttpFunction(hello)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  });
+  auto port = std::to_string(port_f.get());
+
+  namespace http = boost::beast::http;
+  auto const response = HttpGetResponse("localhost", port, "/say/hello");
+  EXPECT_EQ(response.body(), "Hello World from /say/hello");
+  EXPECT_EQ(response[http::field::server], BOOST_BEAST_VERSION_STRING);
+  EXPECT_EQ(response.count(http::field::server), 1);
+  EXPECT_EQ(response["X-Instance"], "test-instance");
+  EXPECT_THAT(std::string(response[http::field::date]), EndsWith(" GMT"));
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+/// The static headers replace the fields with the same name set by a function.
+void CheckStaticHeadersReplace(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}
+        .set_header("Date", "Mon, 01 Jan 2001 00:00:00 GMT")
+        .set_header("x-instance", "overridden-by-the-framework")
+        .set_payload("Hello World from " + r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, hello);
+  auto port = std::to_string(port_f.get());
+
+  namespace http = boost::beast::http;
+  auto const response = HttpGetResponse("localhost", port, "/say/hello");
+  EXPECT_EQ(response.body(), "Hello World from /say/hello");
+  EXPECT_EQ(response.count(http::field::date), 1);
+  EXPECT_NE(response[http::field::date], "Mon, 01 Jan 2001 00:00:00 GMT");
+  EXPECT_EQ(response.count("X-Instance"), 1);
+  EXPECT_EQ(response["X-Instance"], "test-instance");
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, StaticHeadersReplaceThreads) {
+  CheckStaticHeadersReplace({"unused", "--port=0",
+                             "--static-header=X-Instance: test-instance",
+                             "--date-header"});
+}
+
+TEST(FrameworkTest, StaticHeadersReplaceAsync) {
+  CheckStaticHeadersReplace({"unused", "--port=0", "--session-engine=async",
+                             "--static-header=X-Instance: test-instance",
+                             "--date-header"});
+}
+
+void CheckOutputFlushed(std::vector<char const*> argv) {
+  std::ostringstream captured;
+  auto* saved = std::cout.rdbuf(captured.rdbuf());
+
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    std::cout << "Running " << r.target() << std::endl;
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, hello);
+  auto port = std::to_string(port_f.get());
+
+  // The output must reach the stream before the response is sent.
+  EXPECT_EQ(HttpGet("localhost", port, "/a"), "Hello World from /a");
+  EXPECT_EQ(captured.str(), "Running /a\n");
+  EXPECT_EQ(HttpGet("localhost", port, "/b"), "Hello World from /b");
+  EXPECT_EQ(captured.str(), "Running /a\nRunning /b\n");
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+  std::cout.rdbuf(saved);
+}
+
+TEST(FrameworkTest, OutputFlushOnOutput) {
+  CheckOutputFlushed({"unused", "--port=0", "--output-flush=on-output"});
+}
+
+TEST(FrameworkTest, OutputFlushCapture) {
+  CheckOutputFlushed({"unused", "--port=0", "--session-engine=async",
+                      "--handler-threads=2", "--output-flush=capture"});
+}
+
+/// Runs two servers with the default `--output-flush`, stopping the first one
+/// while the second is still running.
+TEST(FrameworkTest, OutputFlushServersOutOfOrder) {
+  std::ostringstream captured;
+  auto* saved = std::cout.rdbuf(captured.rdbuf());
+
+  auto hello = [](functions::HttpRequest const& r) {
+    std::cout << "Running " << r.target() << std::endl;
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  struct Server {
+    std::promise<int> port_p;
+    std::atomic<bool> shutdown{false};
+    std::future<int> done;
+    std::string port;
+  };
+  auto start = [&hello](Server& server, std::vector<char const*> argv) {
+    auto port_f = server.port_p.get_future();
+    server.done = std::async(std::launch::async, [&server, argv, hello] {
+      return RunForTest(
+          static_cast<int>(argv.size()), argv.data(),
+          functions::MakeFunction(functions::UserHttpFunction(hello)),
+          [&server]() { return server.shutdown.load(); },
+          [&server](int port) mutable { server.port_p.set_value(port); });
+    });
+    server.port = std::to_string(port_f.get());
+  };
+  auto stop = [](Server& server) {
+    server.shutdown.store(true);
+    try {
+      (void)HttpGet("localhost", server.port, "/quit/now");
+    } catch (...) {
+    }
+    return server.done.get();
+  };
+
+  Server first;
+  start(first, {"unused", "--port=0"});
+  Server second;
+  start(second,
+        {"unused", "--port=0", "--session-engine=async", "--io-threads=2"});
+  EXPECT_EQ(HttpGet("localhost", first.port, "/a"), "Hello World from /a");
+  EXPECT_THAT(captured.str(), HasSubstr("Running /a\n"));
+
+  // The second server keeps flushing the output after the first one stops.
+  EXPECT_EQ(stop(first), 0);
+  EXPECT_EQ(HttpGet("localhost", second.port, "/b"), "Hello World from /b");
+  EXPECT_THAT(captured.str(), HasSubstr("Running /b\n"));
+  EXPECT_EQ(stop(second), 0);
+
+  // The last server to stop restores the original stream buffer.
+  EXPECT_EQ(std::cout.rdbuf(), captured.rdbuf());
+  std::cout << "after\n";
+  EXPECT_THAT(captured.str(), EndsWith("after\n"));
+  std::cout.rdbuf(saved);
+}
+
+using TestRequest =
+    boost::beast::http::request<boost::beast::http::string_body>;
+using TestResponse =
+    boost::beast::http::response<boost::beast::http::string_body>;
+
+/// Sends @p requests over a single connection, and returns the responses.
+std::vector<TestResponse> HttpSend(std::string const& host,
+                                   std::string const& port,
+                                   std::vector<TestRequest> requests) {
+  namespace beast = boost::beast;
+  namespace http = beast::http;
+  using tcp = boost::asio::ip::tcp;
+
+  boost::asio::io_context ioc;
+  tcp::resolver resolver(ioc);
+  beast::tcp_stream stream(ioc);
+  stream.connect(resolver.resolve(host, port));
+  beast::flat_buffer buffer;
+  std::vector<TestResponse> responses;
+  for (auto& req : requests) {
+    req.set(http::field::host, host);
+    req.prepare_payload();
+    http::write(stream, req);
+    TestResponse res;
+    http::read(stream, buffer, res);
+    responses.push_back(std::move(res));
+  }
+  beast::error_code ec;
+  stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+  return responses;
+}
+
+TestRequest MakePost(std::string const& target, std::string body) {
+  auto constexpr kHttpVersion = 11;
+  TestRequest req{boost::beast::http::verb::post, target, kHttpVersion};
+  req.body() = std::move(body);
+  return req;
+}
+
+void CheckStreamingBody(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  // Read the body in small chunks, and return a summary of the body.
+  auto count = [](functions::HttpRequest const& r,
+                  functions::HttpBodyReader reader) {
+    EXPECT_THAT(r.payload(), IsEmpty());
+    if (r.target() == "/ignore-body") return functions::HttpResponse{};
+    std::array<char, 4096> buffer;
+    std::size_t size = 0;
+    std::size_t count_x = 0;
+    for (auto n = reader.Read(buffer.data(), buffer.size()); n != 0;
+         n = reader.Read(buffer.data(), buffer.size())) {
+      size += n;
+      count_x += std::count(buffer.begin(), buffer.begin() + n, 'x');
+    }
+    return functions::HttpResponse{}.set_payload(
+        std::to_string(size) + " " + std::to_string(count_x));
+  };
+  auto done = std::async(std::launch::async, [&] {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(functions::UserHttpStreamingFunction(count)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  });
+  auto port = std::to_string(port_f.get());
+
+  // The body is larger than the default body limit, but the function reads it
+  // incrementally. The connection is reused for the next request.
+  auto constexpr kLargeBody = 4 * 1024 * 1024;
+  auto responses = HttpSend("localhost", port,
+                            {MakePost("/large", std::string(kLargeBody, 'x')),
+                             MakePost("/small", "xyx"),
+                             MakePost("/empty", {})});
+  ASSERT_EQ(responses.size(), 3);
+  EXPECT_EQ(responses[0].body(), std::to_string(kLargeBody) + " " +
+                                     std::to_string(kLargeBody));
+  EXPECT_TRUE(responses[0].keep_alive());
+  EXPECT_EQ(responses[1].body(), "3 2");
+  EXPECT_EQ(responses[2].body(), "0 0");
+
+  // If the function does not read the body the connection is closed.
+  responses = HttpSend("localhost", port,
+                       {MakePost("/ignore-body", std::string(1024, 'x'))});
+  ASSERT_EQ(responses.size(), 1);
+  EXPECT_EQ(responses[0].result_int(), functions::HttpResponse::kOkay);
+  EXPECT_FALSE(responses[0].keep_alive());
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, StreamingBodyThreads) {
+  CheckStreamingBody({"unused", "--port=0", "--max-body-bytes=0"});
+}
+
+TEST(FrameworkTest, StreamingBodyAsync) {
+  CheckStreamingBody({"unused", "--port=0", "--session-engine=async",
+                      "--handler-threads=2", "--max-body-bytes=0",
+                      "--body-read-timeout=5"});
+}
+
+void CheckMessageLimits(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto done = std::async(std::launch::async, [&] {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(functions::UserHttpFunction(hello)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  });
+  auto port = std::to_string(port_f.get());
+
+  auto responses =
+      HttpSend("localhost", port, {MakePost("/ok", std::string(16, 'x'))});
+  ASSERT_EQ(responses.size(), 1);
+  EXPECT_EQ(responses[0].body(), "Hello World from /ok");
+
+  responses = HttpSend("localhost", port,
+                       {MakePost("/large-body", std::string(64 * 1024, 'x'))});
+  ASSERT_EQ(responses.size(), 1);
+  EXPECT_EQ(responses[0].result_int(),
+            functions::HttpResponse::kPayloadTooLarge);
+  EXPECT_FALSE(responses[0].keep_alive());
+
+  auto large_header = MakePost("/large-header", {});
+  large_header.set("x-large", std::string(1024, 'x'));
+  responses = HttpSend("localhost", port, {std::move(large_header)});
+  ASSERT_EQ(responses.size(), 1);
+  EXPECT_EQ(responses[0].result_int(),
+            functions::HttpResponse::kRequestHeaderFieldsTooLarge);
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, MessageLimitsThreads) {
+  CheckMessageLimits({"unused", "--port=0", "--max-body-bytes=16",
+                      "--max-header-bytes=512"});
+}
+
+TEST(FrameworkTest, MessageLimitsAsync) {
+  CheckMessageLimits({"unused", "--port=0", "--session-engine=async",
+                      "--max-body-bytes=16", "--max-header-bytes=512"});
+}
+
+/// Sends a request header, with @p fields, over @p socket.
+void WriteHeader(boost::asio::ip::tcp::socket& socket, std::string_view target,
+                 std::string const& fields) {
+  auto const header = "POST " + std::string(target) +
+                      " HTTP/1.1\r\nHost: localhost\r\n" + fields + "\r\n";
+  boost::asio::write(socket, boost::asio::buffer(header));
+}
+
+void CheckPreBodyHook(std::vector<char const*> argv) {
+  namespace beast = boost::beast;
+  namespace http = beast::http;
+  using tcp = boost::asio::ip::tcp;
+
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}.set_payload(
+        "Hello " + r.target() + " " + std::to_string(r.payload().size()));
+  };
+  auto hook = [](functions::HttpRequest const& r)
+      -> std::optional<functions::HttpResponse> {
+    EXPECT_THAT(r.payload(), IsEmpty());
+    if (r.headers().count("Authorization") != 0) return std::nullopt;
+    return functions::HttpResponse{}.set_result(
+        functions::HttpResponse::kUnauthorized);
+  };
+  auto done = std::async(std::launch::async, [&] {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::WithPreBodyHook(
+            functions::MakeFunction(functions::UserHttpFunction(hello)),
+            hook),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  });
+  auto port = std::to_string(port_f.get());
+
+  boost::asio::io_context ioc;
+  tcp::resolver resolver(ioc);
+  auto const endpoints = resolver.resolve("localhost", port);
+  auto connect = [&] {
+    tcp::socket socket(ioc);
+    boost::asio::connect(socket, endpoints);
+    return socket;
+  };
+
+  // The client sends the body only after `100 Continue`.
+  auto socket = connect();
+  beast::flat_buffer buffer;
+  WriteHeader(socket, "/accepted",
+              "Authorization: Bearer x\r\nContent-Length: 5\r\n"
+              "Expect: 100-continue\r\n");
+  std::string interim(std::strlen("HTTP/1.1 100 Continue\r\n\r\n"), '\0');
+  boost::asio::read(socket, boost::asio::buffer(interim));
+  EXPECT_EQ(interim, "HTTP/1.1 100 Continue\r\n\r\n");
+  boost::asio::write(socket, boost::asio::buffer(std::string("hello")));
+  TestResponse res;
+  http::read(socket, buffer, res);
+  EXPECT_EQ(res.body(), "Hello /accepted 5");
+  EXPECT_TRUE(res.keep_alive());
+
+  // Requests without a body are rejected, but the connection is reused.
+  WriteHeader(socket, "/no-body", "");
+  res = {};
+  http::read(socket, buffer, res);
+  EXPECT_EQ(res.result_int(), functions::HttpResponse::kUnauthorized);
+  EXPECT_TRUE(res.keep_alive());
+
+  // The function never sees the rejected request, nor its body.
+  socket = connect();
+  buffer.clear();
+  WriteHeader(socket, "/rejected",
+              "Content-Length: 1048576\r\nExpect: 100-continue\r\n");
+  res = {};
+  http::read(socket, buffer, res);
+  EXPECT_EQ(res.result_int(), functions::HttpResponse::kUnauthorized);
+  EXPECT_FALSE(res.keep_alive());
+
+  socket = connect();
+  buffer.clear();
+  WriteHeader(socket, "/unknown",
+              "Authorization: Bearer x\r\nContent-Length: 5\r\n"
+              "Expect: something-else\r\n");
+  res = {};
+  http::read(socket, buffer, res);
+  EXPECT_EQ(res.result_int(), functions::HttpResponse::kExpectationFailed);
+  socket.close();
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, PreBodyHookThreads) {
+  CheckPreBodyHook({"unused", "--port=0"});
+}
+
+TEST(FrameworkTest, PreBodyHookAsync) {
+  CheckPreBodyHook({"unused", "--port=0", "--session-engine=async"});
+}
+
+void CheckWriter(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  std::promise<void> first_received;
+  auto first_received_f = first_received.get_future().share();
+  auto writer = [first_received_f](functions::HttpRequest const& r,
+                                   functions::HttpResponseWriter writer) {
+    if (r.target() == "/sse") {
+      writer.set_header("Content-Type", "text/event-stream");
+      writer.WriteEvent("a");
+      writer.WriteEvent("b", "e", "1");
+      return;
+    }
+    if (r.target() == "/wait") {
+      writer.Write("first");
+      // The client must receive the first chunk before the function returns.
+      first_received_f.wait_for(std::chrono::seconds(10));
+      writer.Write("second");
+      return;
+    }
+    if (r.target() == "/throw") {
+      writer.Write("partial");
+      throw std::runtime_error("uh-oh");
+    }
+    writer.set_result(functions::HttpResponse::kAccepted)
+        .set_header("x-test", "no-writes");
+  };
+  auto done = std::async(std::launch::async, [&] {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(functions::UserHttpWriterFunction(writer)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  });
+  auto port = std::to_string(port_f.get());
+
+  auto responses = HttpSend("localhost", port,
+                            {MakePost("/sse", {}), MakePost("/empty", {})});
+  ASSERT_EQ(responses.size(), 2);
+  EXPECT_TRUE(responses[0].chunked());
+  EXPECT_EQ(responses[0][boost::beast::http::field::content_type],
+            "text/event-stream");
+  EXPECT_EQ(responses[0].body(),
+            "data: a\n\nevent: e\nid: 1\ndata: b\n\n");
+  EXPECT_EQ(responses[1].result_int(), functions::HttpResponse::kAccepted);
+  EXPECT_EQ(responses[1]["x-test"], "no-writes");
+  EXPECT_THAT(responses[1].body(), IsEmpty());
+
+  // Read the response incrementally, the first chunk arrives before the
+  // function completes.
+  {
+    namespace http = boost::beast::http;
+    using tcp = boost::asio::ip::tcp;
+    boost::asio::io_context ioc;
+    tcp::resolver resolver(ioc);
+    tcp::socket socket(ioc);
+    boost::asio::connect(socket, resolver.resolve("localhost", port));
+    auto request = MakePost("/wait", {});
+    request.prepare_payload();
+    http::write(socket, request);
+    std::string received;
+    std::array<char, 1024> buffer;
+    while (received.find("first") == std::string::npos) {
+      auto const n = socket.read_some(boost::asio::buffer(buffer));
+      received.append(buffer.data(), n);
+    }
+    EXPECT_EQ(received.find("second"), std::string::npos);
+    first_received.set_value();
+    boost::beast::error_code ec;
+    while (received.find("\r\n0\r\n\r\n") == std::string::npos && !ec) {
+      auto const n = socket.read_some(boost::asio::buffer(buffer), ec);
+      received.append(buffer.data(), n);
+    }
+    EXPECT_THAT(received, HasSubstr("second"));
+    EXPECT_THAT(received, EndsWith("\r\n0\r\n\r\n"));
+  }
+
+  // A failure after the headers are sent truncates the response.
+  EXPECT_THROW(HttpSend("localhost", port, {MakePost("/throw", {})}),
+               std::exception);
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, WriterThreads) {
+  CheckWriter({"unused", "--port=0", "--write-timeout=5"});
+}
+
+TEST(FrameworkTest, WriterAsync) {
+  CheckWriter({"unused", "--port=0", "--session-engine=async",
+               "--handler-threads=2"});
+}
+
+/// Runs a server limited to a single concurrent request, with a short queue.
+void CheckRequestLimit(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  std::promise<void> started;
+  std::promise<void> release;
+  auto release_f = release.get_future().share();
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  auto handler = [&](functions::HttpRequest const& r) {
+    auto const n = ++running;
+    if (n > max_running.load()) max_running.store(n);
+    if (r.target() == "/block") {
+      started.set_value();
+      release_f.wait();
+    }
+    --running;
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, handler);
+  auto port = std::to_string(port_f.get());
+
+  // An idle keep-alive connection does not hold a request slot.
+  auto const get = [&port](std::string const& target) {
+    auto constexpr kHttpVersion = 11;
+    TestRequest req{boost::beast::http::verb::get, target, kHttpVersion};
+    return HttpSend("localhost", port, {req}).front();
+  };
+  EXPECT_EQ(get("/idle").body(), "Hello World from /idle");
+
+  // The first request blocks the only slot, the second one waits in the
+  // queue, and the third one is rejected without calling the function.
+  auto blocked = std::async(std::launch::async, get, "/block");
+  started.get_future().get();
+  auto queued = std::async(std::launch::async, get, "/queued");
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  auto const rejected = get("/rejected");
+  EXPECT_EQ(rejected.result_int(), 429);
+  EXPECT_EQ(rejected[boost::beast::http::field::retry_after], "1");
+
+  release.set_value();
+  EXPECT_EQ(blocked.get().body(), "Hello World from /block");
+  EXPECT_EQ(queued.get().body(), "Hello World from /queued");
+  EXPECT_EQ(max_running.load(), 1);
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, RequestLimitThreads) {
+  CheckRequestLimit({"unused", "--port=0", "--max-concurrent-requests=1",
+                     "--max-queued-requests=1", "--overload-status=429"});
+}
+
+TEST(FrameworkTest, RequestLimitAsync) {
+  CheckRequestLimit({"unused", "--port=0", "--session-engine=async",
+                     "--handler-threads=2", "--max-concurrent-requests=1",
+                     "--max-queued-requests=1", "--overload-status=429"});
+}
+
+/// Requests that wait in the queue past the timeout are rejected.
+void CheckRequestQueueTimeout(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  std::promise<void> started;
+  std::promise<void> release;
+  auto release_f = release.get_future().share();
+  auto handler = [&started, release_f](functions::HttpRequest const& r) {
+    if (r.target() == "/block") {
+      started.set_value();
+      release_f.wait();
+    }
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, handler);
+  auto port = std::to_string(port_f.get());
+
+  auto const get = [&port](std::string const& target) {
+    auto constexpr kHttpVersion = 11;
+    TestRequest req{boost::beast::http::verb::get, target, kHttpVersion};
+    return HttpSend("localhost", port, {req}).front();
+  };
+
+  auto blocked = std::async(std::launch::async, get, "/block");
+  started.get_future().get();
+  auto const queued = get("/queued");
+  EXPECT_EQ(queued.result_int(), 429);
+  EXPECT_EQ(queued[boost::beast::http::field::retry_after], "1");
+
+  release.set_value();
+  EXPECT_EQ(blocked.get().body(), "Hello World from /block");
+  EXPECT_EQ(get("/next").body(), "Hello World from /next");
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, RequestQueueTimeoutThreads) {
+  CheckRequestQueueTimeout(
+      {"unused", "--port=0", "--max-concurrent-requests=1",
+       "--max-queued-requests=1", "--request-queue-timeout=1",
+       "--overload-status=429"});
+}
+
+TEST(FrameworkTest, RequestQueueTimeoutAsync) {
+  CheckRequestQueueTimeout(
+      {"unused", "--port=0", "--session-engine=async", "--handler-threads=2",
+       "--max-concurrent-requests=1", "--max-queued-requests=1",
+       "--request-queue-timeout=1", "--overload-status=429"});
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+/// Sends a GET request for each of @p targets over a Unix domain socket.
+std::vector<std::string> UnixSocketGet(
+    std::string const& path, std::vector<std::string> const& targets) {
+  namespace beast = boost::beast;
+  namespace http = beast::http;
+  using local = boost::asio::local::stream_protocol;
+
+  boost::asio::io_context ioc;
+  local::socket socket(ioc);
+  socket.connect(local::endpoint(path));
+  auto constexpr kHttpVersion = 11;
+  beast::flat_buffer buffer;
+  std::vector<std::string> bodies;
+  for (auto const& target : targets) {
+    TestRequest req{http::verb::get, target, kHttpVersion};
+    req.set(http::field::host, "localhost");
+    http::write(socket, req);
+    TestResponse res;
+    http::read(socket, buffer, res);
+    bodies.push_back(std::move(res.body()));
+  }
+  beast::error_code ec;
+  socket.shutdown(local::socket::shutdown_both, ec);
+  return bodies;
+}
+
+void CheckUnixSocket(std::vector<char const*> argv) {
+  auto const name = "functions-framework-" +
+                    std::to_string(std::random_device{}()) + ".sock";
+  auto const path = (std::filesystem::temp_directory_path() / name).string();
+  auto const option = "--unix-socket=" + path;
+  argv.push_back(option.c_str());
+  // Leave a stale socket behind, the server must replace it.
+  {
+    boost::asio::io_context ioc;
+    boost::asio::local::stream_protocol::acceptor stale(
+        ioc, boost::asio::local::stream_protocol::endpoint(path));
+  }
+  ASSERT_TRUE(std::filesystem::is_socket(path));
+
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, hello);
+  EXPECT_EQ(port_f.get(), 0);
+
+  EXPECT_THAT(UnixSocketGet(path, {"/a", "/b"}),
+              ElementsAre("Hello World from /a", "Hello World from /b"));
+
+  shutdown.store(true);
+  try {
+    (void)UnixSocketGet(path, {"/quit/now"});
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+  // The server removes its socket.
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(FrameworkTest, UnixSocketThreads) {
+  CheckUnixSocket({"unused"});
+}
+
+TEST(FrameworkTest, UnixSocketAsync) {
+  CheckUnixSocket({"unused", "--session-engine=async", "--handler-threads=2"});
+}
+#endif  // BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+/// Sends SIGTERM while a request is in flight, the server must drain.
+void CheckDrain(std::vector<char const*> argv) {
+  namespace beast = boost::beast;
+  namespace http = beast::http;
+  using tcp = boost::asio::ip::tcp;
+
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::promise<void> started;
+  std::promise<void> release;
+  auto release_f = release.get_future().share();
+  auto slow = [&started, release_f](functions::HttpRequest const& r) {
+    if (r.target() == "/slow") {
+      started.set_value();
+      release_f.wait();
+    }
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)), [] { return false; },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, slow);
+  auto port = std::to_string(port_f.get());
+
+  boost::asio::io_context ioc;
+  tcp::resolver resolver(ioc);
+  beast::tcp_stream stream(ioc);
+  stream.connect(resolver.resolve("localhost", port));
+  auto send = [&](std::string const& target) {
+    auto constexpr kHttpVersion = 11;
+    TestRequest req{http::verb::get, target, kHttpVersion};
+    req.set(http::field::host, "localhost");
+    http::write(stream, req);
+    beast::flat_buffer buffer;
+    TestResponse res;
+    http::read(stream, buffer, res);
+    return res;
+  };
+  auto const fast = send("/fast");
+  EXPECT_EQ(fast.body(), "Hello World from /fast");
+  EXPECT_TRUE(fast.keep_alive());
+
+  auto pending = std::async(std::launch::async, send, "/slow");
+  started.get_future().get();
+  std::raise(SIGTERM);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // The server no longer accepts connections.
+  boost::asio::io_context client_ioc;
+  tcp::socket refused(client_ioc);
+  beast::error_code ec;
+  boost::asio::connect(refused, tcp::resolver(client_ioc).resolve(
+                                    "localhost", port),
+                       ec);
+  EXPECT_TRUE(ec);
+
+  // The request in flight completes, and the connection is closed.
+  release.set_value();
+  ASSERT_EQ(pending.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  auto const res = pending.get();
+  EXPECT_EQ(res.body(), "Hello World from /slow");
+  EXPECT_FALSE(res.keep_alive());
+  ASSERT_EQ(done.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_EQ(done.get(), 0);
+}
+
+TEST(FrameworkTest, DrainThreads) {
+  CheckDrain({"unused", "--port=0", "--drain-timeout=5"});
+}
+
+TEST(FrameworkTest, DrainAsync) {
+  CheckDrain({"unused", "--port=0", "--session-engine=async",
+              "--handler-threads=2", "--drain-timeout=5"});
+}
+
+/// Sends SIGTERM while a request is blocked past the drain deadline.
+void CheckDrainTimeout(std::vector<char const*> argv) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::promise<void> started;
+  std::promise<void> release;
+  auto release_f = release.get_future().share();
+  auto slow = [&started, release_f](functions::HttpRequest const& r) {
+    if (r.target() == "/slow") {
+      started.set_value();
+      release_f.wait();
+    }
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)), [] { return false; },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, slow);
+  auto port = std::to_string(port_f.get());
+
+  // The connection is closed without a response once the server stops.
+  auto pending = std::async(std::launch::async, [&port] {
+    try {
+      return HttpGet("localhost", port, "/slow");
+    } catch (...) {
+      return std::string{};
+    }
+  });
+  started.get_future().get();
+  std::raise(SIGTERM);
+
+  // The server waits for the function, even after the deadline.
+  EXPECT_EQ(done.wait_for(std::chrono::seconds(2)),
+            std::future_status::timeout);
+  release.set_value();
+  ASSERT_EQ(done.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_NE(done.get(), 0);
+  (void)pending.get();
+}
+
+TEST(FrameworkTest, DrainTimeoutThreads) {
+  CheckDrainTimeout({"unused", "--port=0", "--drain-timeout=1"});
+}
+
+TEST(FrameworkTest, DrainTimeoutAsync) {
+  CheckDrainTimeout({"unused", "--port=0", "--session-engine=async",
+                     "--handler-threads=2", "--drain-timeout=1"});
+}
+
+void RecordSignal(int signal) { signal_received = signal; }
+
+/// With `--handle-signals=false` the application handles SIGTERM.
+void CheckIgnoreSignals(std::vector<char const*> argv) {
+  signal_received = 0;
+  auto* const previous = std::signal(SIGTERM, RecordSignal);
+
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  auto hello = [](functions::HttpRequest const& r) {
+    return functions::HttpResponse{}.set_payload("Hello World from " +
+                                                 r.target());
+  };
+  auto run = [&](functions::UserHttpFunction f) {
+    return RunForTest(
+        static_cast<int>(argv.size()), argv.data(),
+        functions::MakeFunction(std::move(f)),
+        [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  };
+  auto done = std::async(std::launch::async, run, hello);
+  auto port = std::to_string(port_f.get());
+
+  std::raise(SIGTERM);
+  EXPECT_EQ(signal_received, SIGTERM);
+  EXPECT_EQ(HttpGet("localhost", port, "/after/signal"),
+            "Hello World from /after/signal");
+
+  shutdown.store(true);
+  try {
+    (void)HttpGet("localhost", port, "/quit/now");
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+  std::signal(SIGTERM, previous);
+}
+
+TEST(FrameworkTest, IgnoreSignalsThreads) {
+  CheckIgnoreSignals({"unused", "--port=0", "--handle-signals=false"});
+}
+
+TEST(FrameworkTest, IgnoreSignalsAsync) {
+  CheckIgnoreSignals({"unused", "--port=0", "--session-engine=async",
+                      "--handle-signals=false"});
+}
+
 TEST(FrameworkTest, HttpInvalidPort) {
   auto const exit_code = ::google::cloud::functions::Run(
       kTestInvalidArgc, kTestInvalidArgv, functions::UserHttpFunction{});
@@ -14,7 +14,10 @@
 
 #include "google/cloud/functions/internal/function_impl.h"
 #include "google/cloud/functions/internal/call_user_function.h"
+#include "google/cloud/functions/internal/wrap_request.h"
+#include "google/cloud/functions/internal/wrap_response.h"
 #include "google/cloud/functions/function.h"
+#include <utility>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -34,6 +37,40 @@ BaseFunctionImpl::BaseFunctionImpl(functions::UserHttpFunction function)
         return CallUserFunction(fun, std::move(request));
       }) {}
 
+BaseFunctionImpl::BaseFunctionImpl(functions::UserHttpViewFunction function)
+    : handler_([fun = std::move(function)](BeastRequest const& request) {
+        return CallUserFunction(fun, request);
+      }) {}
+
+BaseFunctionImpl::BaseFunctionImpl(
+    functions::UserHttpStreamingFunction function)
+    : streaming_handler_(
+          [fun = std::move(function)](BeastRequest request,
+                                      functions::HttpBodyReader reader) {
+            return CallUserFunction(fun, std::move(request), std::move(reader));
+          }) {
+  // Requests with a body already in memory are read from a string.
+  handler_ = [h = streaming_handler_](BeastRequest request) {
+    auto reader = MakeHttpBodyReader(std::exchange(request.body(), {}));
+    return h(std::move(request), std::move(reader));
+  };
+}
+
+BaseFunctionImpl::BaseFunctionImpl(functions::UserHttpWriterFunction function)
+    : writer_handler_(
+          [fun = std::move(function)](BeastRequest request,
+                                      functions::HttpResponseWriter writer) {
+            return CallUserFunction(fun, std::move(request), std::move(writer));
+          }) {
+  // The full response can also be collected in memory.
+  handler_ = [h = writer_handler_](BeastRequest request) {
+    BeastResponse response;
+    auto error = h(std::move(request), MakeBufferedResponseWriter(response));
+    if (error) return *std::move(error);
+    return response;
+  };
+}
+
 BaseFunctionImpl::BaseFunctionImpl(functions::UserCloudEventFunction function)
     : handler_([fun = std::move(function)](BeastRequest const& request) {
         return CallUserFunction(fun, request);
@@ -44,17 +81,73 @@ BaseFunctionImpl::BaseFunctionImpl(functions::UserCloudEventFunction function)
   return handler_;
 }
 
+[[nodiscard]] StreamingHandler BaseFunctionImpl::GetStreamingHandler(
+    std::string_view /*target*/) const {
+  return streaming_handler_;
+}
+
+[[nodiscard]] WriterHandler BaseFunctionImpl::GetWriterHandler(
+    std::string_view /*target*/) const {
+  return writer_handler_;
+}
+
 MapFunctionImpl::MapFunctionImpl(
     std::map<std::string, functions::Function> mapping)
     : mapping_(std::move(mapping)) {}
 
-[[nodiscard]] Handler MapFunctionImpl::GetHandler(
-    std::string_view target) const {
+FunctionImpl const& MapFunctionImpl::Find(std::string_view target) const {
   auto const l = mapping_.find(std::string(target));
   if (l == mapping_.end()) {
     throw std::runtime_error("Function not found " + std::string(target));
   }
-  return FunctionImpl::GetImpl(l->second)->GetHandler(target);
+  return *FunctionImpl::GetImpl(l->second);
+}
+
+[[nodiscard]] Handler MapFunctionImpl::GetHandler(
+    std::string_view target) const {
+  return Find(target).GetHandler(target);
+}
+
+[[nodiscard]] StreamingHandler MapFunctionImpl::GetStreamingHandler(
+    std::string_view target) const {
+  return Find(target).GetStreamingHandler(target);
+}
+
+[[nodiscard]] WriterHandler MapFunctionImpl::GetWriterHandler(
+    std::string_view target) const {
+  return Find(target).GetWriterHandler(target);
+}
+
+[[nodiscard]] PreBodyHook MapFunctionImpl::GetPreBodyHook(
+    std::string_view target) const {
+  return Find(target).GetPreBodyHook(target);
+}
+
+PreBodyHookFunctionImpl::PreBodyHookFunctionImpl(
+    functions::Function function, functions::UserPreBodyHook hook)
+    : impl_(FunctionImpl::GetImpl(function)),
+      hook_([fun = std::move(hook)](BeastRequest const& request) {
+        return CallPreBodyHook(fun, request);
+      }) {}
+
+[[nodiscard]] Handler PreBodyHookFunctionImpl::GetHandler(
+    std::string_view target) const {
+  return impl_->GetHandler(target);
+}
+
+[[nodiscard]] StreamingHandler PreBodyHookFunctionImpl::GetStreamingHandler(
+    std::string_view target) const {
+  return impl_->GetStreamingHandler(target);
+}
+
+[[nodiscard]] WriterHandler PreBodyHookFunctionImpl::GetWriterHandler(
+    std::string_view target) const {
+  return impl_->GetWriterHandler(target);
+}
+
+[[nodiscard]] PreBodyHook PreBodyHookFunctionImpl::GetPreBodyHook(
+    std::string_view /*target*/) const {
+  return hook_;
 }
 
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
@@ -19,6 +19,7 @@
 #include "google/cloud/functions/user_functions.h"
 #include "google/cloud/functions/version.h"
 #include <map>
+#include <optional>
 #include <string_view>
 
 namespace google::cloud::functions {
@@ -32,11 +33,69 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
 
 using Handler = std::function<BeastResponse(BeastRequest)>;
 
+/**
+ * Handles a request whose body is read incrementally.
+ *
+ * The request contains only the header, the body is read from the
+ * `HttpBodyReader`.
+ */
+using StreamingHandler =
+    std::function<BeastResponse(BeastRequest, functions::HttpBodyReader)>;
+
+/**
+ * Handles a request with a function that writes its response incrementally.
+ *
+ * Returns a response if the function did not write one, e.g., because it threw
+ * an exception before sending the response headers.
+ */
+using WriterHandler = std::function<std::optional<BeastResponse>(
+    BeastRequest, functions::HttpResponseWriter)>;
+
+/**
+ * Inspects a request header before the body is read.
+ *
+ * Returns a response to reject the request without reading its body.
+ */
+using PreBodyHook =
+    std::function<std::optional<BeastResponse>(BeastRequest const&)>;
+
 class FunctionImpl {
  public:
   virtual ~FunctionImpl() = default;
   [[nodiscard]] virtual Handler GetHandler(std::string_view target) const = 0;
 
+  /**
+   * The handler for functions that read the request body incrementally.
+   *
+   * Returns a null handler if the function expects the full request body in
+   * memory. Such functions are called via `GetHandler()`.
+   */
+  [[nodiscard]] virtual StreamingHandler GetStreamingHandler(
+      std::string_view /*target*/) const {
+    return {};
+  }
+
+  /**
+   * The handler for functions that write the response incrementally.
+   *
+   * Returns a null handler if the function returns a complete response. Such
+   * functions are called via `GetHandler()`.
+   */
+  [[nodiscard]] virtual WriterHandler GetWriterHandler(
+      std::string_view /*target*/) const {
+    return {};
+  }
+
+  /**
+   * The hook to inspect requests before reading their body.
+   *
+   * Returns a null hook if the function accepts all requests.
+   */
+  [[nodiscard]] virtual PreBodyHook GetPreBodyHook(
+      std::string_view /*target*/) const {
+    return {};
+  }
+
   static std::shared_ptr<FunctionImpl> GetImpl(functions::Function const& fun);
   static functions::Function MakeFunction(std::shared_ptr<FunctionImpl> impl);
 };
@@ -44,13 +103,22 @@ class FunctionImpl {
 class BaseFunctionImpl : public FunctionImpl {
  public:
   explicit BaseFunctionImpl(functions::UserHttpFunction function);
+  explicit BaseFunctionImpl(functions::UserHttpViewFunction function);
+  explicit BaseFunctionImpl(functions::UserHttpStreamingFunction function);
+  explicit BaseFunctionImpl(functions::UserHttpWriterFunction function);
   explicit BaseFunctionImpl(functions::UserCloudEventFunction function);
   ~BaseFunctionImpl() override = default;
 
   [[nodiscard]] Handler GetHandler(std::string_view /*target*/) const override;
+  [[nodiscard]] StreamingHandler GetStreamingHandler(
+      std::string_view /*target*/) const override;
+  [[nodiscard]] WriterHandler GetWriterHandler(
+      std::string_view /*target*/) const override;
 
  private:
   Handler handler_;
+  StreamingHandler streaming_handler_;
+  WriterHandler writer_handler_;
 };
 
 class MapFunctionImpl : public FunctionImpl {
@@ -59,11 +127,39 @@ class MapFunctionImpl : public FunctionImpl {
   ~MapFunctionImpl() override = default;
 
   [[nodiscard]] Handler GetHandler(std::string_view target) const override;
+  [[nodiscard]] StreamingHandler GetStreamingHandler(
+      std::string_view target) const override;
+  [[nodiscard]] WriterHandler GetWriterHandler(
+      std::string_view target) const override;
+  [[nodiscard]] PreBodyHook GetPreBodyHook(
+      std::string_view target) const override;
 
  private:
+  FunctionImpl const& Find(std::string_view target) const;
+
   std::map<std::string, functions::Function> mapping_;
 };
 
+/// Adds a `PreBodyHook` to a function, forwarding its handlers.
+class PreBodyHookFunctionImpl : public FunctionImpl {
+ public:
+  PreBodyHookFunctionImpl(functions::Function function,
+                          functions::UserPreBodyHook hook);
+  ~PreBodyHookFunctionImpl() override = default;
+
+  [[nodiscard]] Handler GetHandler(std::string_view target) const override;
+  [[nodiscard]] StreamingHandler GetStreamingHandler(
+      std::string_view target) const override;
+  [[nodiscard]] WriterHandler GetWriterHandler(
+      std::string_view target) const override;
+  [[nodiscard]] PreBodyHook GetPreBodyHook(
+      std::string_view /*target*/) const override;
+
+ private:
+  std::shared_ptr<FunctionImpl> impl_;
+  PreBodyHook hook_;
+};
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
 
@@ -21,6 +21,7 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 namespace http = ::boost::beast::http;
 
 auto SimpleHttp(functions::HttpRequest const& request) {
@@ -76,6 +77,60 @@ TEST(FunctionImpl, HttpThrow) {
   EXPECT_EQ(response.result(), http::status::internal_server_error);
 }
 
+TEST(FunctionImpl, HttpStreaming) {
+  auto func = [](functions::HttpRequest const& request,
+                 functions::HttpBodyReader reader) {
+    EXPECT_THAT(request.payload(), IsEmpty());
+    std::string body(64, '\0');
+    body.resize(reader.Read(body.data(), body.size()));
+    return functions::HttpResponse{}.set_payload(body + " " +
+                                                 request.target());
+  };
+  auto function =
+      functions::MakeFunction(functions::UserHttpStreamingFunction(func));
+  auto const impl = FunctionImpl::GetImpl(function);
+  ASSERT_TRUE(impl->GetStreamingHandler("unused"));
+  // Requests with a buffered body are also supported.
+  BeastRequest request;
+  request.target("/test-target");
+  request.body() = "Hello";
+  auto response = impl->GetHandler("unused")(request);
+  EXPECT_EQ(response.result(), http::status::ok);
+  EXPECT_EQ(response.body(), "Hello /test-target");
+}
+
+TEST(FunctionImpl, HttpWriter) {
+  auto func = [](functions::HttpRequest const& request,
+                 functions::HttpResponseWriter writer) {
+    if (request.target() == "/throw") throw std::runtime_error("testing");
+    writer.set_header("x-test-header", "value");
+    writer.Write("Hello ");
+    writer.Write(request.target());
+  };
+  auto function =
+      functions::MakeFunction(functions::UserHttpWriterFunction(func));
+  auto const impl = FunctionImpl::GetImpl(function);
+  ASSERT_TRUE(impl->GetWriterHandler("unused"));
+  EXPECT_FALSE(impl->GetStreamingHandler("unused"));
+  // The response can also be collected in memory.
+  BeastRequest request;
+  request.target("/test-target");
+  auto response = impl->GetHandler("unused")(request);
+  EXPECT_EQ(response.result(), http::status::ok);
+  EXPECT_EQ(response["x-test-header"], "value");
+  EXPECT_EQ(response.body(), "Hello /test-target");
+
+  request.target("/throw");
+  response = impl->GetHandler("unused")(request);
+  EXPECT_EQ(response.result(), http::status::internal_server_error);
+}
+
+TEST(FunctionImpl, HttpNotStreaming) {
+  auto function = functions::MakeFunction(SimpleHttp);
+  EXPECT_FALSE(FunctionImpl::GetImpl(function)->GetStreamingHandler("unused"));
+  EXPECT_FALSE(FunctionImpl::GetImpl(function)->GetWriterHandler("unused"));
+}
+
 TEST(FunctionImpl, CloudEventNormal) {
   auto func = [](functions::CloudEvent const& event) {
     EXPECT_EQ(event.id(), "A234-1234-1234");
@@ -139,6 +194,54 @@ TEST(FunctionImpl, MapInvalidName) {
                std::exception);
 }
 
+TEST(FunctionImpl, PreBodyHook) {
+  auto function = functions::WithPreBodyHook(
+      functions::MakeFunction(SimpleHttp),
+      [](functions::HttpRequest const& request)
+          -> std::optional<functions::HttpResponse> {
+        if (request.target() == "/throw") throw std::runtime_error("testing");
+        if (request.target() == "/accept") return std::nullopt;
+        return functions::HttpResponse{}.set_result(
+            functions::HttpResponse::kUnauthorized);
+      });
+  auto const impl = FunctionImpl::GetImpl(function);
+  auto hook = impl->GetPreBodyHook("unused");
+  ASSERT_TRUE(hook);
+  BeastRequest request;
+  request.target("/accept");
+  EXPECT_FALSE(hook(request).has_value());
+
+  request.target("/reject");
+  auto response = hook(request);
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->result(), http::status::unauthorized);
+
+  request.target("/throw");
+  response = hook(request);
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->result(), http::status::internal_server_error);
+
+  // The handlers are forwarded to the wrapped function.
+  request.target("/test-target");
+  auto const forwarded = impl->GetHandler("unused")(request);
+  EXPECT_THAT(forwarded.body(), HasSubstr(":target: /test-target"));
+  EXPECT_FALSE(impl->GetStreamingHandler("unused"));
+}
+
+TEST(FunctionImpl, PreBodyHookMap) {
+  auto function = functions::MakeFunction({
+      {"a", functions::MakeFunction(SimpleHttp)},
+      {"b", functions::WithPreBodyHook(
+                functions::MakeFunction(SimpleHttp),
+                [](functions::HttpRequest const& /*request*/) {
+                  return std::optional<functions::HttpResponse>{};
+                })},
+  });
+  auto const impl = FunctionImpl::GetImpl(function);
+  EXPECT_FALSE(impl->GetPreBodyHook("a"));
+  EXPECT_TRUE(impl->GetPreBodyHook("b"));
+}
+
 }  // namespace
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
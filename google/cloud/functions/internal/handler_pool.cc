@@ -0,0 +1,73 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/handler_pool.h"
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+HandlerPool::HandlerPool(int threads, std::size_t queue_size)
+    : capacity_(static_cast<std::size_t>(threads) + queue_size),
+      threads_(threads) {
+  for (auto& t : threads_) t = std::thread([this] { Worker(); });
+}
+
+HandlerPool::~HandlerPool() { Shutdown(); }
+
+bool HandlerPool::TrySubmit(std::function<void()> task) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (shutdown_ || pending_ >= capacity_) return false;
+  ++pending_;
+  queue_.push_back(std::move(task));
+  lk.unlock();
+  cv_.notify_one();
+  return true;
+}
+
+void HandlerPool::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& t : threads_) {
+    if (t.joinable()) t.join();
+  }
+}
+
+void HandlerPool::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !queue_.empty(); });
+    if (queue_.empty()) return;
+    auto task = std::move(queue_.front());
+    queue_.pop_front();
+    lk.unlock();
+    task();
+    lk.lock();
+    --pending_;
+  }
+}
+
+BeastResponse MakeOverloadedResponse(boost::beast::http::status status) {
+  BeastResponse response;
+  response.result(status);
+  response.set(boost::beast::http::field::retry_after, "1");
+  response.set(boost::beast::http::field::content_type, "text/plain");
+  response.body() = "server overloaded, try again later\n";
+  return response;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
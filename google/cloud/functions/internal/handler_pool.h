@@ -0,0 +1,73 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HANDLER_POOL_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HANDLER_POOL_H
+
+#include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/version.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A fixed-size thread pool to run user functions.
+ *
+ * The pool accepts at most `threads + queue_size` tasks, that is, each thread
+ * may be running a task and up to `queue_size` tasks may be waiting for a
+ * thread. Further tasks are rejected, the caller is expected to shed the
+ * request quickly instead of queueing unbounded work.
+ */
+class HandlerPool {
+ public:
+  HandlerPool(int threads, std::size_t queue_size);
+  ~HandlerPool();
+
+  HandlerPool(HandlerPool const&) = delete;
+  HandlerPool& operator=(HandlerPool const&) = delete;
+
+  /// Schedules @p task, returns `false` if the pool is full or shut down.
+  [[nodiscard]] bool TrySubmit(std::function<void()> task);
+
+  /// Stops accepting work and waits for the queued tasks to complete.
+  void Shutdown();
+
+ private:
+  void Worker();
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> queue_;
+  std::size_t capacity_;
+  std::size_t pending_ = 0;
+  bool shutdown_ = false;
+  std::vector<std::thread> threads_;
+};
+
+/// The response sent when the server has no capacity to handle a request.
+BeastResponse MakeOverloadedResponse(
+    boost::beast::http::status status =
+        boost::beast::http::status::service_unavailable);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HANDLER_POOL_H
@@ -0,0 +1,72 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/handler_pool.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <future>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = ::boost::beast::http;
+
+TEST(HandlerPoolTest, RunsTasks) {
+  HandlerPool pool(2, 4);
+  std::promise<int> p;
+  ASSERT_TRUE(pool.TrySubmit([&p] { p.set_value(42); }));
+  EXPECT_EQ(p.get_future().get(), 42);
+}
+
+TEST(HandlerPoolTest, RejectsWhenFull) {
+  HandlerPool pool(1, 1);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  // The first task occupies the only thread, the second waits in the queue.
+  ASSERT_TRUE(pool.TrySubmit([&started, released] {
+    started.set_value();
+    released.wait();
+  }));
+  started.get_future().wait();
+  ASSERT_TRUE(pool.TrySubmit([released] { released.wait(); }));
+  EXPECT_FALSE(pool.TrySubmit([] {}));
+
+  release.set_value();
+  pool.Shutdown();
+  EXPECT_FALSE(pool.TrySubmit([] {}));
+}
+
+TEST(HandlerPoolTest, ShutdownDrainsQueue) {
+  std::atomic<int> count{0};
+  {
+    HandlerPool pool(1, 8);
+    for (int i = 0; i != 8; ++i) {
+      (void)pool.TrySubmit([&count] { ++count; });
+    }
+    pool.Shutdown();
+  }
+  EXPECT_EQ(count.load(), 8);
+}
+
+TEST(HandlerPoolTest, OverloadedResponse) {
+  auto const response = MakeOverloadedResponse();
+  EXPECT_EQ(response.result(), http::status::service_unavailable);
+  EXPECT_EQ(response[http::field::retry_after], "1");
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,620 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/http2_session.h"
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+#include <nghttp2/nghttp2.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+namespace be = boost::beast;
+namespace asio = boost::asio;
+
+// The size of each read from the connection.
+auto constexpr kReadSize = 16 * 1024;
+
+// The maximum number of concurrent streams advertised to the client.
+std::uint32_t constexpr kMaxConcurrentStreams = 100;
+
+// RFC 7540 section 6.5.2, each header field adds 32 bytes to the header list.
+std::uint64_t constexpr kHeaderFieldOverhead = 32;
+
+std::string_view ToStringView(std::uint8_t const* data, std::size_t size) {
+  return {reinterpret_cast<char const*>(data), size};
+}
+
+nghttp2_nv MakeNv(std::string const& name, std::string const& value) {
+  // nghttp2 copies the names and values when the response is submitted.
+  return nghttp2_nv{
+      reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+      reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())),
+      name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+// Connection-specific fields are not allowed in HTTP/2, RFC 7540 8.1.2.2.
+bool IsConnectionField(std::string_view name) {
+  for (auto const f :
+       {"connection", "keep-alive", "proxy-connection", "transfer-encoding",
+        "upgrade", "http2-settings"}) {
+    if (name == f) return true;
+  }
+  return false;
+}
+
+std::string ToLower(std::string_view s) {
+  std::string lower(s);
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return lower;
+}
+
+}  // namespace
+
+/// The nghttp2 callbacks, `user_data` is the `Http2Session`.
+struct Http2Session::Callbacks {
+  static Http2Session& Self(void* user_data) {
+    return *static_cast<Http2Session*>(user_data);
+  }
+
+  static int OnBeginHeaders(nghttp2_session* /*session*/,
+                            nghttp2_frame const* frame, void* user_data) {
+    if (frame->hd.type != NGHTTP2_HEADERS ||
+        frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+      return 0;
+    }
+    (void)Self(user_data).NewStream(frame->hd.stream_id);
+    return 0;
+  }
+
+  static int OnHeader(nghttp2_session* /*session*/, nghttp2_frame const* frame,
+                      std::uint8_t const* name, std::size_t namelen,
+                      std::uint8_t const* value, std::size_t valuelen,
+                      std::uint8_t /*flags*/, void* user_data) {
+    auto& self = Self(user_data);
+    auto* stream = self.Find(frame->hd.stream_id);
+    if (stream == nullptr || stream->error) return 0;
+    stream->header_bytes += namelen + valuelen + kHeaderFieldOverhead;
+    auto const limit = self.context_.config.max_header_bytes;
+    if (limit != 0 && stream->header_bytes > limit) {
+      stream->error = be::http::status::request_header_fields_too_large;
+      return 0;
+    }
+    auto const n = ToStringView(name, namelen);
+    auto const v = ToStringView(value, valuelen);
+    auto& request = stream->request;
+    if (n == ":method") {
+      request.method_string(v);
+    } else if (n == ":path") {
+      request.target(v);
+    } else if (n == ":authority") {
+      request.set(be::http::field::host, v);
+    } else if (n.empty() || n.front() == ':') {
+      // Ignore `:scheme` and any other pseudo-header fields.
+    } else if (n == "cookie" && request.count(be::http::field::cookie) != 0) {
+      // HTTP/2 clients may split the cookies, RFC 7540 8.1.2.5.
+      auto joined = std::string(request[be::http::field::cookie]);
+      joined += "; ";
+      joined.append(v.data(), v.size());
+      request.set(be::http::field::cookie, joined);
+    } else {
+      request.insert(n, v);
+    }
+    return 0;
+  }
+
+  static int OnDataChunk(nghttp2_session* /*session*/, std::uint8_t /*flags*/,
+                         std::int32_t stream_id, std::uint8_t const* data,
+                         std::size_t len, void* user_data) {
+    auto& self = Self(user_data);
+    auto* stream = self.Find(stream_id);
+    if (stream == nullptr || stream->error || stream->rejection) return 0;
+    auto& body = stream->request.body();
+    auto const limit = self.context_.config.max_body_bytes;
+    if (limit != 0 && body.size() + len > limit) {
+      // Discard the rest of the body, nghttp2 still updates the flow control
+      // windows.
+      stream->error = be::http::status::payload_too_large;
+      body = {};
+      return 0;
+    }
+    body.append(reinterpret_cast<char const*>(data), len);
+    return 0;
+  }
+
+  static int OnFrameRecv(nghttp2_session* /*session*/,
+                         nghttp2_frame const* frame, void* user_data) {
+    if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+      return 0;
+    }
+    auto& self = Self(user_data);
+    auto* stream = self.Find(frame->hd.stream_id);
+    if (stream == nullptr || stream->rejection) return 0;
+    auto const request = frame->hd.type == NGHTTP2_HEADERS &&
+                         frame->headers.cat == NGHTTP2_HCAT_REQUEST;
+    if (request) {
+      stream->read_deadline =
+          self.Deadline(self.context_.config.body_read_timeout);
+    }
+    if (request && !stream->error && self.context_.pre_body_hook) {
+      // Respond before the body arrives. nghttp2 resets the stream once the
+      // response is sent, which stops the client from sending the body.
+      stream->rejection = self.context_.pre_body_hook(stream->request);
+      if (stream->rejection) {
+        stream->read_deadline = Clock::time_point::max();
+        self.pending_.push_back(frame->hd.stream_id);
+        return 0;
+      }
+    }
+    if ((frame->hd.flags & NGHTTP2_FLAG_END_STREAM) == 0) return 0;
+    stream->read_deadline = Clock::time_point::max();
+    self.pending_.push_back(frame->hd.stream_id);
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session* /*session*/,
+                           std::int32_t stream_id, std::uint32_t /*error_code*/,
+                           void* user_data) {
+    Self(user_data).streams_.erase(stream_id);
+    return 0;
+  }
+
+  static ssize_t ReadBody(nghttp2_session* /*session*/, std::int32_t stream_id,
+                          std::uint8_t* buf, std::size_t length,
+                          std::uint32_t* data_flags,
+                          nghttp2_data_source* /*source*/, void* user_data) {
+    auto* stream = Self(user_data).Find(stream_id);
+    if (stream == nullptr) return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+    auto const& body = stream->response.body();
+    auto const n = std::min(length, body.size() - stream->offset);
+    std::memcpy(buf, body.data() + stream->offset, n);
+    stream->offset += n;
+    if (stream->offset == body.size()) *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    return static_cast<ssize_t>(n);
+  }
+};
+
+Http2Session::Http2Session(SessionStream stream, be::flat_buffer buffer,
+                           SessionContext const& context,
+                           SessionRegistry* registry)
+    : stream_(std::move(stream)),
+      buffer_(std::move(buffer)),
+      context_(context),
+      registry_(registry),
+      read_timer_(stream_.get_executor()) {}
+
+Http2Session::~Http2Session() {
+  if (session_ != nullptr) nghttp2_session_del(session_);
+  // The context may be gone once the registry is released.
+  streams_.clear();
+  if (registry_ != nullptr) registry_->Release();
+}
+
+void Http2Session::Start() {
+  Init();
+  Receive();
+  DoWrite();
+  DoRead();
+}
+
+void Http2Session::StartUpgrade(BeastRequest request,
+                                std::string const& settings) {
+  Init();
+  auto const head = request.method() == be::http::verb::head;
+  auto const rv = nghttp2_session_upgrade2(
+      session_, reinterpret_cast<std::uint8_t const*>(settings.data()),
+      settings.size(), head ? 1 : 0, nullptr);
+  if (rv != 0) {
+    throw std::invalid_argument(std::string("invalid HTTP2-Settings: ") +
+                                nghttp2_strerror(rv));
+  }
+  output_ =
+      "HTTP/1.1 101 Switching Protocols\r\n"
+      "Connection: Upgrade\r\n"
+      "Upgrade: h2c\r\n\r\n";
+  // The upgrade request is stream 1, it is already half-closed.
+  for (auto const f : {be::http::field::connection, be::http::field::upgrade}) {
+    request.erase(f);
+  }
+  request.erase("HTTP2-Settings");
+  if (auto* stream = NewStream(1)) {
+    stream->request = std::move(request);
+    stream->read_deadline = Clock::time_point::max();
+    pending_.push_back(1);
+  }
+  // Any data after the request is the client preface.
+  Receive();
+  DoWrite();
+  DoRead();
+}
+
+void Http2Session::Init() {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  nghttp2_session_callbacks_new(&callbacks);
+  nghttp2_session_callbacks_set_on_begin_headers_callback(
+      callbacks, &Callbacks::OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks,
+                                                   &Callbacks::OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+      callbacks, &Callbacks::OnDataChunk);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(
+      callbacks, &Callbacks::OnFrameRecv);
+  nghttp2_session_callbacks_set_on_stream_close_callback(
+      callbacks, &Callbacks::OnStreamClose);
+  auto const rv = nghttp2_session_server_new(&session_, callbacks, this);
+  nghttp2_session_callbacks_del(callbacks);
+  if (rv != 0) {
+    throw std::runtime_error(std::string("cannot create HTTP/2 session: ") +
+                             nghttp2_strerror(rv));
+  }
+
+  std::array<nghttp2_settings_entry, 2> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, kMaxConcurrentStreams},
+      {NGHTTP2_SETTINGS_MAX_HEADER_LIST_SIZE,
+       context_.config.max_header_bytes},
+  }};
+  // The header list size is unlimited by default.
+  auto const count = context_.config.max_header_bytes == 0 ? 1 : 2;
+  nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, settings.data(), count);
+}
+
+void Http2Session::DoRead() {
+  if (read_closed_ || closed_) return;
+  UpdateReadDeadline();
+  if (reading_) return;
+  if (nghttp2_session_want_read(session_) == 0) return MaybeClose();
+  reading_ = true;
+  // The read deadlines are enforced by `read_timer_`.
+  ExpiresAfter(std::chrono::seconds(0));
+  stream_.async_read_some(
+      buffer_.prepare(kReadSize),
+      be::bind_front_handler(&Http2Session::OnRead, shared_from_this()));
+}
+
+void Http2Session::OnRead(be::error_code ec, std::size_t bytes_transferred) {
+  reading_ = false;
+  if (ec) {
+    if (ec != asio::error::eof && !closed_) OnError(ec, "read");
+    read_closed_ = true;
+    return MaybeClose();
+  }
+  buffer_.commit(bytes_transferred);
+  Receive();
+  DoWrite();
+  DoRead();
+}
+
+void Http2Session::Receive() {
+  auto const data = buffer_.data();
+  if (data.size() == 0) return;
+  auto const rv = nghttp2_session_mem_recv(
+      session_, static_cast<std::uint8_t const*>(data.data()), data.size());
+  buffer_.consume(buffer_.size());
+  if (rv < 0) {
+    // nghttp2 queues a GOAWAY frame for most protocol errors, send it and then
+    // close the connection.
+    read_closed_ = true;
+    pending_.clear();
+    return;
+  }
+  RunPending();
+}
+
+void Http2Session::RunPending() {
+  auto pending = std::move(pending_);
+  pending_.clear();
+  for (auto const id : pending) {
+    auto* stream = Find(id);
+    if (stream == nullptr) continue;
+    context_.stats->requests.fetch_add(1, std::memory_order_relaxed);
+    if (stream->error) {
+      SubmitResponse(id, MakeErrorResponse(*stream->error));
+      continue;
+    }
+    if (stream->rejection) {
+      SubmitResponse(id, *stream->rejection);
+      continue;
+    }
+    AdmitStream(id, *stream);
+  }
+}
+
+void Http2Session::AdmitStream(std::int32_t stream_id, Stream& stream) {
+  if (context_.limiter == nullptr) {
+    return RunHandler(stream_id, std::move(stream.request), {});
+  }
+  // Queued streams resume in the session executor, see
+  // `HttpSession::AdmitRequests()`. The client may reset the stream while it
+  // waits, in which case the permit is released immediately.
+  auto executor = asio::prefer(stream_.get_executor(),
+                               asio::execution::outstanding_work.tracked);
+  RequestLimiter::Permit permit;
+  auto const admission = context_.limiter->Admit(
+      permit, [self = shared_from_this(), executor = std::move(executor),
+               stream_id](RequestLimiter::Permit p) {
+        asio::post(executor, [self, stream_id, p = std::move(p)]() mutable {
+          --self->running_;
+          auto* s = self->Find(stream_id);
+          if (s != nullptr && !self->closed_) {
+            // An empty permit rejects the stream, see `RequestLimiter`.
+            if (!p) {
+              self->RejectStream(stream_id);
+            } else {
+              self->RunHandler(stream_id, std::move(s->request), std::move(p));
+            }
+          }
+          self->DoWrite();
+        });
+      });
+  switch (admission) {
+    case RequestLimiter::Admission::kAdmitted:
+      return RunHandler(stream_id, std::move(stream.request),
+                        std::move(permit));
+    case RequestLimiter::Admission::kQueued:
+      ++running_;
+      return;
+    case RequestLimiter::Admission::kRejected:
+      break;
+  }
+  RejectStream(stream_id);
+}
+
+void Http2Session::RunHandler(std::int32_t stream_id, BeastRequest request,
+                              RequestLimiter::Permit permit) {
+  if (context_.pool == nullptr) {
+    auto response = context_.handler(std::move(request));
+    FlushOutput();
+    permit = {};
+    return SubmitResponse(stream_id, std::move(response));
+  }
+  // Run the function in the handler pool, and resume in the session executor
+  // once it completes. See `HttpSession::DispatchRequests()`. The pool tasks
+  // must be copyable, so the permit is shared with the task.
+  auto executor = asio::prefer(stream_.get_executor(),
+                               asio::execution::outstanding_work.tracked);
+  auto shared_permit =
+      std::make_shared<RequestLimiter::Permit>(std::move(permit));
+  auto submitted = context_.pool->TrySubmit(
+      [self = shared_from_this(), executor = std::move(executor), stream_id,
+       request = std::move(request), shared_permit]() mutable {
+        auto response = self->context_.handler(std::move(request));
+        self->FlushOutput();
+        *shared_permit = {};
+        asio::post(executor, [self, stream_id,
+                              response = std::move(response)]() mutable {
+          --self->running_;
+          self->SubmitResponse(stream_id, std::move(response));
+          self->DoWrite();
+        });
+      });
+  if (submitted) {
+    ++running_;
+    return;
+  }
+  *shared_permit = {};
+  RejectStream(stream_id);
+}
+
+void Http2Session::RejectStream(std::int32_t stream_id) {
+  context_.stats->requests_rejected.fetch_add(1, std::memory_order_relaxed);
+  SubmitResponse(stream_id,
+                 MakeOverloadedResponse(static_cast<be::http::status>(
+                     context_.config.overload_status)));
+}
+
+void Http2Session::SubmitResponse(std::int32_t stream_id,
+                                  BeastResponse response) {
+  // The client may have reset the stream while the function was running.
+  auto* stream = Find(stream_id);
+  if (stream == nullptr || closed_) return;
+
+  std::vector<std::string> fields;
+  auto add = [&fields](std::string name, std::string value) {
+    fields.push_back(std::move(name));
+    fields.push_back(std::move(value));
+  };
+  add(":status", std::to_string(response.result_int()));
+  // The static headers replace any fields with the same name.
+  if (context_.static_headers != nullptr) {
+    context_.static_headers->EraseFrom(response);
+  }
+  for (auto const& f : response) {
+    auto name = ToLower(f.name_string());
+    // The framework sets the `Server` header via the static headers.
+    if (IsConnectionField(name) || name == "server") continue;
+    if (name == "content-length") continue;
+    add(std::move(name), std::string(f.value()));
+  }
+  if (context_.static_headers != nullptr) {
+    std::string block;
+    context_.static_headers->AppendTo(block);
+    std::string_view lines = block;
+    while (!lines.empty()) {
+      auto const eol = lines.find("\r\n");
+      auto const line = lines.substr(0, eol);
+      auto const colon = line.find(':');
+      auto value = line.substr(colon + 1);
+      while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+      add(ToLower(line.substr(0, colon)), std::string(value));
+      lines.remove_prefix(std::min(lines.size(), eol + 2));
+    }
+  }
+  add("content-length", std::to_string(response.body().size()));
+
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(fields.size() / 2);
+  for (std::size_t i = 0; i + 1 < fields.size(); i += 2) {
+    nva.push_back(MakeNv(fields[i], fields[i + 1]));
+  }
+
+  stream->response = std::move(response);
+  stream->offset = 0;
+  nghttp2_data_provider provider{};
+  provider.read_callback = &Callbacks::ReadBody;
+  auto const empty = stream->response.body().empty();
+  nghttp2_submit_response(session_, stream_id, nva.data(), nva.size(),
+                          empty ? nullptr : &provider);
+}
+
+void Http2Session::FlushOutput() {
+  // See `HttpSession::FlushOutput()`, this must run in the function thread.
+  if (context_.output != nullptr) context_.output->Flush();
+}
+
+void Http2Session::DoWrite() {
+  if (!writing_.empty() || closed_) return;
+  if (!goaway_sent_ && context_.drain != nullptr &&
+      context_.drain->draining()) {
+    // The client can retry any streams after the last one received.
+    goaway_sent_ = true;
+    nghttp2_submit_goaway(session_, NGHTTP2_FLAG_NONE,
+                          nghttp2_session_get_last_proc_stream_id(session_),
+                          NGHTTP2_NO_ERROR, nullptr, 0);
+  }
+  for (;;) {
+    std::uint8_t const* data = nullptr;
+    auto const n = nghttp2_session_mem_send(session_, &data);
+    if (n < 0) {
+      read_closed_ = true;
+      break;
+    }
+    if (n == 0) break;
+    output_.append(reinterpret_cast<char const*>(data),
+                   static_cast<std::size_t>(n));
+  }
+  if (output_.empty()) return MaybeClose();
+  writing_.swap(output_);
+  output_.clear();
+  ExpiresAfter(context_.config.write_timeout);
+  asio::async_write(
+      stream_, asio::buffer(writing_),
+      be::bind_front_handler(&Http2Session::OnWrite, shared_from_this()));
+}
+
+void Http2Session::OnWrite(be::error_code ec,
+                           std::size_t /*bytes_transferred*/) {
+  writing_.clear();
+  if (ec) {
+    if (!closed_) OnError(ec, "write");
+    read_closed_ = true;
+    closed_ = true;
+    return;
+  }
+  DoWrite();
+  DoRead();
+}
+
+void Http2Session::MaybeClose() {
+  if (closed_ || !writing_.empty() || running_ != 0) return;
+  auto const done = nghttp2_session_want_read(session_) == 0 &&
+                    nghttp2_session_want_write(session_) == 0;
+  if (!read_closed_ && !done) return;
+  closed_ = true;
+  read_timer_.cancel();
+  be::error_code ec;
+  stream_.socket().shutdown(asio::socket_base::shutdown_both, ec);
+  stream_.socket().close(ec);
+}
+
+void Http2Session::OnError(be::error_code ec, char const* what) {
+  if (ec == be::error::timeout) {
+    // The stream closes the socket when the deadline expires.
+    context_.stats->sessions_timed_out.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // TODO(#35) - maybe replace with Boost.Log
+  std::cerr << "h2c " << what << ": " << ec.message() << "\n";
+}
+
+void Http2Session::ExpiresAfter(std::chrono::seconds timeout) {
+  // The stream has separate deadlines for reads and writes, this sets the
+  // deadline for the operation about to start.
+  if (timeout.count() == 0) return stream_.expires_never();
+  stream_.expires_after(timeout);
+}
+
+Http2Session::Clock::time_point Http2Session::Deadline(
+    std::chrono::seconds timeout) const {
+  if (timeout.count() == 0) return Clock::time_point::max();
+  return Clock::now() + timeout;
+}
+
+void Http2Session::UpdateReadDeadline() {
+  // The idle deadline starts when the last stream closes.
+  if (!streams_.empty()) {
+    idle_deadline_ = Clock::time_point::max();
+  } else if (idle_deadline_ == Clock::time_point::max()) {
+    idle_deadline_ = Deadline(context_.config.idle_timeout);
+  }
+  auto deadline = idle_deadline_;
+  for (auto const& [id, stream] : streams_) {
+    deadline = std::min(deadline, stream.read_deadline);
+  }
+  if (deadline == read_deadline_) return;
+  read_deadline_ = deadline;
+  // Any pending wait completes with `operation_aborted`.
+  if (deadline == Clock::time_point::max()) {
+    read_timer_.cancel();
+    return;
+  }
+  read_timer_.expires_at(deadline);
+  read_timer_.async_wait([w = weak_from_this()](be::error_code ec) {
+    if (auto self = w.lock()) self->OnReadDeadline(ec);
+  });
+}
+
+void Http2Session::OnReadDeadline(be::error_code ec) {
+  if (ec == asio::error::operation_aborted || closed_) return;
+  // The handler may run after the deadline changed.
+  if (Clock::now() < read_deadline_) return;
+  context_.stats->sessions_timed_out.fetch_add(1, std::memory_order_relaxed);
+  read_closed_ = true;
+  closed_ = true;
+  stream_.socket().shutdown(asio::socket_base::shutdown_both, ec);
+  stream_.socket().close(ec);
+}
+
+Http2Session::Stream* Http2Session::NewStream(std::int32_t stream_id) {
+  DrainController::InFlight in_flight;
+  if (context_.drain != nullptr) {
+    in_flight = context_.drain->Track();
+    if (!in_flight) {
+      // The drain completed, the client can retry the request elsewhere.
+      nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                                NGHTTP2_REFUSED_STREAM);
+      return nullptr;
+    }
+  }
+  auto& stream = streams_[stream_id];
+  stream.request.version(11);
+  stream.read_deadline = Deadline(context_.config.header_read_timeout);
+  stream.in_flight = std::move(in_flight);
+  return &stream;
+}
+
+Http2Session::Stream* Http2Session::Find(std::int32_t stream_id) {
+  auto i = streams_.find(stream_id);
+  return i == streams_.end() ? nullptr : &i->second;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,172 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HTTP2_SESSION_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HTTP2_SESSION_H
+
+#include "google/cloud/functions/internal/drain_controller.h"
+#include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/internal/http_session.h"
+#include "google/cloud/functions/internal/request_limiter.h"
+#include "google/cloud/functions/version.h"
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Avoid exposing the nghttp2 headers to the rest of the library.
+struct nghttp2_session;
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/// The client connection preface, sent by HTTP/2 clients with prior knowledge.
+inline constexpr std::string_view kHttp2Preface =
+    "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+/**
+ * Serves the HTTP/2 streams received over a single cleartext (h2c) connection.
+ *
+ * `HttpSession` hands over the connection once it detects the HTTP/2 client
+ * preface, or after a request with `Upgrade: h2c`. The framing, flow control,
+ * and HPACK header compression are implemented by nghttp2, this class moves
+ * bytes between nghttp2 and the socket, and maps each stream to a
+ * `BeastRequest` and its `BeastResponse`.
+ *
+ * Each stream is dispatched to `SessionContext::handler`, functions that read
+ * the body or write the response incrementally are served by their buffered
+ * fallback. Without a `SessionContext::pool` the streams run one at a time, in
+ * the session executor. With a pool the streams run concurrently, and the
+ * session keeps reading and writing other streams in the meantime.
+ *
+ * Once the server starts draining the session sends a `GOAWAY` frame, completes
+ * the streams already received, and then closes the connection.
+ *
+ * The connection deadlines in `ServerConfig` apply to each stream: the header
+ * deadline starts when the stream opens, and the body deadline when its header
+ * block is complete. The connection is idle while it has no open streams. The
+ * session closes the connection if any of these deadlines expires.
+ *
+ * Like `HttpSession`, all the operations run in the executor associated with
+ * the socket, and the session keeps itself alive by capturing
+ * `shared_from_this()` in each completion handler.
+ */
+class Http2Session : public std::enable_shared_from_this<Http2Session> {
+ public:
+  /**
+   * Creates a session over @p stream.
+   *
+   * @param buffer any data already read from the connection.
+   * @param registry if not null, the session releases its slot once the
+   *     connection is closed.
+   */
+  Http2Session(SessionStream stream, boost::beast::flat_buffer buffer,
+               SessionContext const& context, SessionRegistry* registry);
+  ~Http2Session();
+
+  Http2Session(Http2Session const&) = delete;
+  Http2Session& operator=(Http2Session const&) = delete;
+
+  /// Starts a session with prior knowledge, the buffer starts with the client
+  /// preface.
+  void Start();
+
+  /**
+   * Starts a session upgraded from HTTP/1.1.
+   *
+   * Sends the `101 Switching Protocols` response, and then serves @p request
+   * as stream 1.
+   *
+   * @param settings the decoded `HTTP2-Settings` header.
+   */
+  void StartUpgrade(BeastRequest request, std::string const& settings);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stream {
+    BeastRequest request;
+    // The stream must be fully received by this time.
+    Clock::time_point read_deadline = Clock::time_point::max();
+    // The header list size, as defined for `SETTINGS_MAX_HEADER_LIST_SIZE`.
+    std::uint64_t header_bytes = 0;
+    // If set, the stream exceeded a limit and receives this status.
+    std::optional<boost::beast::http::status> error;
+    // If set, the `pre_body_hook` rejected the request with this response.
+    std::optional<BeastResponse> rejection;
+    // The response body is sent from here, see `Callbacks::ReadBody()`.
+    BeastResponse response;
+    std::size_t offset = 0;
+    DrainController::InFlight in_flight;
+  };
+  struct Callbacks;
+
+  void Init();
+  void DoRead();
+  void OnRead(boost::beast::error_code ec, std::size_t bytes_transferred);
+  void Receive();
+  void RunPending();
+  void AdmitStream(std::int32_t stream_id, Stream& stream);
+  void RunHandler(std::int32_t stream_id, BeastRequest request,
+                  RequestLimiter::Permit permit);
+  void RejectStream(std::int32_t stream_id);
+  void SubmitResponse(std::int32_t stream_id, BeastResponse response);
+  void FlushOutput();
+  void DoWrite();
+  void OnWrite(boost::beast::error_code ec, std::size_t bytes_transferred);
+  void MaybeClose();
+  void OnError(boost::beast::error_code ec, char const* what);
+  void ExpiresAfter(std::chrono::seconds timeout);
+  Clock::time_point Deadline(std::chrono::seconds timeout) const;
+  void UpdateReadDeadline();
+  void OnReadDeadline(boost::beast::error_code ec);
+  Stream* Find(std::int32_t stream_id);
+  Stream* NewStream(std::int32_t stream_id);
+
+  SessionStream stream_;
+  boost::beast::flat_buffer buffer_;
+  SessionContext const& context_;
+  SessionRegistry* registry_;
+  nghttp2_session* session_ = nullptr;
+  // The read deadlines change as streams open and complete, while a read is
+  // pending. The stream deadlines cannot change for a pending read, so the
+  // session uses a separate timer.
+  boost::asio::steady_timer read_timer_;
+  Clock::time_point read_deadline_ = Clock::time_point::max();
+  Clock::time_point idle_deadline_ = Clock::time_point::max();
+  std::map<std::int32_t, Stream> streams_;
+  // The streams with a complete request, waiting for `RunPending()`.
+  std::vector<std::int32_t> pending_;
+  // The serialized frames, and the frames being written to the socket.
+  std::string output_;
+  std::string writing_;
+  bool reading_ = false;
+  bool read_closed_ = false;
+  bool closed_ = false;
+  bool goaway_sent_ = false;
+  // The number of streams running in the handler pool, or waiting for a
+  // `RequestLimiter` slot.
+  int running_ = 0;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HTTP2_SESSION_H
@@ -0,0 +1,459 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/http2_session.h"
+#include "google/cloud/functions/internal/framework_impl.h"
+#include "google/cloud/functions/internal/parse_options.h"
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/framework.h"
+#include <boost/asio/connect.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+#include <gmock/gmock.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace asio = boost::asio;
+using tcp = boost::asio::ip::tcp;
+using ::testing::StartsWith;
+
+auto constexpr kData = 0x0;
+auto constexpr kHeaders = 0x1;
+auto constexpr kSettings = 0x4;
+auto constexpr kGoAway = 0x7;
+auto constexpr kEndStream = 0x1;
+auto constexpr kAck = 0x1;
+auto constexpr kEndHeaders = 0x4;
+
+/// The interesting parts of a response received over HTTP/2.
+struct TestResponse {
+  std::string status;
+  std::string body;
+};
+
+/**
+ * A minimal HTTP/2 client, just enough to test the server.
+ *
+ * The requests use HPACK literals without Huffman coding. The client decodes
+ * only the `:status` field of each response, which is the first field and is
+ * either in the static table, or a literal with the static `:status` name.
+ */
+class TestClient {
+ public:
+  explicit TestClient(int port) : socket_(ioc_) {
+    tcp::resolver resolver(ioc_);
+    asio::connect(socket_, resolver.resolve("localhost", std::to_string(port)));
+  }
+
+  ~TestClient() {
+    boost::system::error_code ec;
+    socket_.shutdown(tcp::socket::shutdown_both, ec);
+  }
+
+  /// Upgrades the connection, returns the HTTP/1.1 response header.
+  std::string Upgrade(std::string const& target) {
+    asio::write(socket_, asio::buffer("GET " + target +
+                                      " HTTP/1.1\r\n"
+                                      "Host: localhost\r\n"
+                                      "Connection: Upgrade, HTTP2-Settings\r\n"
+                                      "Upgrade: h2c\r\n"
+                                      "HTTP2-Settings: AAMAAABkAAQAAP__\r\n"
+                                      "\r\n"));
+    auto const n = asio::read_until(socket_, asio::dynamic_buffer(input_),
+                                    "\r\n\r\n");
+    auto header = input_.substr(0, n);
+    input_.erase(0, n);
+    return header;
+  }
+
+  void SendPreface() {
+    asio::write(socket_, asio::buffer(std::string(kHttp2Preface)));
+    WriteFrame(kSettings, 0, 0, {});
+  }
+
+  void SendRequest(std::uint32_t stream_id, std::string const& method,
+                   std::string const& path,
+                   std::vector<std::pair<std::string, std::string>> fields,
+                   std::string const& body = {}) {
+    auto const flags = body.empty() ? kEndHeaders | kEndStream : kEndHeaders;
+    WriteFrame(kHeaders, flags, stream_id,
+               HeaderBlock(method, path, std::move(fields)));
+    if (!body.empty()) WriteFrame(kData, kEndStream, stream_id, body);
+  }
+
+  /// Sends a `HEADERS` frame with @p flags, the stream remains open.
+  void SendHeaders(std::uint32_t stream_id, std::string const& path,
+                   int flags) {
+    WriteFrame(kHeaders, flags, stream_id, HeaderBlock("POST", path, {}));
+  }
+
+  /// Returns how long until the server closes the connection.
+  std::chrono::milliseconds WaitForClose() {
+    auto const start = std::chrono::steady_clock::now();
+    boost::system::error_code ec;
+    std::array<char, 1024> buffer;
+    while (!ec) socket_.read_some(asio::buffer(buffer), ec);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+  }
+
+  /// Reads frames until @p count streams complete.
+  std::map<std::uint32_t, TestResponse> ReadResponses(std::size_t count) {
+    std::map<std::uint32_t, TestResponse> responses;
+    std::size_t done = 0;
+    while (done != count) {
+      auto const [type, flags, stream_id, payload] = ReadFrame();
+      if (type == kSettings && (flags & kAck) == 0) {
+        WriteFrame(kSettings, kAck, 0, {});
+      } else if (type == kGoAway) {
+        break;
+      } else if (type == kHeaders) {
+        responses[stream_id].status = DecodeStatus(payload);
+      } else if (type == kData) {
+        responses[stream_id].body += payload;
+      }
+      if ((type == kHeaders || type == kData) && (flags & kEndStream) != 0) {
+        ++done;
+      }
+    }
+    return responses;
+  }
+
+ private:
+  struct Frame {
+    int type;
+    int flags;
+    std::uint32_t stream_id;
+    std::string payload;
+  };
+
+  static void AppendInteger(std::string& out, std::size_t value) {
+    // HPACK integers with a 7-bit prefix, RFC 7541 5.1.
+    if (value < 0x7f) {
+      out.push_back(static_cast<char>(value));
+      return;
+    }
+    out.push_back(static_cast<char>(0x7f));
+    value -= 0x7f;
+    while (value >= 0x80) {
+      out.push_back(static_cast<char>(0x80 | (value & 0x7f)));
+      value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+  }
+
+  static void AppendString(std::string& out, std::string const& s) {
+    AppendInteger(out, s.size());
+    out += s;
+  }
+
+  static std::string HeaderBlock(
+      std::string const& method, std::string const& path,
+      std::vector<std::pair<std::string, std::string>> fields) {
+    std::string block;
+    fields.insert(fields.begin(), {{":method", method},
+                                   {":scheme", "http"},
+                                   {":authority", "localhost"},
+                                   {":path", path}});
+    for (auto const& [name, value] : fields) {
+      // Literal header field without indexing, with a new name.
+      block.push_back('\0');
+      AppendString(block, name);
+      AppendString(block, value);
+    }
+    return block;
+  }
+
+  static std::string DecodeStatus(std::string const& block) {
+    static auto const* const kStatic = new std::map<int, std::string>{
+        {8, "200"},  {9, "204"},  {10, "206"}, {11, "304"},
+        {12, "400"}, {13, "404"}, {14, "500"}};
+    if (block.empty()) return {};
+    auto const b = static_cast<unsigned char>(block[0]);
+    if ((b & 0x80) != 0) {
+      auto i = kStatic->find(b & 0x7f);
+      return i == kStatic->end() ? std::string{} : i->second;
+    }
+    // A literal with the static `:status` name, and a value without Huffman
+    // coding.
+    if (block.size() < 2 || (b & 0x0f) != 8) return {};
+    auto const len = static_cast<unsigned char>(block[1]);
+    if ((len & 0x80) != 0) return {};
+    return block.substr(2, len);
+  }
+
+  void WriteFrame(int type, int flags, std::uint32_t stream_id,
+                  std::string const& payload) {
+    std::string frame;
+    auto const size = payload.size();
+    frame.push_back(static_cast<char>((size >> 16) & 0xff));
+    frame.push_back(static_cast<char>((size >> 8) & 0xff));
+    frame.push_back(static_cast<char>(size & 0xff));
+    frame.push_back(static_cast<char>(type));
+    frame.push_back(static_cast<char>(flags));
+    for (auto shift : {24, 16, 8, 0}) {
+      frame.push_back(static_cast<char>((stream_id >> shift) & 0xff));
+    }
+    frame += payload;
+    asio::write(socket_, asio::buffer(frame));
+  }
+
+  Frame ReadFrame() {
+    auto buffer = asio::dynamic_buffer(input_);
+    auto constexpr kFrameHeaderSize = 9;
+    if (input_.size() < kFrameHeaderSize) {
+      asio::read(socket_, buffer,
+                 asio::transfer_at_least(kFrameHeaderSize - input_.size()));
+    }
+    auto byte = [this](std::size_t i) {
+      return static_cast<std::uint32_t>(static_cast<unsigned char>(input_[i]));
+    };
+    auto const size = (byte(0) << 16) | (byte(1) << 8) | byte(2);
+    Frame frame;
+    frame.type = static_cast<int>(byte(3));
+    frame.flags = static_cast<int>(byte(4));
+    frame.stream_id =
+        ((byte(5) & 0x7f) << 24) | (byte(6) << 16) | (byte(7) << 8) | byte(8);
+    auto const total = kFrameHeaderSize + size;
+    if (input_.size() < total) {
+      asio::read(socket_, buffer,
+                 asio::transfer_at_least(total - input_.size()));
+    }
+    frame.payload = input_.substr(kFrameHeaderSize, size);
+    input_.erase(0, total);
+    return frame;
+  }
+
+  asio::io_context ioc_;
+  tcp::socket socket_;
+  std::string input_;
+};
+
+/// Runs a server with @p args, calls @p client with its port, then stops it.
+template <typename Client>
+void WithServer(std::vector<char const*> args, functions::Function function,
+                Client client) {
+  std::promise<int> port_p;
+  auto port_f = port_p.get_future();
+  std::atomic<bool> shutdown{false};
+  args.insert(args.begin(), {"unused", "--port=0", "--h2c"});
+  auto done = std::async(std::launch::async, [&] {
+    return RunForTest(
+        static_cast<int>(args.size()), args.data(),
+        function, [&shutdown]() { return shutdown.load(); },
+        [&port_p](int port) mutable { port_p.set_value(port); });
+  });
+  auto const port = port_f.get();
+  try {
+    client(port);
+  } catch (std::exception const& ex) {
+    ADD_FAILURE() << "exception in test client: " << ex.what();
+  }
+  shutdown.store(true);
+  // Making another request guarantees the change in `shutdown` is seen.
+  try {
+    TestClient quit(port);
+    quit.SendPreface();
+    quit.SendRequest(1, "GET", "/quit/now", {});
+    (void)quit.ReadResponses(1);
+  } catch (...) {
+  }
+  EXPECT_EQ(done.get(), 0);
+}
+
+template <typename UserFunction, typename Client>
+void WithServer(std::vector<char const*> args, UserFunction function,
+                Client client) {
+  WithServer(std::move(args), functions::MakeFunction(std::move(function)),
+             std::move(client));
+}
+
+functions::HttpResponse Echo(functions::HttpRequest const& request) {
+  std::string body = request.verb() + " " + request.target();
+  for (auto const& [name, value] : request.headers()) {
+    if (name == "x-test" || name == "Cookie") body += " " + value;
+  }
+  if (!request.payload().empty()) body += " " + request.payload();
+  return functions::HttpResponse{}.set_payload(std::move(body));
+}
+
+TEST(Http2SessionTest, Config) {
+  char const* argv[] = {"unused", "--h2c"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_TRUE(config.h2c);
+}
+
+TEST(Http2SessionTest, PriorKnowledge) {
+  WithServer({}, functions::UserHttpFunction(Echo), [](int port) {
+    TestClient client(port);
+    client.SendPreface();
+    client.SendRequest(1, "GET", "/get", {{"x-test", "header"}});
+    client.SendRequest(3, "POST", "/post", {}, "body");
+    client.SendRequest(5, "GET", "/favicon.ico", {});
+    client.SendRequest(7, "GET", "/cookie",
+                       {{"cookie", "a=1"}, {"cookie", "b=2"}});
+    auto responses = client.ReadResponses(4);
+    EXPECT_EQ(responses[1].status, "200");
+    EXPECT_EQ(responses[1].body, "GET /get header");
+    EXPECT_EQ(responses[3].status, "200");
+    EXPECT_EQ(responses[3].body, "POST /post body");
+    EXPECT_EQ(responses[5].status, "404");
+    EXPECT_EQ(responses[7].body, "GET /cookie a=1; b=2");
+  });
+}
+
+TEST(Http2SessionTest, ConcurrentStreams) {
+  // The first stream completes only after the second stream runs, which
+  // requires running the streams of a connection concurrently.
+  std::promise<void> fast_done;
+  auto fast_f = fast_done.get_future().share();
+  auto function = [&fast_done, fast_f](functions::HttpRequest const& r) {
+    if (r.target() == "/fast") {
+      fast_done.set_value();
+      return functions::HttpResponse{}.set_payload("fast");
+    }
+    if (r.target() != "/slow") return functions::HttpResponse{};
+    auto const status = fast_f.wait_for(std::chrono::seconds(10));
+    return functions::HttpResponse{}.set_payload(
+        status == std::future_status::ready ? "slow" : "timeout");
+  };
+  WithServer({"--handler-threads=2", "--session-engine=async"},
+             functions::UserHttpFunction(function), [](int port) {
+               TestClient client(port);
+               client.SendPreface();
+               client.SendRequest(1, "GET", "/slow", {});
+               client.SendRequest(3, "GET", "/fast", {});
+               auto responses = client.ReadResponses(2);
+               EXPECT_EQ(responses[1].body, "slow");
+               EXPECT_EQ(responses[3].body, "fast");
+             });
+}
+
+TEST(Http2SessionTest, Upgrade) {
+  for (auto const* engine : {"--session-engine=threads",
+                             "--session-engine=async"}) {
+    SCOPED_TRACE(engine);
+    WithServer({engine}, functions::UserHttpFunction(Echo), [](int port) {
+      TestClient client(port);
+      EXPECT_THAT(client.Upgrade("/upgrade"),
+                  StartsWith("HTTP/1.1 101 Switching Protocols\r\n"));
+      client.SendPreface();
+      auto responses = client.ReadResponses(1);
+      EXPECT_EQ(responses[1].status, "200");
+      EXPECT_EQ(responses[1].body, "GET /upgrade");
+      // The connection continues as HTTP/2.
+      client.SendRequest(3, "GET", "/next", {});
+      responses = client.ReadResponses(1);
+      EXPECT_EQ(responses[3].body, "GET /next");
+    });
+  }
+}
+
+TEST(Http2SessionTest, PreBodyHook) {
+  // The hook rejects the stream before its body arrives.
+  auto hook = [](functions::HttpRequest const& r)
+      -> std::optional<functions::HttpResponse> {
+    if (r.headers().count("x-test") != 0) return std::nullopt;
+    return functions::HttpResponse{}.set_result(
+        functions::HttpResponse::kForbidden);
+  };
+  auto function = functions::WithPreBodyHook(
+      functions::MakeFunction(functions::UserHttpFunction(Echo)), hook);
+  WithServer({}, function, [](int port) {
+    TestClient client(port);
+    client.SendPreface();
+    client.SendRequest(1, "POST", "/accepted", {{"x-test", "ok"}}, "body");
+    client.SendHeaders(3, "/rejected", kEndHeaders);
+    auto responses = client.ReadResponses(2);
+    EXPECT_EQ(responses[1].status, "200");
+    EXPECT_EQ(responses[1].body, "POST /accepted ok body");
+    EXPECT_EQ(responses[3].status, "403");
+  });
+}
+
+TEST(Http2SessionTest, WriterFunction) {
+  // HTTP/2 streams collect the response in memory.
+  auto writer = [](functions::HttpRequest const& /*request*/,
+                   functions::HttpResponseWriter writer) {
+    writer.Write("first ");
+    writer.Write("second");
+  };
+  WithServer({}, functions::UserHttpWriterFunction(writer), [](int port) {
+    TestClient client(port);
+    client.SendPreface();
+    client.SendRequest(1, "GET", "/writer", {});
+    auto responses = client.ReadResponses(1);
+    EXPECT_EQ(responses[1].status, "200");
+    EXPECT_EQ(responses[1].body, "first second");
+  });
+}
+
+TEST(Http2SessionTest, Limits) {
+  WithServer({"--max-body-bytes=16", "--max-header-bytes=256"},
+             functions::UserHttpFunction(Echo), [](int port) {
+               TestClient client(port);
+               client.SendPreface();
+               client.SendRequest(1, "POST", "/small", {}, "0123456789");
+               client.SendRequest(3, "POST", "/large", {},
+                                  std::string(32, 'x'));
+               client.SendRequest(5, "GET", "/header",
+                                  {{"x-test", std::string(300, 'x')}});
+               auto responses = client.ReadResponses(3);
+               EXPECT_EQ(responses[1].status, "200");
+               EXPECT_EQ(responses[3].status, "413");
+               EXPECT_EQ(responses[5].status, "431");
+             });
+}
+
+TEST(Http2SessionTest, Timeouts) {
+  // The timeouts are configured to 1 second, we tolerate up to 5.
+  auto constexpr kTolerance = std::chrono::seconds(5);
+  WithServer(
+      {"--idle-timeout=1", "--header-read-timeout=1", "--body-read-timeout=1"},
+      functions::UserHttpFunction(Echo), [&](int port) {
+        TestClient idle(port);
+        idle.SendPreface();
+        EXPECT_LE(idle.WaitForClose(), kTolerance);
+
+        // The header block never ends, it needs a `CONTINUATION` frame.
+        TestClient header(port);
+        header.SendPreface();
+        header.SendHeaders(1, "/stalled", 0);
+        EXPECT_LE(header.WaitForClose(), kTolerance);
+
+        // The body never ends, other streams on the connection still work.
+        TestClient body(port);
+        body.SendPreface();
+        body.SendHeaders(1, "/stalled", kEndHeaders);
+        body.SendRequest(3, "GET", "/other", {});
+        EXPECT_EQ(body.ReadResponses(1)[3].body, "GET /other");
+        EXPECT_LE(body.WaitForClose(), kTolerance);
+      });
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
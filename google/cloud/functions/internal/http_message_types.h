@@ -27,6 +27,14 @@ using BeastRequest =
 using BeastResponse =
     boost::beast::http::response<boost::beast::http::string_body>;
 
+/// A response with @p status and an empty body, for errors detected by the
+/// framework.
+inline BeastResponse MakeErrorResponse(boost::beast::http::status status) {
+  BeastResponse response;
+  response.result(status);
+  return response;
+}
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
 
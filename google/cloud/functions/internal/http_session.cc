@@ -0,0 +1,809 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/http_session.h"
+#ifdef FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+#include "google/cloud/functions/internal/base64_decode.h"
+#include "google/cloud/functions/internal/http2_session.h"
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/version.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#ifndef _WIN32
+#include <poll.h>
+#endif  // _WIN32
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+namespace be = boost::beast;
+namespace asio = boost::asio;
+
+// The size of the first read on an idle connection.
+auto constexpr kIdleReadSize = 4096;
+
+// The maximum number of pipelined requests handled as a single batch.
+std::size_t constexpr kMaxPipelinedRequests = 16;
+
+// How long a rejected connection may take to receive the response and close.
+auto constexpr kRejectLinger = std::chrono::seconds(1);
+
+// The interim response for requests with `Expect: 100-continue`.
+char const kContinueResponse[] = "HTTP/1.1 100 Continue\r\n\r\n";
+
+template <typename Parser>
+void ApplyLimits(Parser& parser, ServerConfig const& config) {
+  // Some versions of Beast reject any request with a `Content-Length` if the
+  // body limit is disabled (`boost::none`), use the largest value instead.
+  parser.body_limit(config.max_body_bytes == 0
+                        ? std::numeric_limits<std::uint64_t>::max()
+                        : config.max_body_bytes);
+  parser.header_limit(config.max_header_bytes == 0
+                          ? std::numeric_limits<std::uint32_t>::max()
+                          : config.max_header_bytes);
+}
+
+/**
+ * A synchronous stream over a socket, with a timeout for each operation.
+ *
+ * The socket may be in non-blocking mode, as it is also used for asynchronous
+ * operations, so the timeout cannot be set with `SO_RCVTIMEO` or `SO_SNDTIMEO`.
+ */
+class TimedStream {
+ public:
+  TimedStream(SessionSocket& socket, std::chrono::seconds timeout)
+      : socket_(socket), timeout_(timeout) {}
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(MutableBufferSequence const& buffers,
+                        be::error_code& ec) {
+    if (timeout_.count() != 0 && !Wait(POLLIN, ec)) return 0;
+    return socket_.read_some(buffers, ec);
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(MutableBufferSequence const& buffers) {
+    be::error_code ec;
+    auto const n = read_some(buffers, ec);
+    if (ec) BOOST_THROW_EXCEPTION(be::system_error{ec});
+    return n;
+  }
+
+  template <typename ConstBufferSequence>
+  std::size_t write_some(ConstBufferSequence const& buffers,
+                         be::error_code& ec) {
+    if (timeout_.count() != 0 && !Wait(POLLOUT, ec)) return 0;
+    return socket_.write_some(buffers, ec);
+  }
+
+  template <typename ConstBufferSequence>
+  std::size_t write_some(ConstBufferSequence const& buffers) {
+    be::error_code ec;
+    auto const n = write_some(buffers, ec);
+    if (ec) BOOST_THROW_EXCEPTION(be::system_error{ec});
+    return n;
+  }
+
+ private:
+  bool Wait(decltype(pollfd::events) events, be::error_code& ec) {
+    pollfd fd{};
+    fd.fd = socket_.native_handle();
+    fd.events = events;
+    auto const ms = std::chrono::milliseconds(timeout_).count();
+    for (;;) {
+#ifdef _WIN32
+      auto const r = ::WSAPoll(&fd, 1, static_cast<int>(ms));
+#else
+      auto const r = ::poll(&fd, 1, static_cast<int>(ms));
+      if (r < 0 && errno == EINTR) continue;
+#endif  // _WIN32
+      if (r > 0) return true;
+      if (r == 0) {
+        ec = be::error::timeout;
+      } else {
+        ec = be::error_code(errno, be::system_category());
+      }
+      return false;
+    }
+  }
+
+  SessionSocket& socket_;
+  std::chrono::seconds timeout_;
+};
+
+/**
+ * Sends a 503 response over a connection that exceeds the session limits.
+ *
+ * Closing the socket with unread data resets the connection, and the client may
+ * never see the response. Instead, the session shuts down its side of the
+ * connection after the response, and discards any data until the client closes
+ * the connection, or the deadline expires.
+ */
+class RejectedSession : public std::enable_shared_from_this<RejectedSession> {
+ public:
+  explicit RejectedSession(SessionSocket socket)
+      : stream_(std::move(socket)), response_(MakeOverloadedResponse()) {
+    response_.set(be::http::field::server, BOOST_BEAST_VERSION_STRING);
+    response_.keep_alive(false);
+    response_.prepare_payload();
+  }
+
+  void Start() {
+    stream_.expires_after(kRejectLinger);
+    be::http::async_write(stream_, response_,
+                          be::bind_front_handler(&RejectedSession::OnWrite,
+                                                 shared_from_this()));
+  }
+
+ private:
+  void OnWrite(be::error_code ec, std::size_t /*bytes_transferred*/) {
+    if (ec) return;
+    stream_.socket().shutdown(asio::socket_base::shutdown_send, ec);
+    DoDrain();
+  }
+
+  void DoDrain() {
+    buffer_.clear();
+    stream_.async_read_some(buffer_.prepare(kIdleReadSize),
+                            be::bind_front_handler(&RejectedSession::OnDrain,
+                                                   shared_from_this()));
+  }
+
+  void OnDrain(be::error_code ec, std::size_t /*bytes_transferred*/) {
+    if (ec) return;
+    DoDrain();
+  }
+
+  SessionStream stream_;
+  be::flat_buffer buffer_;
+  BeastResponse response_;
+};
+
+// HTTP/1.0 servers ignore the `Expect` header, RFC 7231 5.1.1.
+bool ExpectsContinue(BeastRequest const& request) {
+  return request.version() >= 11 &&
+         be::iequals(request[be::http::field::expect], "100-continue");
+}
+
+bool UnsupportedExpectation(BeastRequest const& request) {
+  return request.version() >= 11 &&
+         request.count(be::http::field::expect) != 0 &&
+         !ExpectsContinue(request);
+}
+
+}  // namespace
+
+/// Reads the request body for a `StreamingHandler`.
+class HttpSession::BodyReader : public functions::HttpBodyReader::Impl {
+ public:
+  explicit BodyReader(std::shared_ptr<HttpSession> session)
+      : session_(std::move(session)) {}
+
+  std::size_t Read(char* buffer, std::size_t size) override {
+    return session_->ReadBody(buffer, size);
+  }
+
+ private:
+  std::shared_ptr<HttpSession> session_;
+};
+
+/// Writes the response for a `WriterHandler`.
+class HttpSession::ResponseWriter
+    : public functions::HttpResponseWriter::Impl {
+ public:
+  explicit ResponseWriter(std::shared_ptr<HttpSession> session)
+      : session_(std::move(session)) {}
+
+  void set_result(int code) override { Header().result(code); }
+  void set_header(std::string_view name, std::string_view value) override {
+    Header().set(name, value);
+  }
+  void SendHeaders() override { session_->SendWriterHeader(); }
+  void Write(std::string_view data) override { session_->WriteChunk(data); }
+
+ private:
+  BeastResponse& Header() {
+    if (!session_->writer_response_ || session_->writer_started_) {
+      throw std::logic_error("the response headers were already sent");
+    }
+    return *session_->writer_response_;
+  }
+
+  std::shared_ptr<HttpSession> session_;
+};
+
+HttpSession::HttpSession(SessionSocket socket, SessionContext const& context)
+    : stream_(std::move(socket)),
+      context_(context),
+      registry_(context.registry) {}
+
+HttpSession::~HttpSession() {
+  // The context may be gone once the registry is released.
+  permit_ = {};
+  in_flight_ = {};
+  if (registry_ != nullptr) registry_->Release();
+}
+
+void HttpSession::Start() {
+  asio::dispatch(stream_.get_executor(),
+                 be::bind_front_handler(&HttpSession::DoRead,
+                                        shared_from_this()));
+}
+
+void HttpSession::DoRead() {
+  // Close keep-alive connections once the server is draining.
+  if (Draining()) return DoClose();
+  parser_.emplace();
+  ApplyLimits(*parser_, context_.config);
+  if (buffer_.size() != 0) return DoReadHeader();
+  // Wait for the first bytes of the next request, with the idle timeout. The
+  // header read timeout starts once the client starts sending the request.
+  ExpiresAfter(context_.config.idle_timeout);
+  stream_.async_read_some(
+      buffer_.prepare(kIdleReadSize),
+      be::bind_front_handler(&HttpSession::OnIdleRead, shared_from_this()));
+}
+
+void HttpSession::OnIdleRead(be::error_code ec, std::size_t bytes_transferred) {
+  if (ec == asio::error::eof) return DoClose();
+  if (ec) return OnError(ec, "read");
+  buffer_.commit(bytes_transferred);
+  if (MaybeStartHttp2()) return;
+  DoReadHeader();
+}
+
+bool HttpSession::MaybeStartHttp2() {
+#ifdef FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+  if (!context_.config.h2c || !first_read_) return false;
+  auto const data = static_cast<char const*>(buffer_.data().data());
+  auto const prefix = std::string_view(data, buffer_.size())
+                          .substr(0, kHttp2Preface.size());
+  if (kHttp2Preface.substr(0, prefix.size()) != prefix) {
+    first_read_ = false;
+    return false;
+  }
+  if (prefix.size() < kHttp2Preface.size()) {
+    // Wait for the rest of the preface.
+    stream_.async_read_some(
+        buffer_.prepare(kIdleReadSize),
+        be::bind_front_handler(&HttpSession::OnIdleRead, shared_from_this()));
+    return true;
+  }
+  // The new session releases the registry slot when it completes.
+  std::make_shared<Http2Session>(SessionStream(stream_.release_socket()),
+                                 std::move(buffer_), context_,
+                                 std::exchange(registry_, nullptr))
+      ->Start();
+  return true;
+#else
+  first_read_ = false;
+  return false;
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+}
+
+bool HttpSession::MaybeUpgradeHttp2() {
+#ifdef FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+  if (!context_.config.h2c || requests_.size() != 1) return false;
+  auto const& request = requests_.front();
+  if (request.version() != 11) return false;
+  auto const upgrade = request[be::http::field::upgrade];
+  auto const has_token = [](std::string_view list, std::string_view token) {
+    for (auto const& t : be::http::token_list(list)) {
+      if (be::iequals(t, token)) return true;
+    }
+    return false;
+  };
+  if (!has_token(upgrade, "h2c")) return false;
+  auto const header = request.find("HTTP2-Settings");
+  if (header == request.end()) return false;
+  // The settings are base64url encoded, without padding.
+  auto encoded = std::string(header->value());
+  std::replace(encoded.begin(), encoded.end(), '-', '+');
+  std::replace(encoded.begin(), encoded.end(), '_', '/');
+  std::string settings;
+  try {
+    settings = Base64Decode(encoded);
+  } catch (std::exception const&) {
+    return false;
+  }
+  // Each setting is 6 bytes, invalid settings are ignored, and the request is
+  // served as HTTP/1.1.
+  if (settings.size() % 6 != 0) return false;
+  auto session = std::make_shared<Http2Session>(
+      SessionStream(stream_.release_socket()), std::move(buffer_), context_,
+      std::exchange(registry_, nullptr));
+  auto r = std::move(requests_.front());
+  requests_.clear();
+  try {
+    session->StartUpgrade(std::move(r), settings);
+  } catch (std::exception const& ex) {
+    // TODO(#35) - maybe replace with Boost.Log
+    std::cerr << "h2c upgrade: " << ex.what() << "\n";
+  }
+  return true;
+#else
+  return false;
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+}
+
+void HttpSession::DoReadHeader() {
+  // Requests that arrive after the drain completed are not served, the client
+  // can safely retry them.
+  if (!TrackRequest()) return DoClose();
+  ExpiresAfter(context_.config.header_read_timeout);
+  be::http::async_read_header(
+      stream_, buffer_, *parser_,
+      be::bind_front_handler(&HttpSession::OnReadHeader, shared_from_this()));
+}
+
+void HttpSession::OnReadHeader(be::error_code ec,
+                               std::size_t /*bytes_transferred*/) {
+  if (ec == be::http::error::end_of_stream) return DoClose();
+  if (ec) return OnReadError(ec);
+  if (!AcceptHeader()) return;
+  // Clients that already started sending the body do not need the interim
+  // response.
+  if (ExpectsContinue(parser_->get()) && !parser_->is_done() &&
+      buffer_.size() == 0) {
+    return DoWriteContinue();
+  }
+  ReadRequestBody();
+}
+
+bool HttpSession::AcceptHeader() {
+  auto const& header = parser_->get();
+  if (UnsupportedExpectation(header)) {
+    DoWriteError(be::http::status::expectation_failed);
+    return false;
+  }
+  if (!context_.pre_body_hook) return true;
+  auto response = context_.pre_body_hook(header);
+  if (!response) return true;
+  // Without a body to discard, the connection remains usable.
+  if (parser_->is_done() && header.keep_alive()) {
+    stream_.expires_never();
+    parser_.reset();
+    keep_alive_ = true;
+    responses_.clear();
+    responses_.push_back(*std::move(response));
+    responses_.back().keep_alive(true);
+    DoWrite();
+    return false;
+  }
+  DoWriteError(*std::move(response));
+  return false;
+}
+
+void HttpSession::DoWriteContinue() {
+  ExpiresAfter(context_.config.write_timeout);
+  asio::async_write(stream_,
+                    asio::buffer(kContinueResponse,
+                                 sizeof(kContinueResponse) - 1),
+                    be::bind_front_handler(&HttpSession::OnWriteContinue,
+                                           shared_from_this()));
+}
+
+void HttpSession::OnWriteContinue(be::error_code ec,
+                                  std::size_t /*bytes_transferred*/) {
+  if (ec) return OnError(ec, "write");
+  ReadRequestBody();
+}
+
+void HttpSession::ReadRequestBody() {
+  if (context_.streaming_handler) return HandleStreamingRequest();
+  ExpiresAfter(context_.config.body_read_timeout);
+  be::http::async_read(
+      stream_, buffer_, *parser_,
+      be::bind_front_handler(&HttpSession::OnRead, shared_from_this()));
+}
+
+void HttpSession::OnRead(be::error_code ec, std::size_t /*bytes_transferred*/) {
+  if (ec) return OnReadError(ec);
+  stream_.expires_never();
+  requests_.push_back(parser_->release());
+  parser_.reset();
+  if (MaybeUpgradeHttp2()) return;
+  // Pick up any pipelined requests that are already in the buffer.
+  // Functions that write their response directly cannot be batched, and
+  // requests for a `pre_body_hook` are inspected as their header arrives.
+  while (!context_.writer_handler && !context_.pre_body_hook &&
+         requests_.back().keep_alive() &&
+         requests_.size() < kMaxPipelinedRequests && buffer_.size() != 0) {
+    if (!ParseBufferedRequest()) break;
+  }
+  HandleRequests();
+}
+
+bool HttpSession::ParseBufferedRequest() {
+  be::http::request_parser<BeastRequest::body_type> parser;
+  ApplyLimits(parser, context_.config);
+  parser.eager(true);
+  auto const data = buffer_.data();
+  std::size_t used = 0;
+  while (!parser.is_done()) {
+    // Incomplete or invalid requests are left in the buffer, the next
+    // asynchronous read completes (or rejects) them.
+    if (used == data.size()) return false;
+    be::error_code ec;
+    used += parser.put(data + used, ec);
+    if (ec) return false;
+  }
+  // The next asynchronous read rejects these requests.
+  if (UnsupportedExpectation(parser.get())) return false;
+  buffer_.consume(used);
+  requests_.push_back(parser.release());
+  return true;
+}
+
+void HttpSession::HandleStreamingRequest() {
+  // The function reads the body, using synchronous reads, see `ReadBody()`.
+  stream_.expires_never();
+  body_parser_.emplace(std::move(*parser_));
+  parser_.reset();
+  body_error_ = {};
+  requests_.emplace_back(body_parser_->get().base());
+  HandleRequests();
+}
+
+void HttpSession::HandleRequests() {
+  context_.stats->requests.fetch_add(requests_.size(),
+                                     std::memory_order_relaxed);
+  keep_alive_ = requests_.back().keep_alive();
+  if (!AdmitRequests()) return;
+  DispatchRequests();
+}
+
+bool HttpSession::AdmitRequests() {
+  if (context_.limiter == nullptr) return true;
+  // Queued requests resume in the session executor. The executor tracks the
+  // pending work, otherwise the event loop may stop while they wait.
+  auto executor = asio::prefer(stream_.get_executor(),
+                               asio::execution::outstanding_work.tracked);
+  auto const admission = context_.limiter->Admit(
+      permit_, [self = shared_from_this(),
+                executor = std::move(executor)](RequestLimiter::Permit p) {
+        asio::post(executor, [self, p = std::move(p)]() mutable {
+          // An empty permit rejects the requests, see `RequestLimiter`.
+          if (!p) return self->RejectRequests();
+          self->permit_ = std::move(p);
+          self->DispatchRequests();
+        });
+      });
+  switch (admission) {
+    case RequestLimiter::Admission::kAdmitted:
+      return true;
+    case RequestLimiter::Admission::kQueued:
+      return false;
+    case RequestLimiter::Admission::kRejected:
+      break;
+  }
+  RejectRequests();
+  return false;
+}
+
+void HttpSession::DispatchRequests() {
+  if (context_.pool == nullptr) {
+    RunHandlers();
+    permit_ = {};
+    return DoWrite();
+  }
+  // Run the function in the handler pool, and resume in the session executor
+  // once it completes. Only one of these threads touches the session at a
+  // time. The executor tracks the pending work, otherwise the event loop may
+  // run out of work and stop while the function is running.
+  auto executor = asio::prefer(stream_.get_executor(),
+                               asio::execution::outstanding_work.tracked);
+  auto submitted = context_.pool->TrySubmit(
+      [self = shared_from_this(), executor = std::move(executor)] {
+        self->RunHandlers();
+        self->permit_ = {};
+        asio::post(executor,
+                   be::bind_front_handler(&HttpSession::DoWrite, self));
+      });
+  if (submitted) return;
+  permit_ = {};
+  RejectRequests();
+}
+
+void HttpSession::RejectRequests() {
+  context_.stats->requests_rejected.fetch_add(requests_.size(),
+                                              std::memory_order_relaxed);
+  auto const status =
+      static_cast<be::http::status>(context_.config.overload_status);
+  responses_.clear();
+  for (auto const& r : requests_) {
+    responses_.push_back(MakeOverloadedResponse(status));
+    responses_.back().keep_alive(r.keep_alive());
+  }
+  requests_.clear();
+  if (body_parser_) FinishStreamingRequest();
+  DoWrite();
+}
+
+void HttpSession::RunHandlers() {
+  responses_.clear();
+  if (body_parser_) {
+    RunStreamingHandler();
+  } else if (context_.writer_handler) {
+    // The output is flushed before the response completes.
+    return RunWriterHandler();
+  } else {
+    for (auto& r : requests_) {
+      auto const keep_alive = r.keep_alive();
+      responses_.push_back(context_.handler(std::move(r)));
+      responses_.back().keep_alive(keep_alive);
+    }
+  }
+  requests_.clear();
+  FlushOutput();
+}
+
+void HttpSession::FlushOutput() {
+  // Flush any buffered output, as the application may be shutdown immediately
+  // after the HTTP response is sent. This must run in the same thread as the
+  // function.
+  if (context_.output != nullptr) context_.output->Flush();
+}
+
+void HttpSession::RunStreamingHandler() {
+  responses_.push_back(context_.streaming_handler(
+      std::move(requests_.front()),
+      functions::HttpBodyReader(
+          std::make_unique<BodyReader>(shared_from_this()))));
+  FinishStreamingRequest();
+}
+
+void HttpSession::FinishStreamingRequest() {
+  if (body_error_ == be::http::error::body_limit) {
+    responses_.back() = MakeErrorResponse(be::http::status::payload_too_large);
+  } else if (body_error_ == be::error::timeout) {
+    context_.stats->sessions_timed_out.fetch_add(1, std::memory_order_relaxed);
+  }
+  // The next request starts after the end of this body. If the function did
+  // not read the full body, discard it and close the connection.
+  if (body_error_ || !body_parser_->is_done()) {
+    keep_alive_ = false;
+    discard_input_ = true;
+  }
+  responses_.back().keep_alive(keep_alive_);
+  body_parser_.reset();
+}
+
+void HttpSession::RunWriterHandler() {
+  auto request = std::move(requests_.front());
+  requests_.clear();
+  writer_chunked_ = request.version() >= 11;
+  writer_started_ = false;
+  writer_error_ = {};
+  writer_response_.emplace();
+  auto error = context_.writer_handler(
+      std::move(request),
+      functions::HttpResponseWriter(
+          std::make_unique<ResponseWriter>(shared_from_this())));
+  FlushOutput();
+  auto response = *std::move(writer_response_);
+  writer_response_.reset();
+  if (!writer_started_) {
+    // Nothing was sent, the response is written as usual.
+    responses_.push_back(error ? *std::move(error) : std::move(response));
+    responses_.back().keep_alive(keep_alive_);
+    return;
+  }
+  // Close the connection before the last chunk if the function failed, so the
+  // client cannot mistake the partial response for a complete one. Without
+  // chunked encoding the response ends when the connection is closed.
+  if (error || writer_error_ || !writer_chunked_) {
+    keep_alive_ = false;
+    return;
+  }
+  be::error_code ec;
+  TimedStream stream(stream_.socket(), context_.config.write_timeout);
+  asio::write(stream, be::http::make_chunk_last(), ec);
+  if (ec) keep_alive_ = false;
+}
+
+void HttpSession::SendWriterHeader() {
+  if (writer_started_) return;
+  auto& r = *writer_response_;
+  // The framework sets the `Server` header via the static headers, which
+  // replace any fields with the same name.
+  r.erase(be::http::field::server);
+  if (context_.static_headers != nullptr) context_.static_headers->EraseFrom(r);
+  r.erase(be::http::field::content_length);
+  if (Draining()) keep_alive_ = false;
+  if (writer_chunked_) {
+    r.chunked(true);
+  } else {
+    keep_alive_ = false;
+  }
+  r.keep_alive(keep_alive_);
+  writer_started_ = true;
+  serializer_.Clear();
+  serializer_.Append(r, context_.static_headers);
+  TimedStream stream(stream_.socket(), context_.config.write_timeout);
+  be::error_code ec;
+  asio::write(stream, serializer_.buffers(), ec);
+  CheckWriterError(ec);
+}
+
+void HttpSession::WriteChunk(std::string_view data) {
+  if (writer_error_) CheckWriterError(writer_error_);
+  SendWriterHeader();
+  // An empty chunk would terminate the response.
+  if (data.empty()) return;
+  TimedStream stream(stream_.socket(), context_.config.write_timeout);
+  be::error_code ec;
+  auto const buffer = asio::const_buffer(data.data(), data.size());
+  if (writer_chunked_) {
+    asio::write(stream, be::http::make_chunk(buffer), ec);
+  } else {
+    asio::write(stream, buffer, ec);
+  }
+  CheckWriterError(ec);
+}
+
+void HttpSession::CheckWriterError(be::error_code ec) {
+  if (!ec) return;
+  if (!writer_error_ && ec == be::error::timeout) {
+    context_.stats->sessions_timed_out.fetch_add(1, std::memory_order_relaxed);
+  }
+  writer_error_ = ec;
+  throw std::runtime_error("cannot write the response: " + ec.message());
+}
+
+std::size_t HttpSession::ReadBody(char* buffer, std::size_t size) {
+  if (!body_parser_) {
+    throw std::logic_error(
+        "the request body can only be read while the function runs");
+  }
+  if (body_error_) {
+    throw std::runtime_error("cannot read the request body: " +
+                             body_error_.message());
+  }
+  if (size == 0) return 0;
+  TimedStream stream(stream_.socket(), context_.config.body_read_timeout);
+  auto& body = body_parser_->get().body();
+  while (!body_parser_->is_done()) {
+    body.data = buffer;
+    body.size = size;
+    be::error_code ec;
+    be::http::read_some(stream, buffer_, *body_parser_, ec);
+    // The parser stops once `buffer` is full.
+    if (ec == be::http::error::need_buffer) ec = {};
+    if (ec) {
+      body_error_ = ec;
+      throw std::runtime_error("cannot read the request body: " +
+                               ec.message());
+    }
+    auto const n = size - body.size;
+    if (n != 0) return n;
+  }
+  return 0;
+}
+
+void HttpSession::DoWriteError(be::http::status status) {
+  DoWriteError(MakeErrorResponse(status));
+}
+
+void HttpSession::DoWriteError(BeastResponse response) {
+  responses_.clear();
+  responses_.push_back(std::move(response));
+  responses_.back().keep_alive(false);
+  keep_alive_ = false;
+  discard_input_ = true;
+  DoWrite();
+}
+
+void HttpSession::DoWrite() {
+  if (Draining() && !responses_.empty()) {
+    keep_alive_ = false;
+    responses_.back().keep_alive(false);
+  }
+  serializer_.Clear();
+  for (auto& r : responses_) {
+    // The framework sets the `Server` header via the static headers, which
+    // replace any fields with the same name.
+    r.erase(be::http::field::server);
+    if (context_.static_headers != nullptr) {
+      context_.static_headers->EraseFrom(r);
+    }
+    r.prepare_payload();
+    serializer_.Append(r, context_.static_headers);
+  }
+  ExpiresAfter(context_.config.write_timeout);
+  asio::async_write(
+      stream_, serializer_.buffers(),
+      be::bind_front_handler(&HttpSession::OnWrite, shared_from_this()));
+}
+
+void HttpSession::OnWrite(be::error_code ec,
+                          std::size_t /*bytes_transferred*/) {
+  if (ec) return OnError(ec, "write");
+  responses_.clear();
+  in_flight_ = {};
+  if (!keep_alive_) return discard_input_ ? DoDiscard() : DoClose();
+  DoRead();
+}
+
+void HttpSession::DoClose() {
+  be::error_code ec;
+  stream_.socket().shutdown(asio::socket_base::shutdown_send, ec);
+}
+
+void HttpSession::DoDiscard() {
+  // Closing the socket with unread data resets the connection, and the client
+  // may never see the response.
+  DoClose();
+  stream_.expires_after(kRejectLinger);
+  OnDiscard({}, 0);
+}
+
+void HttpSession::OnDiscard(be::error_code ec,
+                            std::size_t /*bytes_transferred*/) {
+  if (ec) return;
+  buffer_.clear();
+  stream_.async_read_some(
+      buffer_.prepare(kIdleReadSize),
+      be::bind_front_handler(&HttpSession::OnDiscard, shared_from_this()));
+}
+
+void HttpSession::OnReadError(be::error_code ec) {
+  // Requests that exceed the limits are rejected before they are buffered.
+  if (ec == be::http::error::header_limit) {
+    return DoWriteError(be::http::status::request_header_fields_too_large);
+  }
+  if (ec == be::http::error::body_limit) {
+    return DoWriteError(be::http::status::payload_too_large);
+  }
+  OnError(ec, "read");
+}
+
+void HttpSession::OnError(be::error_code ec, char const* what) {
+  if (ec == be::error::timeout) {
+    // The stream closes the socket when the deadline expires.
+    context_.stats->sessions_timed_out.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // TODO(#35) - maybe replace with Boost.Log
+  std::cerr << what << ": " << ec.message() << "\n";
+}
+
+void HttpSession::ExpiresAfter(std::chrono::seconds timeout) {
+  if (timeout.count() == 0) return stream_.expires_never();
+  stream_.expires_after(timeout);
+}
+
+bool HttpSession::Draining() const {
+  return context_.drain != nullptr && context_.drain->draining();
+}
+
+bool HttpSession::TrackRequest() {
+  if (context_.drain == nullptr || in_flight_) return true;
+  in_flight_ = context_.drain->Track();
+  return static_cast<bool>(in_flight_);
+}
+
+void RejectSession(SessionSocket socket) {
+  std::make_shared<RejectedSession>(std::move(socket))->Start();
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,213 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HTTP_SESSION_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HTTP_SESSION_H
+
+#include "google/cloud/functions/internal/drain_controller.h"
+#include "google/cloud/functions/internal/function_impl.h"
+#include "google/cloud/functions/internal/handler_pool.h"
+#include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/internal/output_flusher.h"
+#include "google/cloud/functions/internal/request_limiter.h"
+#include "google/cloud/functions/internal/response_serializer.h"
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/internal/server_stats.h"
+#include "google/cloud/functions/internal/session_registry.h"
+#include "google/cloud/functions/internal/static_headers.h"
+#include "google/cloud/functions/version.h"
+#include <boost/asio/generic/stream_protocol.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * The sockets served by the sessions.
+ *
+ * The sessions use the generic stream protocol, so the same code serves TCP
+ * and Unix domain sockets. TCP sockets convert implicitly.
+ */
+using SessionSocket = boost::asio::generic::stream_protocol::socket;
+using SessionStream =
+    boost::beast::basic_stream<boost::asio::generic::stream_protocol>;
+
+/// The state shared by all the sessions served by the same event loop.
+struct SessionContext {
+  Handler handler;
+  /// If not null, the requests are served by this handler, which reads the
+  /// request body incrementally.
+  StreamingHandler streaming_handler;
+  /// If not null, the requests are served by this handler, which writes the
+  /// response incrementally.
+  WriterHandler writer_handler;
+  /// If not null, inspects each request header before the body is read.
+  PreBodyHook pre_body_hook;
+  ServerConfig config;
+  /// If not null, the user function runs in this pool.
+  HandlerPool* pool = nullptr;
+  ServerStats* stats = nullptr;
+  /// If not null, sessions notify this registry when they complete.
+  SessionRegistry* registry = nullptr;
+  /// If not null, these fields are included in every response.
+  StaticHeaders const* static_headers = nullptr;
+  /// If not null, flushes the function output before each response.
+  OutputFlusher* output = nullptr;
+  /// If not null, tracks the requests in flight for a graceful shutdown.
+  DrainController* drain = nullptr;
+  /// If not null, limits the number of concurrent function invocations.
+  RequestLimiter* limiter = nullptr;
+};
+
+/**
+ * Serves the HTTP requests received over a single connection.
+ *
+ * All the operations on a session run in the executor associated with its
+ * socket. The session keeps itself alive by capturing `shared_from_this()` in
+ * each completion handler, it is destroyed once the connection is closed.
+ *
+ * Each phase of the connection has a deadline, as configured in
+ * `ServerConfig`. Sessions that miss their deadline are closed and counted in
+ * `ServerStats::sessions_timed_out`.
+ *
+ * Clients may pipeline requests. After each read the session parses any
+ * complete requests already in the read buffer, runs them in order, and sends
+ * all their responses with a single gathered write, see `ResponseSerializer`.
+ *
+ * With a `SessionContext::streaming_handler` the session reads only the request
+ * header, and the function reads the body directly from the socket, in the
+ * thread running the function. No asynchronous operations are pending while
+ * the function runs, so this does not race with the session executor.
+ * Likewise, with a `SessionContext::writer_handler` the function writes the
+ * response directly to the socket, using chunked encoding for HTTP/1.1.
+ *
+ * Requests that exceed `ServerConfig::max_body_bytes` or
+ * `ServerConfig::max_header_bytes` are rejected before they are buffered.
+ * Likewise, the `SessionContext::pre_body_hook` may reject a request once its
+ * header is read. Clients that send `Expect: 100-continue` receive `100
+ * Continue` only after the request is accepted, and other expectations are
+ * rejected with `417 Expectation Failed`.
+ * Each batch of requests acquires a `RequestLimiter` slot before calling the
+ * function, and waits for a slot, or is rejected, if the server is overloaded.
+ *
+ * Once the server starts draining, see `DrainController`, the session sends
+ * `Connection: close` with the next response and closes the connection.
+ *
+ * With `ServerConfig::h2c` the session hands over the connection to an
+ * `Http2Session` if the client starts with the HTTP/2 preface, or sends a
+ * request with `Upgrade: h2c`.
+ */
+class HttpSession : public std::enable_shared_from_this<HttpSession> {
+ public:
+  HttpSession(SessionSocket socket, SessionContext const& context);
+  ~HttpSession();
+
+  void Start();
+
+ private:
+  class BodyReader;
+  class ResponseWriter;
+  using BodyParser =
+      boost::beast::http::request_parser<boost::beast::http::buffer_body>;
+
+  void DoRead();
+  void OnIdleRead(boost::beast::error_code ec, std::size_t bytes_transferred);
+  bool MaybeStartHttp2();
+  bool MaybeUpgradeHttp2();
+  void DoReadHeader();
+  void OnReadHeader(boost::beast::error_code ec, std::size_t bytes_transferred);
+  bool AcceptHeader();
+  void DoWriteContinue();
+  void OnWriteContinue(boost::beast::error_code ec,
+                       std::size_t bytes_transferred);
+  void ReadRequestBody();
+  void OnRead(boost::beast::error_code ec, std::size_t bytes_transferred);
+  bool ParseBufferedRequest();
+  void HandleStreamingRequest();
+  void HandleRequests();
+  bool AdmitRequests();
+  void DispatchRequests();
+  void RejectRequests();
+  void RunHandlers();
+  void RunStreamingHandler();
+  void FinishStreamingRequest();
+  std::size_t ReadBody(char* buffer, std::size_t size);
+  void RunWriterHandler();
+  void SendWriterHeader();
+  void WriteChunk(std::string_view data);
+  void CheckWriterError(boost::beast::error_code ec);
+  void FlushOutput();
+  void DoWriteError(boost::beast::http::status status);
+  void DoWriteError(BeastResponse response);
+  void DoWrite();
+  void OnWrite(boost::beast::error_code ec, std::size_t bytes_transferred);
+  void DoClose();
+  void DoDiscard();
+  void OnDiscard(boost::beast::error_code ec, std::size_t bytes_transferred);
+  void OnReadError(boost::beast::error_code ec);
+  void OnError(boost::beast::error_code ec, char const* what);
+  void ExpiresAfter(std::chrono::seconds timeout);
+  bool Draining() const;
+  bool TrackRequest();
+
+  SessionStream stream_;
+  // The buffer must outlive each request, it may contain the beginning of the
+  // next request on the same connection.
+  boost::beast::flat_buffer buffer_;
+  std::optional<boost::beast::http::request_parser<BeastRequest::body_type>>
+      parser_;
+  // Reads the body of the current request, with a `streaming_handler`.
+  std::optional<BodyParser> body_parser_;
+  boost::beast::error_code body_error_;
+  // The response header for a `writer_handler`, engaged while it runs.
+  std::optional<BeastResponse> writer_response_;
+  bool writer_started_ = false;
+  bool writer_chunked_ = false;
+  boost::beast::error_code writer_error_;
+  // The requests in the current pipelined batch, and their responses.
+  std::vector<BeastRequest> requests_;
+  std::vector<BeastResponse> responses_;
+  ResponseSerializer serializer_;
+  bool keep_alive_ = false;
+  // Held from the first byte of a request until its response is sent.
+  DrainController::InFlight in_flight_;
+  // Held while the function runs, see `RequestLimiter`.
+  RequestLimiter::Permit permit_;
+  // HTTP/2 clients with prior knowledge start with the preface.
+  bool first_read_ = true;
+  // If true, the connection may have unread request data, discard it before
+  // closing the connection, otherwise the client may not receive the response.
+  bool discard_input_ = false;
+  SessionContext const& context_;
+  // The context may be gone by the time the session is destroyed.
+  SessionRegistry* registry_;
+};
+
+/**
+ * Closes a connection that exceeds the session limits with a 503 response.
+ *
+ * The response is sent asynchronously, the caller must run the socket's
+ * executor.
+ */
+void RejectSession(SessionSocket socket);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_HTTP_SESSION_H
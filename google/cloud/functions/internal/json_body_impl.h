@@ -0,0 +1,38 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_JSON_BODY_IMPL_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_JSON_BODY_IMPL_H
+
+#include "google/cloud/functions/json_body.h"
+#include "google/cloud/functions/version.h"
+#include <memory>
+#include <string_view>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Parses @p payload with the JSON backend selected at build time.
+ *
+ * The nlohmann/json backend is in json_body_nlohmann.cc, the simdjson backend
+ * (`FUNCTIONS_FRAMEWORK_CPP_ENABLE_SIMDJSON=ON`) is in json_body_simdjson.cc.
+ */
+std::unique_ptr<functions::JsonBody::Impl> MakeJsonBodyImpl(
+    std::string_view payload);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_JSON_BODY_IMPL_H
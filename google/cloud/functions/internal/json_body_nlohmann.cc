@@ -0,0 +1,97 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/json_body_impl.h"
+#include <nlohmann/json.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+class NlohmannJsonBody : public functions::JsonBody::Impl {
+ public:
+  explicit NlohmannJsonBody(std::string_view payload)
+      : json_(nlohmann::json::parse(payload, nullptr,
+                                    /*allow_exceptions=*/false)) {
+    if (json_.is_discarded()) {
+      throw std::invalid_argument("the payload is not valid JSON");
+    }
+  }
+
+  std::optional<std::string> GetString(std::string_view pointer) override {
+    auto const* v = Find(pointer);
+    if (v == nullptr || !v->is_string()) return std::nullopt;
+    return v->get<std::string>();
+  }
+
+  std::optional<std::int64_t> GetInt64(std::string_view pointer) override {
+    auto const* v = Find(pointer);
+    if (v == nullptr || !v->is_number_integer()) return std::nullopt;
+    if (v->is_number_unsigned() &&
+        v->get<std::uint64_t>() >
+            static_cast<std::uint64_t>(
+                std::numeric_limits<std::int64_t>::max())) {
+      return std::nullopt;
+    }
+    return v->get<std::int64_t>();
+  }
+
+  std::optional<double> GetDouble(std::string_view pointer) override {
+    auto const* v = Find(pointer);
+    if (v == nullptr || !v->is_number()) return std::nullopt;
+    return v->get<double>();
+  }
+
+  std::optional<bool> GetBool(std::string_view pointer) override {
+    auto const* v = Find(pointer);
+    if (v == nullptr || !v->is_boolean()) return std::nullopt;
+    return v->get<bool>();
+  }
+
+  std::optional<std::string> GetJson(std::string_view pointer) override {
+    auto const* v = Find(pointer);
+    if (v == nullptr) return std::nullopt;
+    return v->dump();
+  }
+
+ private:
+  nlohmann::json const* Find(std::string_view pointer) const {
+    nlohmann::json::json_pointer p;
+    try {
+      p = nlohmann::json::json_pointer(std::string(pointer));
+    } catch (nlohmann::json::exception const&) {
+      throw std::invalid_argument("invalid JSON pointer <" +
+                                  std::string(pointer) + ">");
+    }
+    // `contains()` is false for array indices that are out of range, or not
+    // numbers.
+    if (!json_.contains(p)) return nullptr;
+    return &json_[p];
+  }
+
+  nlohmann::json json_;
+};
+
+}  // namespace
+
+std::unique_ptr<functions::JsonBody::Impl> MakeJsonBodyImpl(
+    std::string_view payload) {
+  return std::make_unique<NlohmannJsonBody>(payload);
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/json_body_impl.h"
+#include <mutex>
+#include <simdjson.h>
+#include <stdexcept>
+#include <string>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace ondemand = ::simdjson::ondemand;
+
+/**
+ * Looks up values with the simdjson On-Demand API.
+ *
+ * `iterate()` indexes the structure of the payload once, in the constructor.
+ * Each lookup rewinds the document and parses only the values on the way to
+ * the requested field, no document tree is created.
+ */
+class SimdjsonJsonBody : public functions::JsonBody::Impl {
+ public:
+  explicit SimdjsonJsonBody(std::string_view payload) : payload_(payload) {
+    if (parser_.iterate(payload_).get(document_) != simdjson::SUCCESS) {
+      throw std::invalid_argument("the payload is not valid JSON");
+    }
+  }
+
+  std::optional<std::string> GetString(std::string_view pointer) override {
+    auto v = Get<std::string_view>(pointer);
+    if (!v) return std::nullopt;
+    return std::string(*v);
+  }
+
+  std::optional<std::int64_t> GetInt64(std::string_view pointer) override {
+    return Get<std::int64_t>(pointer);
+  }
+
+  std::optional<double> GetDouble(std::string_view pointer) override {
+    return Get<double>(pointer);
+  }
+
+  std::optional<bool> GetBool(std::string_view pointer) override {
+    return Get<bool>(pointer);
+  }
+
+  std::optional<std::string> GetJson(std::string_view pointer) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    document_.rewind();
+    std::string_view json;
+    auto const error =
+        simdjson::to_json_string(document_.at_pointer(pointer)).get(json);
+    if (error != simdjson::SUCCESS) return OnError(error, pointer);
+    return std::string(json);
+  }
+
+ private:
+  template <typename T>
+  std::optional<T> Get(std::string_view pointer) {
+    // The document keeps the iteration state, even for lookups.
+    std::lock_guard<std::mutex> lk(mu_);
+    document_.rewind();
+    T value;
+    auto const error = document_.at_pointer(pointer).get(value);
+    if (error != simdjson::SUCCESS) return OnError(error, pointer);
+    return value;
+  }
+
+  static std::nullopt_t OnError(simdjson::error_code error,
+                                std::string_view pointer) {
+    switch (error) {
+      case simdjson::NO_SUCH_FIELD:
+      case simdjson::INDEX_OUT_OF_BOUNDS:
+      case simdjson::INCORRECT_TYPE:
+      case simdjson::NUMBER_OUT_OF_RANGE:
+        return std::nullopt;
+      case simdjson::INVALID_JSON_POINTER:
+        throw std::invalid_argument("invalid JSON pointer <" +
+                                    std::string(pointer) + ">");
+      default:
+        break;
+    }
+    throw std::invalid_argument(std::string("the payload is not valid JSON: ") +
+                                simdjson::error_message(error));
+  }
+
+  // simdjson reads past the end of the input, it needs a padded copy.
+  simdjson::padded_string payload_;
+  std::mutex mu_;
+  ondemand::parser parser_;
+  ondemand::document document_;
+};
+
+}  // namespace
+
+std::unique_ptr<functions::JsonBody::Impl> MakeJsonBodyImpl(
+    std::string_view payload) {
+  return std::make_unique<SimdjsonJsonBody>(payload);
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
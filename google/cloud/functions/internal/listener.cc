@@ -0,0 +1,194 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/listener.h"
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace asio = boost::asio;
+using tcp = boost::asio::ip::tcp;
+
+ListenEndpoint MakeTcpEndpoint(asio::ip::address const& address, int port) {
+  return tcp::endpoint(address, static_cast<std::uint16_t>(port));
+}
+
+ListenEndpoint MakeUnixEndpoint(std::string const& path) {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  asio::local::stream_protocol::endpoint endpoint;
+  // The endpoint rejects long paths with a less helpful `std::system_error`.
+  if (path.size() >= endpoint.capacity() - sizeof(sa_family_t)) {
+    throw std::invalid_argument("The Unix socket path (" + path +
+                                ") is too long.");
+  }
+  endpoint.path(path);
+  return endpoint;
+#else
+  throw std::invalid_argument(
+      "Unix domain sockets are not supported on this platform, --unix-socket"
+      " is not available.");
+#endif  // BOOST_ASIO_HAS_LOCAL_SOCKETS
+}
+
+namespace {
+
+bool IsTcp(asio::generic::stream_protocol const& protocol) {
+  return protocol.family() == tcp::v4().family() ||
+         protocol.family() == tcp::v6().family();
+}
+
+void SetBufferSizes(Acceptor& acceptor, ServerConfig const& config) {
+  if (config.receive_buffer_bytes != 0) {
+    acceptor.set_option(
+        asio::socket_base::receive_buffer_size(config.receive_buffer_bytes));
+  }
+  if (config.send_buffer_bytes != 0) {
+    acceptor.set_option(
+        asio::socket_base::send_buffer_size(config.send_buffer_bytes));
+  }
+}
+
+// Each connection would report the same error, only the first one is logged.
+void ReportSocketOptionError(char const* option, boost::system::error_code ec) {
+  static std::atomic<bool> reported{false};
+  if (reported.exchange(true)) return;
+  // TODO(#35) - maybe replace with Boost.Log
+  std::cerr << "cannot set " << option << " on accepted connections: "
+            << ec.message() << "\n";
+}
+
+int Backlog(ServerConfig const& config) {
+  if (config.listen_backlog != 0) return config.listen_backlog;
+  return asio::socket_base::max_listen_connections;
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+asio::local::stream_protocol::endpoint ToLocal(ListenEndpoint const& endpoint) {
+  asio::local::stream_protocol::endpoint local;
+  std::memcpy(local.data(), endpoint.data(), endpoint.size());
+  local.resize(endpoint.size());
+  return local;
+}
+
+/// Returns true if a server accepts connections on the socket at @p local.
+bool IsLive(Acceptor& acceptor,
+            asio::local::stream_protocol::endpoint const& local) {
+  // Connecting to a socket without a server fails immediately, while a
+  // server with a full backlog may not accept the connection for a while.
+  asio::local::stream_protocol::socket probe(acceptor.get_executor());
+  boost::system::error_code ec;
+  probe.open(asio::local::stream_protocol(), ec);
+  if (!ec) probe.non_blocking(true, ec);
+  if (!ec) probe.connect(local, ec);
+  return ec != asio::error::connection_refused;
+}
+#endif  // BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+}  // namespace
+
+void Listen(Acceptor& acceptor, ListenEndpoint const& endpoint,
+            ServerConfig const& config, bool reuse_port) {
+  acceptor.open(endpoint.protocol());
+  SetBufferSizes(acceptor, config);
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  if (endpoint.protocol().family() == AF_UNIX) {
+    // Binding fails if the socket exists, even if no process listens on it.
+    // Only remove stale sockets, never regular files.
+    auto const local = ToLocal(endpoint);
+    std::error_code ec;
+    if (std::filesystem::is_socket(local.path(), ec)) {
+      if (IsLive(acceptor, local)) {
+        throw std::runtime_error("The Unix socket (" + local.path() +
+                                 ") is in use by another server.");
+      }
+      std::filesystem::remove(local.path(), ec);
+    }
+    acceptor.bind(endpoint);
+    acceptor.listen(Backlog(config));
+    return;
+  }
+#endif  // BOOST_ASIO_HAS_LOCAL_SOCKETS
+  acceptor.set_option(asio::socket_base::reuse_address(true));
+  if (reuse_port) {
+#ifdef SO_REUSEPORT
+    using reuse_port_option =
+        asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+    acceptor.set_option(reuse_port_option(true));
+#else
+    throw std::runtime_error(
+        "multiple reactors require SO_REUSEPORT, which is not supported on"
+        " this platform");
+#endif  // SO_REUSEPORT
+  }
+  if (config.defer_accept.count() != 0) {
+#ifdef TCP_DEFER_ACCEPT
+    // Wake up the acceptor only once the client sends some data, or after the
+    // timeout. Idle connections never consume a session slot.
+    using defer_accept_option =
+        asio::detail::socket_option::integer<IPPROTO_TCP, TCP_DEFER_ACCEPT>;
+    acceptor.set_option(
+        defer_accept_option(static_cast<int>(config.defer_accept.count())));
+#else
+    // `ParseOptions()` rejects `--tcp-defer-accept` on these platforms.
+    throw std::runtime_error(
+        "TCP_DEFER_ACCEPT is not supported on this platform");
+#endif  // TCP_DEFER_ACCEPT
+  }
+  acceptor.bind(endpoint);
+  acceptor.listen(Backlog(config));
+}
+
+void ConfigureSocket(asio::generic::stream_protocol::socket& socket,
+                     ServerConfig const& config) {
+  if (!config.unix_socket.empty()) return;
+  boost::system::error_code ec;
+  socket.set_option(tcp::no_delay(config.tcp_nodelay), ec);
+  if (ec) ReportSocketOptionError("TCP_NODELAY", ec);
+  // `ParseOptions()` rejects `--tcp-quickack` where it is not supported.
+#ifdef TCP_QUICKACK
+  if (config.tcp_quickack) {
+    // The kernel may return to delayed ACKs later in the connection, this
+    // only avoids them for the first request.
+    using quickack_option =
+        asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>;
+    socket.set_option(quickack_option(true), ec);
+    if (ec) ReportSocketOptionError("TCP_QUICKACK", ec);
+  }
+#endif  // TCP_QUICKACK
+}
+
+int ListenPort(ListenEndpoint const& endpoint) {
+  if (!IsTcp(endpoint.protocol())) return 0;
+  tcp::endpoint address;
+  std::memcpy(address.data(), endpoint.data(), endpoint.size());
+  address.resize(endpoint.size());
+  return address.port();
+}
+
+UnixSocketRemover::~UnixSocketRemover() {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  if (endpoint_.protocol().family() != AF_UNIX) return;
+  std::error_code ec;
+  std::filesystem::remove(ToLocal(endpoint_).path(), ec);
+#endif  // BOOST_ASIO_HAS_LOCAL_SOCKETS
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
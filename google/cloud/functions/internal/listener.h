@@ -0,0 +1,101 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_LISTENER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_LISTENER_H
+
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/version.h"
+#include <boost/asio/basic_socket_acceptor.hpp>
+#include <boost/asio/generic/stream_protocol.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <string>
+#include <utility>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * The listening socket, and its endpoint.
+ *
+ * The server listens on a TCP port, or on a Unix domain socket. Both use the
+ * generic stream protocol, and the accepted sockets are `SessionSocket`s.
+ */
+using ListenEndpoint = boost::asio::generic::stream_protocol::endpoint;
+using Acceptor =
+    boost::asio::basic_socket_acceptor<boost::asio::generic::stream_protocol>;
+
+/// Returns the TCP endpoint for @p address and @p port.
+ListenEndpoint MakeTcpEndpoint(boost::asio::ip::address const& address,
+                               int port);
+
+/**
+ * Returns the endpoint for the Unix domain socket at @p path.
+ *
+ * @throws std::invalid_argument if the platform does not support Unix domain
+ *     sockets, or the path is too long.
+ */
+ListenEndpoint MakeUnixEndpoint(std::string const& path);
+
+/**
+ * Opens @p acceptor, binds it to @p endpoint, and starts listening.
+ *
+ * With @p reuse_port multiple acceptors can listen on the same TCP port, and
+ * the kernel balances the new connections across them. A Unix domain socket
+ * left behind by a previous server is removed before binding, unless a server
+ * still accepts connections on it.
+ *
+ * The listen backlog, socket buffer sizes, and `TCP_DEFER_ACCEPT` come from
+ * @p config. The buffer sizes are set on the listening socket, so the accepted
+ * sockets inherit them before the TCP handshake negotiates the window scale.
+ */
+void Listen(Acceptor& acceptor, ListenEndpoint const& endpoint,
+            ServerConfig const& config, bool reuse_port);
+
+/**
+ * Applies the per-connection options from @p config to an accepted socket.
+ *
+ * Sets `TCP_NODELAY` and `TCP_QUICKACK`, unless the server listens on a Unix
+ * domain socket. The connection works (maybe slower) without these options,
+ * so failures are not fatal. The first failure is logged.
+ */
+void ConfigureSocket(boost::asio::generic::stream_protocol::socket& socket,
+                     ServerConfig const& config);
+
+/// The TCP port of @p endpoint, 0 for Unix domain sockets.
+int ListenPort(ListenEndpoint const& endpoint);
+
+/**
+ * Removes the Unix domain socket of a server once the server stops.
+ *
+ * Create it only after `Listen()` succeeds, so a failed server never removes
+ * the socket of another server. Does nothing for TCP endpoints.
+ */
+class UnixSocketRemover {
+ public:
+  explicit UnixSocketRemover(ListenEndpoint endpoint)
+      : endpoint_(std::move(endpoint)) {}
+  ~UnixSocketRemover();
+
+  UnixSocketRemover(UnixSocketRemover const&) = delete;
+  UnixSocketRemover& operator=(UnixSocketRemover const&) = delete;
+
+ private:
+  ListenEndpoint endpoint_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_LISTENER_H
@@ -0,0 +1,204 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/framework_impl.h"
+#include "google/cloud/functions/framework.h"
+#include <benchmark/benchmark.h>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace asio = ::boost::asio;
+namespace http = ::boost::beast::http;
+using tcp = ::boost::asio::ip::tcp;
+
+// Each iteration sends one small request over a keep-alive connection and
+// reads the response. The function does no work, so this measures the
+// framework and the kernel socket path. The client and the server run on the
+// same machine, as with a sidecar proxy. `CPU` is the client CPU time only.
+//
+// BM_Response1KiB measures the latency of each 1 KiB response, with
+// `--tcp-nodelay=false` and with the default `--tcp-nodelay=true`. Nagle's
+// algorithm holds the body until the client's delayed ACK for the header,
+// ~40ms on Linux.
+
+functions::Function TrivialFunction() {
+  return functions::MakeFunction([](functions::HttpRequest const&) {
+    return functions::HttpResponse{}.set_payload("ok");
+  });
+}
+
+/// Runs the framework in the background, serving @p function.
+class TestServer {
+ public:
+  explicit TestServer(std::vector<std::string> args,
+                      functions::Function function = TrivialFunction())
+      : args_(std::move(args)) {
+    std::promise<int> port_p;
+    auto port_f = port_p.get_future();
+    auto run = [this, f = std::move(function),
+                p = std::move(port_p)]() mutable {
+      std::vector<char const*> argv;
+      for (auto const& a : args_) argv.push_back(a.c_str());
+      return RunForTest(
+          static_cast<int>(argv.size()), argv.data(), std::move(f),
+          [this] { return shutdown_.load(); },
+          [&p](int port) { p.set_value(port); });
+    };
+    done_ = std::async(std::launch::async, std::move(run));
+    port_ = port_f.get();
+  }
+
+  int port() const { return port_; }
+
+  /// Stops the server, @p wake must open a connection to it.
+  template <typename Wake>
+  void Stop(Wake&& wake) {
+    shutdown_.store(true);
+    try {
+      wake();
+    } catch (...) {
+    }
+    done_.get();
+  }
+
+ private:
+  std::vector<std::string> args_;
+  std::atomic<bool> shutdown_{false};
+  std::future<int> done_;
+  int port_ = 0;
+};
+
+template <typename Socket>
+void RoundTrips(benchmark::State& state, Socket& socket) {
+  std::string const request =
+      "GET /benchmark HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  boost::beast::flat_buffer buffer;
+  for (auto _ : state) {
+    asio::write(socket, asio::buffer(request));
+    http::response<http::string_body> response;
+    http::read(socket, buffer, response);
+    benchmark::DoNotOptimize(response);
+  }
+}
+
+char const* Engine(benchmark::State const& state) {
+  return state.range(0) == 0 ? "--session-engine=threads"
+                             : "--session-engine=async";
+}
+
+void BM_RoundTripTcp(benchmark::State& state) {
+  TestServer server({"unused", "--address=127.0.0.1", "--port=0",
+                     Engine(state)});
+  auto const endpoint =
+      tcp::endpoint(asio::ip::make_address("127.0.0.1"),
+                    static_cast<std::uint16_t>(server.port()));
+  asio::io_context ioc;
+  {
+    tcp::socket socket(ioc);
+    socket.connect(endpoint);
+    // Match the default configuration of most HTTP clients and proxies.
+    socket.set_option(tcp::no_delay(true));
+    RoundTrips(state, socket);
+  }
+  server.Stop([&] { tcp::socket(ioc).connect(endpoint); });
+}
+BENCHMARK(BM_RoundTripTcp)->ArgName("async")->Arg(0)->Arg(1)->UseRealTime();
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+void BM_RoundTripUnix(benchmark::State& state) {
+  using local = asio::local::stream_protocol;
+  auto const path =
+      (std::filesystem::temp_directory_path() /
+       ("listener-benchmark-" + std::to_string(std::random_device{}())))
+          .string();
+  TestServer server({"unused", "--unix-socket=" + path, Engine(state)});
+  auto const endpoint = local::endpoint(path);
+  asio::io_context ioc;
+  {
+    local::socket socket(ioc);
+    socket.connect(endpoint);
+    RoundTrips(state, socket);
+  }
+  server.Stop([&] { local::socket(ioc).connect(endpoint); });
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_RoundTripUnix)->ArgName("async")->Arg(0)->Arg(1)->UseRealTime();
+#endif  // BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+// Sends the header and a 1 KiB body as separate writes, like most streaming
+// functions. Without `TCP_NODELAY` the body waits until the client ACKs the
+// header, and the client delays that ACK, hoping to piggyback it on data.
+void BM_Response1KiB(benchmark::State& state) {
+  auto const nodelay = state.range(0) != 0;
+  TestServer server(
+      {"unused", "--address=127.0.0.1", "--port=0",
+       nodelay ? "--tcp-nodelay=true" : "--tcp-nodelay=false"},
+      functions::MakeFunction([](functions::HttpRequest const&,
+                                 functions::HttpResponseWriter writer) {
+        writer.SendHeaders();
+        writer.Write(std::string(1024, 'x'));
+      }));
+  auto const endpoint =
+      tcp::endpoint(asio::ip::make_address("127.0.0.1"),
+                    static_cast<std::uint16_t>(server.port()));
+  asio::io_context ioc;
+  std::vector<double> latencies;
+  {
+    tcp::socket socket(ioc);
+    socket.connect(endpoint);
+    socket.set_option(tcp::no_delay(true));
+    std::string const request =
+        "GET /benchmark HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    boost::beast::flat_buffer buffer;
+    for (auto _ : state) {
+      auto const start = std::chrono::steady_clock::now();
+      asio::write(socket, asio::buffer(request));
+      http::response<http::string_body> response;
+      http::read(socket, buffer, response);
+      auto const elapsed = std::chrono::steady_clock::now() - start;
+      latencies.push_back(
+          std::chrono::duration<double, std::micro>(elapsed).count());
+      benchmark::DoNotOptimize(response);
+    }
+  }
+  server.Stop([&] { tcp::socket(ioc).connect(endpoint); });
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    auto const n = static_cast<double>(latencies.size() - 1);
+    return latencies[static_cast<std::size_t>(p * n)];
+  };
+  state.counters["p50_us"] = percentile(0.50);
+  state.counters["p99_us"] = percentile(0.99);
+}
+BENCHMARK(BM_Response1KiB)->ArgName("nodelay")->Arg(0)->Arg(1)->UseRealTime();
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
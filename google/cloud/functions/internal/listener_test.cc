@@ -0,0 +1,174 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/listener.h"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <gmock/gmock.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace asio = boost::asio;
+
+TEST(ListenerTest, TcpPort) {
+  asio::io_context ioc;
+  Acceptor acceptor(ioc);
+  Listen(acceptor, MakeTcpEndpoint(asio::ip::make_address("127.0.0.1"), 0),
+         ServerConfig{}, /*reuse_port=*/false);
+  EXPECT_NE(ListenPort(acceptor.local_endpoint()), 0);
+  EXPECT_EQ(ListenPort(MakeTcpEndpoint(asio::ip::make_address("::1"), 8080)),
+            8080);
+}
+
+TEST(ListenerTest, SocketOptions) {
+  ServerConfig config;
+  config.receive_buffer_bytes = 64 * 1024;
+  config.send_buffer_bytes = 64 * 1024;
+  config.listen_backlog = 16;
+  config.tcp_nodelay = false;
+#ifdef TCP_DEFER_ACCEPT
+  config.defer_accept = std::chrono::seconds(5);
+#endif  // TCP_DEFER_ACCEPT
+  asio::io_context ioc;
+  Acceptor acceptor(ioc);
+  Listen(acceptor, MakeTcpEndpoint(asio::ip::make_address("127.0.0.1"), 0),
+         config, /*reuse_port=*/false);
+  // The kernel may round up (Linux doubles) the requested buffer sizes.
+  asio::socket_base::receive_buffer_size receive;
+  acceptor.get_option(receive);
+  EXPECT_GE(receive.value(), config.receive_buffer_bytes);
+  asio::socket_base::send_buffer_size send;
+  acceptor.get_option(send);
+  EXPECT_GE(send.value(), config.send_buffer_bytes);
+
+  auto const port =
+      static_cast<std::uint16_t>(ListenPort(acceptor.local_endpoint()));
+  asio::ip::tcp::socket client(ioc);
+  client.connect(
+      asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), port));
+  // With TCP_DEFER_ACCEPT the connection is accepted only once it has data.
+  asio::write(client, asio::buffer(std::string("GET / HTTP/1.1\r\n")));
+  auto socket = acceptor.accept();
+  ConfigureSocket(socket, config);
+  asio::ip::tcp::no_delay no_delay;
+  socket.get_option(no_delay);
+  EXPECT_FALSE(no_delay.value());
+
+  config.tcp_nodelay = true;
+  ConfigureSocket(socket, config);
+  socket.get_option(no_delay);
+  EXPECT_TRUE(no_delay.value());
+}
+
+TEST(ListenerTest, SocketOptionErrors) {
+  std::ostringstream captured;
+  auto* saved = std::cerr.rdbuf(captured.rdbuf());
+  ServerConfig config;
+  config.tcp_quickack = true;
+  asio::io_context ioc;
+  // The options cannot be set on a closed socket, the error is logged once.
+  asio::generic::stream_protocol::socket closed(ioc);
+  ConfigureSocket(closed, config);
+  ConfigureSocket(closed, config);
+  std::cerr.rdbuf(saved);
+  auto const log = captured.str();
+  EXPECT_THAT(log, ::testing::StartsWith("cannot set TCP_NODELAY"));
+  EXPECT_EQ(log.find('\n'), log.size() - 1);
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+std::filesystem::path TempPath() {
+  return std::filesystem::temp_directory_path() /
+         ("listener-test-" + std::to_string(std::random_device{}()));
+}
+
+TEST(ListenerTest, UnixSocket) {
+  auto const path = TempPath().string();
+  auto const endpoint = MakeUnixEndpoint(path);
+  EXPECT_EQ(ListenPort(endpoint), 0);
+  asio::io_context ioc;
+  {
+    Acceptor acceptor(ioc);
+    Listen(acceptor, endpoint, ServerConfig{}, /*reuse_port=*/false);
+    EXPECT_TRUE(std::filesystem::is_socket(path));
+  }
+  // The socket from the previous server is replaced.
+  Acceptor acceptor(ioc);
+  EXPECT_NO_THROW(
+      Listen(acceptor, endpoint, ServerConfig{}, /*reuse_port=*/false));
+  std::filesystem::remove(path);
+}
+
+TEST(ListenerTest, UnixSocketInUse) {
+  auto const path = TempPath().string();
+  auto const endpoint = MakeUnixEndpoint(path);
+  asio::io_context ioc;
+  Acceptor live(ioc);
+  Listen(live, endpoint, ServerConfig{}, /*reuse_port=*/false);
+  // The socket of a running server is never replaced.
+  Acceptor acceptor(ioc);
+  EXPECT_THROW(
+      Listen(acceptor, endpoint, ServerConfig{}, /*reuse_port=*/false),
+      std::runtime_error);
+  EXPECT_TRUE(std::filesystem::is_socket(path));
+  std::filesystem::remove(path);
+}
+
+TEST(ListenerTest, UnixSocketRemover) {
+  auto const path = TempPath().string();
+  auto const endpoint = MakeUnixEndpoint(path);
+  asio::io_context ioc;
+  {
+    Acceptor acceptor(ioc);
+    Listen(acceptor, endpoint, ServerConfig{}, /*reuse_port=*/false);
+    UnixSocketRemover const remover(endpoint);
+    EXPECT_TRUE(std::filesystem::is_socket(path));
+  }
+  EXPECT_FALSE(std::filesystem::exists(path));
+
+  // TCP endpoints are ignored.
+  UnixSocketRemover const tcp(
+      MakeTcpEndpoint(asio::ip::make_address("127.0.0.1"), 8080));
+}
+
+TEST(ListenerTest, UnixSocketKeepsRegularFiles) {
+  auto const path = TempPath().string();
+  std::ofstream(path) << "not a socket\n";
+  asio::io_context ioc;
+  Acceptor acceptor(ioc);
+  EXPECT_THROW(Listen(acceptor, MakeUnixEndpoint(path), ServerConfig{},
+                      /*reuse_port=*/false),
+               std::exception);
+  EXPECT_TRUE(std::filesystem::is_regular_file(path));
+  std::filesystem::remove(path);
+}
+
+TEST(ListenerTest, UnixSocketPathTooLong) {
+  EXPECT_THROW(MakeUnixEndpoint("/tmp/" + std::string(200, 'a')),
+               std::invalid_argument);
+}
+#endif  // BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,228 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/output_flusher.h"
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#if __has_include(<stdio_ext.h>)
+#include <stdio_ext.h>
+#define FUNCTIONS_FRAMEWORK_CPP_HAVE_FPENDING 1
+#endif  // __has_include(<stdio_ext.h>)
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// Captured output is drained once it reaches this size, even if no function
+// completes in the thread.
+std::size_t constexpr kMaxCaptureSize = 64 * 1024;
+
+struct CaptureBuffer {
+  // The original stream buffer, as the stream may be restored by the time the
+  // thread exits.
+  std::streambuf* target = nullptr;
+  std::string data;
+
+  CaptureBuffer() = default;
+  CaptureBuffer(CaptureBuffer const&) = delete;
+  CaptureBuffer& operator=(CaptureBuffer const&) = delete;
+  ~CaptureBuffer() { Drain(); }
+
+  void Drain() {
+    if (data.empty() || target == nullptr) return;
+    target->sputn(data.data(), static_cast<std::streamsize>(data.size()));
+    target->pubsync();
+    data.clear();
+  }
+};
+
+struct ThreadCapture {
+  // Only the threads that run functions capture their output, any other
+  // thread would hold its output until the thread exits.
+  bool enabled = false;
+  CaptureBuffer out;
+  CaptureBuffer err;
+};
+
+ThreadCapture& GetThreadCapture() {
+  thread_local ThreadCapture capture;
+  return capture;
+}
+
+// Returns true if the C streams may have buffered output. The C++ streams are
+// synchronized with them by default, but applications may use both.
+bool StdioPending() {
+#if FUNCTIONS_FRAMEWORK_CPP_HAVE_FPENDING
+  return __fpending(stdout) != 0 || __fpending(stderr) != 0;
+#else
+  return true;
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_FPENDING
+}
+
+void FlushStdio() {
+  std::fflush(stdout);
+  std::fflush(stderr);
+}
+
+void FlushStreams() {
+  std::cout << std::flush;
+  std::clog << std::flush;
+  std::cerr << std::flush;
+}
+
+/// Replaces the buffer of a standard stream while it is alive.
+class Streambuf : public std::streambuf {
+ public:
+  Streambuf(std::ostream& os, OutputMode mode, std::atomic<bool>& dirty,
+            bool is_error)
+      : os_(os),
+        target_(os.rdbuf()),
+        mode_(mode),
+        dirty_(dirty),
+        is_error_(is_error) {
+    os_.rdbuf(this);
+  }
+  ~Streambuf() override { os_.rdbuf(target_); }
+
+  Streambuf(Streambuf const&) = delete;
+  Streambuf& operator=(Streambuf const&) = delete;
+
+ protected:
+  // This buffer is unbuffered, every write reaches `xsputn()` or `overflow()`.
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    auto const c = traits_type::to_char_type(ch);
+    return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+  }
+
+  std::streamsize xsputn(char const* s, std::streamsize count) override {
+    if (Capturing()) {
+      auto& capture = GetThreadCapture();
+      auto& buffer = is_error_ ? capture.err : capture.out;
+      buffer.target = target_;
+      buffer.data.append(s, static_cast<std::size_t>(count));
+      if (buffer.data.size() >= kMaxCaptureSize) buffer.Drain();
+      return count;
+    }
+    auto const n = target_->sputn(s, count);
+    // Set the flag after the output reaches the target, so any flush that
+    // observes the flag also flushes this output.
+    dirty_.store(true, std::memory_order_relaxed);
+    return n;
+  }
+
+  int sync() override {
+    // Captured output is drained before the response is sent.
+    if (Capturing()) return 0;
+    return target_->pubsync();
+  }
+
+ private:
+  bool Capturing() const {
+    return mode_ == OutputMode::kCapture && GetThreadCapture().enabled;
+  }
+
+  std::ostream& os_;
+  std::streambuf* target_;
+  OutputMode mode_;
+  std::atomic<bool>& dirty_;
+  bool is_error_;
+};
+
+/// The replacement stream buffers, shared by all the flushers.
+struct Installation {
+  std::mutex mu;
+  std::size_t owners = 0;
+  OutputMode mode = OutputMode::kAlways;
+  std::atomic<bool> dirty{false};
+  std::unique_ptr<Streambuf> out;
+  std::unique_ptr<Streambuf> log;
+  std::unique_ptr<Streambuf> err;
+};
+
+// Never destroyed, a server may still be running while the static objects are
+// destroyed.
+Installation& GetInstallation() {
+  static auto* const kInstallation = new Installation;
+  return *kInstallation;
+}
+
+}  // namespace
+
+OutputFlusher::OutputFlusher(OutputMode mode) : mode_(mode) {
+  if (mode_ == OutputMode::kAlways) return;
+  auto& installation = GetInstallation();
+  std::lock_guard<std::mutex> lk(installation.mu);
+  if (installation.owners != 0 && installation.mode != mode_) {
+    mode_ = OutputMode::kAlways;
+    return;
+  }
+  if (installation.owners++ != 0) return;
+  installation.mode = mode_;
+  installation.out = std::make_unique<Streambuf>(std::cout, mode_,
+                                                 installation.dirty, false);
+  installation.log = std::make_unique<Streambuf>(std::clog, mode_,
+                                                 installation.dirty, true);
+  installation.err = std::make_unique<Streambuf>(std::cerr, mode_,
+                                                 installation.dirty, true);
+}
+
+OutputFlusher::~OutputFlusher() {
+  if (mode_ == OutputMode::kAlways) return;
+  // Drain any output captured by this thread before restoring the streams.
+  if (mode_ == OutputMode::kCapture) Flush();
+  auto& installation = GetInstallation();
+  std::lock_guard<std::mutex> lk(installation.mu);
+  if (--installation.owners != 0) return;
+  // Restore the streams in the reverse order.
+  installation.err.reset();
+  installation.log.reset();
+  installation.out.reset();
+}
+
+void OutputFlusher::Flush() {
+  switch (mode_) {
+    case OutputMode::kAlways:
+      FlushStreams();
+      return;
+    case OutputMode::kOnOutput: {
+      auto& dirty = GetInstallation().dirty;
+      // Avoid writing to the (shared) flag unless it is set.
+      if (dirty.load(std::memory_order_relaxed) && dirty.exchange(false)) {
+        FlushStreams();
+      }
+      if (StdioPending()) FlushStdio();
+      return;
+    }
+    case OutputMode::kCapture: {
+      auto& capture = GetThreadCapture();
+      capture.out.Drain();
+      capture.err.Drain();
+      // Any further output from this thread is captured.
+      capture.enabled = true;
+      if (StdioPending()) FlushStdio();
+      return;
+    }
+  }
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
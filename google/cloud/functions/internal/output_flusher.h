@@ -0,0 +1,67 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_OUTPUT_FLUSHER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_OUTPUT_FLUSHER_H
+
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/version.h"
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Flushes the function output before each response is sent.
+ *
+ * The application may be shutdown as soon as the HTTP response is sent, any
+ * output still buffered at that point is lost. `Flush()` must be called in the
+ * thread that ran the function, before the response is sent.
+ *
+ * In `OutputMode::kAlways`, `Flush()` flushes the standard streams and does not
+ * change them otherwise. The other modes replace the `std::cout`, `std::clog`,
+ * and `std::cerr` stream buffers:
+ * - In `OutputMode::kOnOutput`, the default, the replacement forwards all the
+ *   output to the original buffers, and records that some output happened.
+ *   `Flush()` is a no-op unless there was some output since the last flush,
+ *   or there is pending output in the C `stdout` or `stderr` streams.
+ * - In `OutputMode::kCapture` the output of each thread that calls `Flush()`
+ *   is appended to a buffer owned by that thread, without any locking.
+ *   `Flush()` drains the calling thread's buffer with a single write. Explicit
+ *   flushes (e.g. `std::endl`) are deferred until then. The output of any
+ *   other thread is forwarded to the original buffers.
+ *
+ * The replacement buffers are shared by all the flushers in the process. The
+ * first flusher installs them, and the last one to be destroyed restores the
+ * original buffers, so flushers may be destroyed in any order. A flusher that
+ * requests a different mode than the installed one falls back to
+ * `OutputMode::kAlways`.
+ */
+class OutputFlusher {
+ public:
+  explicit OutputFlusher(OutputMode mode);
+  ~OutputFlusher();
+
+  OutputFlusher(OutputFlusher const&) = delete;
+  OutputFlusher& operator=(OutputFlusher const&) = delete;
+
+  void Flush();
+
+ private:
+  OutputMode mode_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_OUTPUT_FLUSHER_H
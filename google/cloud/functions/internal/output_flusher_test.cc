@@ -0,0 +1,124 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/output_flusher.h"
+#include <gmock/gmock.h>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+/// A string buffer that counts the calls to `sync()`.
+class CountingBuf : public std::stringbuf {
+ public:
+  int syncs() const { return syncs_; }
+
+ protected:
+  int sync() override {
+    ++syncs_;
+    return std::stringbuf::sync();
+  }
+
+ private:
+  int syncs_ = 0;
+};
+
+/// Redirects `std::cout` to a `CountingBuf` during the test.
+class OutputFlusherTest : public ::testing::Test {
+ protected:
+  void SetUp() override { saved_ = std::cout.rdbuf(&out_); }
+  void TearDown() override { std::cout.rdbuf(saved_); }
+
+  CountingBuf out_;
+  std::streambuf* saved_ = nullptr;
+};
+
+TEST_F(OutputFlusherTest, Always) {
+  OutputFlusher flusher(OutputMode::kAlways);
+  EXPECT_EQ(std::cout.rdbuf(), &out_);
+  flusher.Flush();
+  EXPECT_GT(out_.syncs(), 0);
+}
+
+TEST_F(OutputFlusherTest, OnOutput) {
+  {
+    OutputFlusher flusher(OutputMode::kOnOutput);
+    EXPECT_NE(std::cout.rdbuf(), &out_);
+    flusher.Flush();
+    EXPECT_EQ(out_.syncs(), 0);
+
+    std::cout << "Hello " << 42 << "\n";
+    EXPECT_EQ(out_.str(), "Hello 42\n");
+    flusher.Flush();
+    auto const syncs = out_.syncs();
+    EXPECT_GT(syncs, 0);
+    // Without more output, there is nothing to flush.
+    flusher.Flush();
+    EXPECT_EQ(out_.syncs(), syncs);
+  }
+  EXPECT_EQ(std::cout.rdbuf(), &out_);
+}
+
+TEST_F(OutputFlusherTest, Capture) {
+  {
+    OutputFlusher flusher(OutputMode::kCapture);
+    // The thread captures its output once it flushes a response.
+    std::cout << "before ";
+    EXPECT_EQ(out_.str(), "before ");
+    flusher.Flush();
+    std::cout << "first " << std::flush;
+    std::cout << "request" << std::endl;
+    EXPECT_EQ(out_.str(), "before ");
+    // The output from other threads is not captured.
+    std::thread([] { std::cout << "other thread\n"; }).join();
+    EXPECT_EQ(out_.str(), "before other thread\n");
+    flusher.Flush();
+    EXPECT_EQ(out_.str(), "before other thread\nfirst request\n");
+
+    std::cout << "pending";
+  }
+  // The destructor drains the output captured in the calling thread.
+  EXPECT_EQ(out_.str(), "before other thread\nfirst request\npending");
+  EXPECT_EQ(std::cout.rdbuf(), &out_);
+}
+
+TEST_F(OutputFlusherTest, SharedBuffers) {
+  auto first = std::make_unique<OutputFlusher>(OutputMode::kOnOutput);
+  auto* installed = std::cout.rdbuf();
+  EXPECT_NE(installed, &out_);
+  auto second = std::make_unique<OutputFlusher>(OutputMode::kOnOutput);
+  EXPECT_EQ(std::cout.rdbuf(), installed);
+  // A flusher for a different mode does not change the streams.
+  auto always = std::make_unique<OutputFlusher>(OutputMode::kCapture);
+  EXPECT_EQ(std::cout.rdbuf(), installed);
+
+  // The streams are restored by the last flusher, in any order.
+  first.reset();
+  always.reset();
+  EXPECT_EQ(std::cout.rdbuf(), installed);
+  std::cout << "Hello";
+  second->Flush();
+  EXPECT_EQ(out_.str(), "Hello");
+  EXPECT_GT(out_.syncs(), 0);
+  second.reset();
+  EXPECT_EQ(std::cout.rdbuf(), &out_);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
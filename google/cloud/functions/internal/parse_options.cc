@@ -13,11 +13,16 @@
 // limitations under the License.
 
 #include "google/cloud/functions/internal/parse_options.h"
+#include "google/cloud/functions/internal/static_headers.h"
+#include <boost/asio/detail/socket_types.hpp>
 #include <boost/program_options.hpp>
+#include <cctype>
 #include <cstdint>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -25,6 +30,26 @@ namespace po = boost::program_options;
 
 auto constexpr kDefaultPort = 8080;
 
+namespace {
+
+// The socket tuning options can also be set via environment variables, e.g.
+// `FUNCTION_TCP_NODELAY=false`, as the deployment may not control the
+// command-line. The command-line overrides the environment.
+std::string EnvironmentOption(std::string const& variable) {
+  for (auto const* name :
+       {"listen-backlog", "socket-receive-buffer", "socket-send-buffer",
+        "tcp-nodelay", "tcp-quickack", "tcp-defer-accept"}) {
+    std::string env = "FUNCTION_";
+    for (auto const* c = name; *c != '\0'; ++c) {
+      env.push_back(*c == '-' ? '_' : static_cast<char>(std::toupper(*c)));
+    }
+    if (variable == env) return name;
+  }
+  return {};
+}
+
+}  // namespace
+
 po::variables_map ParseOptions(int argc, char const* const argv[]) {
   // Initialize the default port with the value from the "PORT" environment
   // variable or with 8080.
@@ -53,25 +78,313 @@ po::variables_map ParseOptions(int argc, char const* const argv[]) {
        " See https://github.com/GoogleCloudPlatform/functions-framework for"
        " additional information.")
       //
-      ("port", po::value<int>()->default_value(port), "set listening port");
+      ("port", po::value<int>()->default_value(port), "set listening port")
+      //
+      ("unix-socket", po::value<std::string>(),
+       "listen on this Unix domain socket path instead of --address and"
+       " --port, e.g. to receive requests from a sidecar proxy")
+      //
+      ("listen-backlog", po::value<int>()->default_value(0),
+       "the maximum number of connections waiting to be accepted, 0 uses the"
+       " system maximum. Also set via FUNCTION_LISTEN_BACKLOG")
+      //
+      ("socket-receive-buffer", po::value<int>()->default_value(0),
+       "the SO_RCVBUF size for connections, in bytes. 0 keeps the system"
+       " default. Also set via FUNCTION_SOCKET_RECEIVE_BUFFER")
+      //
+      ("socket-send-buffer", po::value<int>()->default_value(0),
+       "the SO_SNDBUF size for connections, in bytes. 0 keeps the system"
+       " default. Also set via FUNCTION_SOCKET_SEND_BUFFER")
+      //
+      ("tcp-nodelay",
+       po::value<bool>()->default_value(true)->implicit_value(true),
+       "disable Nagle's algorithm on connections, use `--tcp-nodelay=false` to"
+       " enable it. Also set via FUNCTION_TCP_NODELAY")
+      //
+      ("tcp-quickack",
+       po::value<bool>()->default_value(false)->implicit_value(true),
+       "set TCP_QUICKACK on new connections, so the first request is"
+       " acknowledged without delay (Linux only). Also set via"
+       " FUNCTION_TCP_QUICKACK")
+      //
+      ("tcp-defer-accept", po::value<int>()->default_value(0),
+       "accept connections only once the client sends data, or after N"
+       " seconds. 0 disables TCP_DEFER_ACCEPT (Linux only). Also set via"
+       " FUNCTION_TCP_DEFER_ACCEPT")
+      //
+      ("session-engine", po::value<std::string>()->default_value("threads"),
+       "how to handle connections: `threads` runs each connection in its own"
+       " thread, `async` multiplexes all connections over --io-threads"
+       " threads")
+      //
+      ("io-threads", po::value<int>()->default_value(0),
+       "number of threads running the `async` session engine, 0 uses one"
+       " thread per core")
+      //
+      ("handler-threads", po::value<int>()->default_value(0),
+       "number of threads running the function, 0 runs the function in the"
+       " thread that reads the request")
+      //
+      ("handler-queue-size", po::value<int>()->default_value(64),
+       "maximum number of requests waiting for a --handler-threads thread,"
+       " additional requests receive a `503 Service Unavailable` response")
+      //
+      ("reactors", po::value<int>()->default_value(1),
+       "number of independent reactors for the `async` session engine, each"
+       " with its own `SO_REUSEPORT` listener, I/O thread, and"
+       " --handler-threads threads. 0 uses one reactor per core")
+      //
+      ("max-sessions", po::value<int>()->default_value(160),
+       "maximum number of concurrent connections, 0 disables the limit")
+      //
+      ("max-queued-sessions", po::value<int>()->default_value(0),
+       "maximum number of accepted connections waiting for one of the"
+       " --max-sessions slots")
+      //
+      ("session-limit-action", po::value<std::string>()->default_value("pause"),
+       "what to do with new connections when the --max-queued-sessions queue"
+       " is full: `pause` stops accepting connections until a session"
+       " completes, `reject` closes them with a `503 Service Unavailable`"
+       " response")
+      //
+      ("max-concurrent-requests", po::value<int>()->default_value(0),
+       "maximum number of concurrent function invocations, 0 disables the"
+       " limit. Set it to the container concurrency, e.g. 80 on Cloud Run,"
+       " so overload cannot exhaust the container memory")
+      //
+      ("max-queued-requests", po::value<int>()->default_value(0),
+       "maximum number of requests waiting, in FIFO order, for one of the"
+       " --max-concurrent-requests slots. Additional requests are rejected"
+       " with the --overload-status code")
+      //
+      ("request-queue-timeout", po::value<int>()->default_value(0),
+       "reject requests that wait longer than N seconds in the"
+       " --max-queued-requests queue, with the --overload-status code. 0"
+       " disables the timeout")
+      //
+      ("adaptive-concurrency", po::bool_switch(),
+       "adjust the concurrency limit from the observed function latency, up"
+       " to --max-concurrent-requests (or 1000 if that is 0). Requests over"
+       " the current limit wait in the --max-queued-requests queue, or are"
+       " rejected")
+      //
+      ("overload-status", po::value<int>()->default_value(503),
+       "the status code for requests rejected due to overload: 429 (Too Many"
+       " Requests) or 503 (Service Unavailable). Both include `Retry-After`")
+      //
+      ("static-header", po::value<std::vector<std::string>>()->composing(),
+       "add a `Name: value` header to every response, may be repeated")
+      //
+      ("date-header", po::bool_switch(),
+       "add a `Date` header to every response")
+      //
+      ("compression", po::bool_switch(),
+       "compress response bodies with gzip or deflate, as negotiated via"
+       " `Accept-Encoding`")
+      //
+      ("compression-level", po::value<int>()->default_value(6),
+       "the compression level, from 1 (fastest) to 9 (smallest responses)")
+      //
+      ("compression-min-bytes", po::value<int>()->default_value(1024),
+       "only compress response bodies of at least this size")
+      //
+      ("compression-type", po::value<std::vector<std::string>>()->composing(),
+       "only compress responses with this media type, may be repeated."
+       " `text/*` matches any text type. The default includes `text/*`,"
+       " `application/json`, `application/javascript`, `application/xml`,"
+       " and `image/svg+xml`")
+      //
+      ("output-flush", po::value<std::string>()->default_value("on-output"),
+       "how to flush the function output before each response: `always`"
+       " flushes the standard streams, `on-output` flushes them only if there"
+       " was some output, `capture` buffers the output of each thread and"
+       " writes it once per request. Both `on-output` and `capture` replace"
+       " the `std::cout`, `std::clog` and `std::cerr` stream buffers while"
+       " the server runs")
+      //
+      ("max-body-bytes",
+       po::value<std::int64_t>()->default_value(1024 * 1024),
+       "maximum size of a request body, larger requests receive a `413"
+       " Payload Too Large` response. 0 disables the limit")
+      //
+      ("decompress-requests", po::bool_switch(),
+       "decode request bodies sent with `Content-Encoding: gzip` or"
+       " `deflate`, before the function receives them. Other codings are"
+       " rejected with `415 Unsupported Media Type`")
+      //
+      ("max-decompressed-body-bytes",
+       po::value<std::int64_t>()->default_value(10 * 1024 * 1024),
+       "maximum size of a decoded request body, larger requests receive a"
+       " `413 Payload Too Large` response. 0 disables the limit")
+      //
+      ("max-header-bytes", po::value<int>()->default_value(8 * 1024),
+       "maximum size of the request line and header fields, larger requests"
+       " receive a `431 Request Header Fields Too Large` response. 0 disables"
+       " the limit")
+      //
+      ("h2c", po::bool_switch(),
+       "accept HTTP/2 cleartext connections, with prior knowledge or via"
+       " `Upgrade: h2c`. Each HTTP/2 stream is a separate request")
+      //
+      ("stats-log-interval", po::value<int>()->default_value(0),
+       "log the server stats every N seconds, 0 disables the logs")
+      //
+      ("handle-signals",
+       po::value<bool>()->default_value(true)->implicit_value(true),
+       "drain the server on SIGTERM or SIGINT. Use `--handle-signals=false` if"
+       " the application handles these signals, and stops the server itself")
+      //
+      ("drain-timeout", po::value<int>()->default_value(10),
+       "on SIGTERM or SIGINT, stop accepting connections and wait up to N"
+       " seconds for the requests in flight. If some requests are still in"
+       " flight the server stops reading from the connections, waits for the"
+       " running functions, and exits with a non-zero status")
+      //
+      ("idle-timeout", po::value<int>()->default_value(0),
+       "close connections that do not start a new request within N seconds,"
+       " 0 disables the timeout")
+      //
+      ("header-read-timeout", po::value<int>()->default_value(0),
+       "close connections that do not complete the request header within N"
+       " seconds, 0 disables the timeout")
+      //
+      ("body-read-timeout", po::value<int>()->default_value(0),
+       "close connections that do not complete the request body within N"
+       " seconds, 0 disables the timeout")
+      //
+      ("write-timeout", po::value<int>()->default_value(0),
+       "close connections that do not receive the full response within N"
+       " seconds, 0 disables the timeout");
   po::variables_map vm;
   char const* a[] = {"missing-command"};
   // Boost.Options throws an exception if argc == 0, we want to avoid that.
   auto ac = argc == 0 ? 1 : argc;
   auto const* av = argc == 0 ? a : argv;
   po::store(po::parse_command_line(ac, av, desc), vm);
+  po::store(po::parse_environment(desc, EnvironmentOption), vm);
   po::notify(vm);
   if (vm.count("help") != 0) {
     std::cout << desc << "\n";
   }
   auto port_value = vm["port"].as<int>();
-  if (port_value >= std::numeric_limits<std::uint16_t>::min() &&
-      port_value <= std::numeric_limits<std::uint16_t>::max()) {
-    return vm;
+  if (port_value < std::numeric_limits<std::uint16_t>::min() ||
+      port_value > std::numeric_limits<std::uint16_t>::max()) {
+    std::ostringstream os;
+    os << "The configured port (" << port_value << ") is out of range.";
+    throw std::invalid_argument(std::move(os).str());
+  }
+  auto const& engine = vm["session-engine"].as<std::string>();
+  if (engine != "threads" && engine != "async") {
+    throw std::invalid_argument("Unknown session engine (" + engine +
+                                "), expected `threads` or `async`.");
+  }
+  if (vm["io-threads"].as<int>() < 0) {
+    throw std::invalid_argument(
+        "The number of I/O threads cannot be negative.");
+  }
+  if (vm["handler-threads"].as<int>() < 0) {
+    throw std::invalid_argument(
+        "The number of handler threads cannot be negative.");
+  }
+  if (vm["handler-queue-size"].as<int>() < 0) {
+    throw std::invalid_argument("The handler queue size cannot be negative.");
+  }
+  if (vm["reactors"].as<int>() < 0) {
+    throw std::invalid_argument("The number of reactors cannot be negative.");
+  }
+  if (vm["reactors"].as<int>() != 1 && engine != "async") {
+    throw std::invalid_argument(
+        "Multiple reactors require the `async` session engine.");
+  }
+  if (vm.count("unix-socket") != 0) {
+    if (vm["unix-socket"].as<std::string>().empty()) {
+      throw std::invalid_argument("The Unix socket path cannot be empty.");
+    }
+    if (vm["reactors"].as<int>() != 1) {
+      throw std::invalid_argument(
+          "Multiple reactors require a TCP port, they cannot share a Unix"
+          " socket.");
+    }
+  }
+  auto const& action = vm["session-limit-action"].as<std::string>();
+  if (action != "pause" && action != "reject") {
+    throw std::invalid_argument("Unknown session limit action (" + action +
+                                "), expected `pause` or `reject`.");
+  }
+  auto const overload_status = vm["overload-status"].as<int>();
+  if (overload_status != 429 && overload_status != 503) {
+    throw std::invalid_argument("Unsupported overload status (" +
+                                std::to_string(overload_status) +
+                                "), expected 429 or 503.");
+  }
+  auto const& output_flush = vm["output-flush"].as<std::string>();
+  if (output_flush != "always" && output_flush != "on-output" &&
+      output_flush != "capture") {
+    throw std::invalid_argument(
+        "Unknown output flush mode (" + output_flush +
+        "), expected `always`, `on-output`, or `capture`.");
+  }
+  if (vm.count("static-header") != 0) {
+    for (auto const& h : vm["static-header"].as<std::vector<std::string>>()) {
+      ValidateStaticHeader(h);
+    }
+  }
+#ifndef FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+  if (vm["h2c"].as<bool>()) {
+    throw std::invalid_argument(
+        "The framework was built without HTTP/2 support, --h2c is not"
+        " available.");
+  }
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_HTTP2
+#ifndef FUNCTIONS_FRAMEWORK_CPP_HAVE_COMPRESSION
+  if (vm["compression"].as<bool>()) {
+    throw std::invalid_argument(
+        "The framework was built without compression support, --compression"
+        " is not available.");
+  }
+  if (vm["decompress-requests"].as<bool>()) {
+    throw std::invalid_argument(
+        "The framework was built without compression support,"
+        " --decompress-requests is not available.");
+  }
+#endif  // FUNCTIONS_FRAMEWORK_CPP_HAVE_COMPRESSION
+  auto const compression_level = vm["compression-level"].as<int>();
+  if (compression_level < 1 || compression_level > 9) {
+    throw std::invalid_argument("The compression level (" +
+                                std::to_string(compression_level) +
+                                ") must be between 1 and 9.");
+  }
+#ifndef TCP_DEFER_ACCEPT
+  if (vm["tcp-defer-accept"].as<int>() != 0) {
+    throw std::invalid_argument(
+        "TCP_DEFER_ACCEPT is not supported on this platform,"
+        " --tcp-defer-accept is not available.");
+  }
+#endif  // TCP_DEFER_ACCEPT
+#ifndef TCP_QUICKACK
+  if (vm["tcp-quickack"].as<bool>()) {
+    throw std::invalid_argument(
+        "TCP_QUICKACK is not supported on this platform, --tcp-quickack is"
+        " not available.");
+  }
+#endif  // TCP_QUICKACK
+  for (auto const* name : {"max-body-bytes", "max-decompressed-body-bytes"}) {
+    if (vm[name].as<std::int64_t>() >= 0) continue;
+    throw std::invalid_argument(std::string("The value for --") + name +
+                                " cannot be negative.");
+  }
+  for (auto const* name :
+       {"max-sessions", "max-queued-sessions", "max-concurrent-requests",
+        "max-queued-requests", "max-header-bytes", "listen-backlog",
+        "socket-receive-buffer", "socket-send-buffer", "tcp-defer-accept",
+        "compression-min-bytes", "request-queue-timeout", "stats-log-interval",
+        "drain-timeout", "idle-timeout", "header-read-timeout",
+        "body-read-timeout", "write-timeout"}) {
+    if (vm[name].as<int>() >= 0) continue;
+    throw std::invalid_argument(std::string("The value for --") + name +
+                                " cannot be negative.");
   }
-  std::ostringstream os;
-  os << "The configured port (" << port_value << ") is out of range.";
-  throw std::invalid_argument(std::move(os).str());
+  return vm;
 }
 
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
@@ -110,6 +110,138 @@ TEST(WrapRequestTest, PortCommandLineInvalid) {
                std::exception);
 }
 
+TEST(WrapRequestTest, SessionEngine) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--session-engine=async", "--io-threads=4"};
+  auto const vm = ParseOptions(sizeof(argv) / sizeof(argv[0]), argv);
+  EXPECT_EQ(vm["session-engine"].as<std::string>(), "async");
+  EXPECT_EQ(vm["io-threads"].as<int>(), 4);
+}
+
+TEST(WrapRequestTest, SessionEngineDefault) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused"};
+  auto const vm = ParseOptions(sizeof(argv) / sizeof(argv[0]), argv);
+  EXPECT_EQ(vm["session-engine"].as<std::string>(), "threads");
+  EXPECT_EQ(vm["io-threads"].as<int>(), 0);
+}
+
+TEST(WrapRequestTest, SessionEngineInvalid) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv_1[] = {"unused", "--session-engine=invalid"};
+  char const* argv_2[] = {"unused", "--io-threads=-1"};
+
+  EXPECT_THROW(ParseOptions(sizeof(argv_1) / sizeof(argv_1[0]), argv_1),
+               std::exception);
+  EXPECT_THROW(ParseOptions(sizeof(argv_2) / sizeof(argv_2[0]), argv_2),
+               std::exception);
+}
+
+TEST(WrapRequestTest, ReactorsInvalid) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv_1[] = {"unused", "--session-engine=async", "--reactors=-1"};
+  char const* argv_2[] = {"unused", "--reactors=2"};
+
+  EXPECT_THROW(ParseOptions(sizeof(argv_1) / sizeof(argv_1[0]), argv_1),
+               std::exception);
+  EXPECT_THROW(ParseOptions(sizeof(argv_2) / sizeof(argv_2[0]), argv_2),
+               std::exception);
+}
+
+TEST(WrapRequestTest, UnixSocketInvalid) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv_1[] = {"unused", "--unix-socket="};
+  char const* argv_2[] = {"unused", "--unix-socket=/tmp/test.sock",
+                          "--session-engine=async", "--reactors=2"};
+
+  EXPECT_THROW(ParseOptions(sizeof(argv_1) / sizeof(argv_1[0]), argv_1),
+               std::exception);
+  EXPECT_THROW(ParseOptions(sizeof(argv_2) / sizeof(argv_2[0]), argv_2),
+               std::exception);
+}
+
+TEST(WrapRequestTest, SocketOptionsInvalid) {
+  SetEnv("PORT", std::nullopt);
+  for (auto const* option :
+       {"--listen-backlog=-1", "--socket-receive-buffer=-1",
+        "--socket-send-buffer=-1", "--tcp-defer-accept=-1",
+        "--tcp-nodelay=maybe"}) {
+    char const* argv[] = {"unused", option};
+    EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+                 std::exception)
+        << option;
+  }
+  SetEnv("FUNCTION_TCP_QUICKACK", "not-a-bool");
+  char const* argv[] = {"unused"};
+  EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+               std::exception);
+  SetEnv("FUNCTION_TCP_QUICKACK", std::nullopt);
+}
+
+TEST(WrapRequestTest, CompressionLevelInvalid) {
+  SetEnv("PORT", std::nullopt);
+  for (auto const* option :
+       {"--compression-level=0", "--compression-level=10",
+        "--compression-min-bytes=-1",
+        "--max-decompressed-body-bytes=-1"}) {
+    char const* argv[] = {"unused", option};
+    EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+                 std::exception)
+        << option;
+  }
+}
+
+TEST(WrapRequestTest, SessionLimitsInvalid) {
+  SetEnv("PORT", std::nullopt);
+  for (auto const* option :
+       {"--max-sessions=-1", "--max-queued-sessions=-1",
+        "--session-limit-action=invalid", "--max-concurrent-requests=-1",
+        "--max-queued-requests=-1", "--overload-status=500",
+        "--request-queue-timeout=-1"}) {
+    char const* argv[] = {"unused", option};
+    EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+                 std::exception);
+  }
+}
+
+TEST(WrapRequestTest, StaticHeaderInvalid) {
+  SetEnv("PORT", std::nullopt);
+  for (auto const* option :
+       {"--static-header=missing-colon", "--static-header=Bad Name: v"}) {
+    char const* argv[] = {"unused", option};
+    EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+                 std::exception);
+  }
+}
+
+TEST(WrapRequestTest, OutputFlushInvalid) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--output-flush=invalid"};
+  EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+               std::exception);
+}
+
+TEST(WrapRequestTest, MessageLimitsInvalid) {
+  SetEnv("PORT", std::nullopt);
+  for (auto const* option : {"--max-body-bytes=-1", "--max-header-bytes=-1"}) {
+    char const* argv[] = {"unused", option};
+    EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+                 std::exception);
+  }
+}
+
+TEST(WrapRequestTest, TimeoutsInvalid) {
+  SetEnv("PORT", std::nullopt);
+  for (auto const* option :
+       {"--idle-timeout=-1", "--header-read-timeout=-1",
+        "--body-read-timeout=-1", "--write-timeout=-1",
+        "--drain-timeout=-1"}) {
+    char const* argv[] = {"unused", option};
+    EXPECT_THROW(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv),
+                 std::exception);
+  }
+}
+
 }  // namespace
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
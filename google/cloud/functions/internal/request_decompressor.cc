@@ -0,0 +1,253 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/request_decompressor.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = boost::beast::http;
+
+// Detect the zlib (RFC 1950) or gzip (RFC 1952) wrapper automatically, HTTP
+// clients use both for `deflate`.
+auto constexpr kWindowBits = 15 + 32;
+auto constexpr kChunkSize = std::size_t{16 * 1024};
+
+enum class Coding { kIdentity, kCompressed, kUnsupported };
+
+Coding ContentEncoding(BeastRequest const& request) {
+  auto const header = request[http::field::content_encoding];
+  auto const begin = header.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) return Coding::kIdentity;
+  auto const end = header.find_last_not_of(" \t");
+  std::string coding(header.substr(begin, end - begin + 1));
+  for (auto& c : coding) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  if (coding == "identity") return Coding::kIdentity;
+  if (coding == "gzip" || coding == "x-gzip" || coding == "deflate") {
+    return Coding::kCompressed;
+  }
+  return Coding::kUnsupported;
+}
+
+class InflateStream {
+ public:
+  InflateStream() { ok_ = inflateInit2(&stream_, kWindowBits) == Z_OK; }
+  ~InflateStream() {
+    if (ok_) inflateEnd(&stream_);
+  }
+
+  InflateStream(InflateStream const&) = delete;
+  InflateStream& operator=(InflateStream const&) = delete;
+
+  bool Reset() { return ok_ && inflateReset(&stream_) == Z_OK; }
+  z_stream& get() { return stream_; }
+
+ private:
+  z_stream stream_{};
+  bool ok_ = false;
+};
+
+// Buffered requests share a stream per thread, avoiding the initialization
+// costs for each request.
+InflateStream& ThreadStream() {
+  thread_local InflateStream stream;
+  return stream;
+}
+
+class DecompressingReader : public functions::HttpBodyReader::Impl {
+ public:
+  DecompressingReader(functions::HttpBodyReader source,
+                      std::uint64_t max_bytes)
+      : source_(std::move(source)), max_bytes_(max_bytes), input_(kChunkSize) {
+    if (!stream_.Reset()) {
+      throw std::runtime_error("cannot initialize the zlib stream");
+    }
+  }
+
+  std::size_t Read(char* buffer, std::size_t size) override {
+    auto& z = stream_.get();
+    while (!done_ && size != 0) {
+      if (z.avail_in == 0 && !eof_) Fill();
+      if (member_end_) {
+        // Concatenated gzip members decode as a single body.
+        if (z.avail_in == 0) {
+          done_ = true;
+          break;
+        }
+        if (!stream_.Reset()) throw std::runtime_error("corrupted body");
+        member_end_ = false;
+      }
+      z.next_out = reinterpret_cast<Bytef*>(buffer);
+      z.avail_out = static_cast<uInt>(
+          std::min<std::size_t>(size, std::numeric_limits<uInt>::max()));
+      auto const available = z.avail_out;
+      auto const rc = inflate(&z, Z_NO_FLUSH);
+      auto const produced = static_cast<std::size_t>(available - z.avail_out);
+      total_ += produced;
+      if (max_bytes_ != 0 && total_ > max_bytes_) {
+        throw std::runtime_error(
+            "the decompressed body exceeds --max-decompressed-body-bytes");
+      }
+      if (rc == Z_STREAM_END) {
+        member_end_ = true;
+      } else if (rc == Z_BUF_ERROR) {
+        // No progress is possible without more input.
+        if (eof_) throw std::runtime_error("truncated compressed body");
+      } else if (rc != Z_OK) {
+        throw std::runtime_error("corrupted compressed body");
+      }
+      if (produced != 0) return produced;
+    }
+    return 0;
+  }
+
+ private:
+  void Fill() {
+    auto& z = stream_.get();
+    auto const n = source_.Read(input_.data(), input_.size());
+    if (n == 0) eof_ = true;
+    z.next_in = reinterpret_cast<Bytef*>(input_.data());
+    z.avail_in = static_cast<uInt>(n);
+  }
+
+  functions::HttpBodyReader source_;
+  std::uint64_t max_bytes_;
+  std::vector<char> input_;
+  InflateStream stream_;
+  std::uint64_t total_ = 0;
+  bool eof_ = false;
+  bool member_end_ = false;
+  bool done_ = false;
+};
+
+}  // namespace
+
+std::optional<BeastResponse> DecompressRequest(BeastRequest& request,
+                                               std::uint64_t max_bytes) {
+  switch (ContentEncoding(request)) {
+    case Coding::kIdentity:
+      request.erase(http::field::content_encoding);
+      return std::nullopt;
+    case Coding::kUnsupported:
+      return MakeErrorResponse(http::status::unsupported_media_type);
+    case Coding::kCompressed:
+      break;
+  }
+  auto const& in = request.body();
+  if (in.size() > std::numeric_limits<uInt>::max()) {
+    return MakeErrorResponse(http::status::payload_too_large);
+  }
+  auto& stream = ThreadStream();
+  if (!stream.Reset()) {
+    return MakeErrorResponse(http::status::internal_server_error);
+  }
+  auto& z = stream.get();
+  // zlib does not modify the input, but its API predates `const`.
+  z.next_in = reinterpret_cast<Bytef*>(  // NOLINT
+      const_cast<char*>(in.data()));
+  z.avail_in = static_cast<uInt>(in.size());
+  std::string out;
+  for (;;) {
+    // Grow the output geometrically, most bodies need a single call.
+    auto const offset = out.size();
+    auto const grow = std::clamp<std::size_t>(std::max(offset, 4 * in.size()),
+                                              kChunkSize, 16 * kChunkSize);
+    out.resize(offset + grow);
+    z.next_out = reinterpret_cast<Bytef*>(out.data() + offset);
+    z.avail_out = static_cast<uInt>(grow);
+    auto const rc = inflate(&z, Z_NO_FLUSH);
+    out.resize(offset + grow - z.avail_out);
+    if (max_bytes != 0 && out.size() > max_bytes) {
+      return MakeErrorResponse(http::status::payload_too_large);
+    }
+    if (rc == Z_STREAM_END) {
+      if (z.avail_in == 0) break;
+      // Concatenated gzip members decode as a single body.
+      if (inflateReset(&z) != Z_OK) {
+        return MakeErrorResponse(http::status::bad_request);
+      }
+      continue;
+    }
+    // Z_BUF_ERROR means the body is truncated, as all the input is available.
+    if (rc != Z_OK) return MakeErrorResponse(http::status::bad_request);
+  }
+  request.body() = std::move(out);
+  request.erase(http::field::content_encoding);
+  request.prepare_payload();
+  return std::nullopt;
+}
+
+functions::HttpBodyReader MakeDecompressingReader(
+    functions::HttpBodyReader reader, std::uint64_t max_bytes) {
+  return functions::HttpBodyReader(
+      std::make_unique<DecompressingReader>(std::move(reader), max_bytes));
+}
+
+Handler DecompressRequests(Handler handler, ServerConfig const& config) {
+  return [handler = std::move(handler),
+          max_bytes = config.max_decompressed_body_bytes](
+             BeastRequest request) {
+    if (auto error = DecompressRequest(request, max_bytes)) {
+      return *std::move(error);
+    }
+    return handler(std::move(request));
+  };
+}
+
+StreamingHandler DecompressRequests(StreamingHandler handler,
+                                    ServerConfig const& config) {
+  return [handler = std::move(handler),
+          max_bytes = config.max_decompressed_body_bytes](
+             BeastRequest request, functions::HttpBodyReader reader) {
+    switch (ContentEncoding(request)) {
+      case Coding::kIdentity:
+        request.erase(http::field::content_encoding);
+        return handler(std::move(request), std::move(reader));
+      case Coding::kUnsupported:
+        return MakeErrorResponse(http::status::unsupported_media_type);
+      case Coding::kCompressed:
+        break;
+    }
+    // The decoded size is unknown until the function reads the full body.
+    request.erase(http::field::content_encoding);
+    request.erase(http::field::content_length);
+    return handler(std::move(request),
+                   MakeDecompressingReader(std::move(reader), max_bytes));
+  };
+}
+
+WriterHandler DecompressRequests(WriterHandler handler,
+                                 ServerConfig const& config) {
+  return [handler = std::move(handler),
+          max_bytes = config.max_decompressed_body_bytes](
+             BeastRequest request, functions::HttpResponseWriter writer)
+             -> std::optional<BeastResponse> {
+    if (auto error = DecompressRequest(request, max_bytes)) return error;
+    return handler(std::move(request), std::move(writer));
+  };
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,71 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_REQUEST_DECOMPRESSOR_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_REQUEST_DECOMPRESSOR_H
+
+#include "google/cloud/functions/internal/function_impl.h"
+#include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/http_body_reader.h"
+#include "google/cloud/functions/version.h"
+#include <cstdint>
+#include <optional>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Decodes a request body sent with `Content-Encoding: gzip` or `deflate`.
+ *
+ * On success the request contains the decoded body, without the
+ * `Content-Encoding` header, and with the decoded `Content-Length`. Requests
+ * without a `Content-Encoding` (or with `identity`) are unchanged.
+ *
+ * @param max_bytes the maximum size of the decoded body, 0 disables the
+ *     limit. This stops small, highly compressed, requests (zip bombs) from
+ *     exhausting the memory.
+ * @return an error response if the request cannot be decoded: `415
+ *     Unsupported Media Type` for other codings, `400 Bad Request` for
+ *     corrupted bodies, and `413 Payload Too Large` if the decoded body
+ *     exceeds @p max_bytes.
+ */
+std::optional<BeastResponse> DecompressRequest(BeastRequest& request,
+                                               std::uint64_t max_bytes);
+
+/**
+ * Decodes the body of a request sent with `Content-Encoding: gzip` or
+ * `deflate` as the function reads it from @p reader.
+ *
+ * The reader throws `std::runtime_error` if the body is corrupted, or the
+ * decoded body exceeds @p max_bytes (if not 0).
+ */
+functions::HttpBodyReader MakeDecompressingReader(
+    functions::HttpBodyReader reader, std::uint64_t max_bytes);
+
+/// Wraps @p handler to decode compressed request bodies.
+Handler DecompressRequests(Handler handler, ServerConfig const& config);
+
+/// Wraps @p handler to decode compressed request bodies as they are read.
+StreamingHandler DecompressRequests(StreamingHandler handler,
+                                    ServerConfig const& config);
+
+/// Wraps @p handler to decode compressed request bodies.
+WriterHandler DecompressRequests(WriterHandler handler,
+                                 ServerConfig const& config);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_REQUEST_DECOMPRESSOR_H
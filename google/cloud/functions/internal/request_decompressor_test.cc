@@ -0,0 +1,226 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/request_decompressor.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <string>
+#include <zlib.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = boost::beast::http;
+
+std::string Compress(std::string const& data, bool gzip) {
+  z_stream stream{};
+  EXPECT_EQ(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY),
+            Z_OK);
+  std::string out(deflateBound(&stream, static_cast<uLong>(data.size())),
+                  '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(  // NOLINT
+      const_cast<char*>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = reinterpret_cast<Bytef*>(out.data());
+  stream.avail_out = static_cast<uInt>(out.size());
+  EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+std::string NdJson(int lines) {
+  std::string payload;
+  for (int i = 0; i != lines; ++i) {
+    payload += R"({"id": )" + std::to_string(i) + R"(, "value": "abc"})";
+    payload += "\n";
+  }
+  return payload;
+}
+
+BeastRequest MakeRequest(std::string body, std::string const& encoding) {
+  BeastRequest request(http::verb::post, "/", 11);
+  request.set(http::field::content_encoding, encoding);
+  request.body() = std::move(body);
+  request.prepare_payload();
+  return request;
+}
+
+/// Returns the data in @p chunks of at most `size` bytes.
+class FakeReader : public functions::HttpBodyReader::Impl {
+ public:
+  FakeReader(std::string data, std::size_t size)
+      : data_(std::move(data)), size_(size) {}
+
+  std::size_t Read(char* buffer, std::size_t size) override {
+    auto const n = std::min({size, size_, data_.size() - offset_});
+    std::copy_n(data_.data() + offset_, n, buffer);
+    offset_ += n;
+    return n;
+  }
+
+ private:
+  std::string data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+};
+
+std::string ReadAll(functions::HttpBodyReader reader) {
+  std::string result;
+  char buffer[100];
+  for (auto n = reader.Read(buffer, sizeof(buffer)); n != 0;
+       n = reader.Read(buffer, sizeof(buffer))) {
+    result.append(buffer, n);
+  }
+  return result;
+}
+
+TEST(RequestDecompressorTest, Gzip) {
+  auto const payload = NdJson(1000);
+  auto request = MakeRequest(Compress(payload, true), "gzip");
+  EXPECT_FALSE(DecompressRequest(request, 0).has_value());
+  EXPECT_EQ(request.body(), payload);
+  EXPECT_EQ(request.count(http::field::content_encoding), 0);
+  EXPECT_EQ(request[http::field::content_length],
+            std::to_string(payload.size()));
+}
+
+TEST(RequestDecompressorTest, Deflate) {
+  auto const payload = NdJson(10);
+  auto request = MakeRequest(Compress(payload, false), "Deflate");
+  EXPECT_FALSE(DecompressRequest(request, 0).has_value());
+  EXPECT_EQ(request.body(), payload);
+}
+
+TEST(RequestDecompressorTest, ConcatenatedMembers) {
+  auto const a = NdJson(10);
+  auto const b = NdJson(20);
+  auto request = MakeRequest(Compress(a, true) + Compress(b, true), "gzip");
+  EXPECT_FALSE(DecompressRequest(request, 0).has_value());
+  EXPECT_EQ(request.body(), a + b);
+}
+
+TEST(RequestDecompressorTest, Identity) {
+  auto request = MakeRequest("plain", "identity");
+  EXPECT_FALSE(DecompressRequest(request, 0).has_value());
+  EXPECT_EQ(request.body(), "plain");
+  EXPECT_EQ(request.count(http::field::content_encoding), 0);
+
+  BeastRequest none(http::verb::post, "/", 11);
+  none.body() = "plain";
+  EXPECT_FALSE(DecompressRequest(none, 0).has_value());
+  EXPECT_EQ(none.body(), "plain");
+}
+
+TEST(RequestDecompressorTest, Errors) {
+  auto unsupported = MakeRequest("data", "br");
+  auto error = DecompressRequest(unsupported, 0);
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->result(), http::status::unsupported_media_type);
+
+  auto corrupted = MakeRequest("not gzip data", "gzip");
+  error = DecompressRequest(corrupted, 0);
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->result(), http::status::bad_request);
+
+  auto compressed = Compress(NdJson(100), true);
+  auto truncated =
+      MakeRequest(compressed.substr(0, compressed.size() / 2), "gzip");
+  error = DecompressRequest(truncated, 0);
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->result(), http::status::bad_request);
+}
+
+TEST(RequestDecompressorTest, ZipBomb) {
+  // 10 MiB of zeros compress to ~10 KiB.
+  auto request =
+      MakeRequest(Compress(std::string(10 * 1024 * 1024, '\0'), true), "gzip");
+  EXPECT_LT(request.body().size(), 64 * 1024);
+  auto error = DecompressRequest(request, 1024 * 1024);
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->result(), http::status::payload_too_large);
+}
+
+TEST(RequestDecompressorTest, StreamingReader) {
+  auto const payload = NdJson(1000);
+  auto compressed = Compress(payload, true);
+  auto const second = NdJson(5);
+  compressed += Compress(second, true);
+  // Use small reads, so the compressed data spans many `Read()` calls.
+  auto reader = MakeDecompressingReader(
+      functions::HttpBodyReader(std::make_unique<FakeReader>(compressed, 37)),
+      0);
+  EXPECT_EQ(ReadAll(std::move(reader)), payload + second);
+}
+
+TEST(RequestDecompressorTest, StreamingReaderErrors) {
+  auto const compressed = Compress(NdJson(1000), true);
+  auto truncated = MakeDecompressingReader(
+      functions::HttpBodyReader(std::make_unique<FakeReader>(
+          compressed.substr(0, compressed.size() / 2), 1024)),
+      0);
+  EXPECT_THROW(ReadAll(std::move(truncated)), std::runtime_error);
+
+  auto limited = MakeDecompressingReader(
+      functions::HttpBodyReader(
+          std::make_unique<FakeReader>(compressed, 1024)),
+      1024);
+  EXPECT_THROW(ReadAll(std::move(limited)), std::runtime_error);
+}
+
+TEST(RequestDecompressorTest, WrapHandler) {
+  ServerConfig config;
+  config.max_decompressed_body_bytes = 1024 * 1024;
+  auto const payload = NdJson(100);
+  auto handler = DecompressRequests(Handler([](BeastRequest request) {
+                                      BeastResponse response;
+                                      response.body() = request.body();
+                                      return response;
+                                    }),
+                                    config);
+  auto response = handler(MakeRequest(Compress(payload, true), "gzip"));
+  EXPECT_EQ(response.result(), http::status::ok);
+  EXPECT_EQ(response.body(), payload);
+
+  response = handler(MakeRequest("data", "compress"));
+  EXPECT_EQ(response.result(), http::status::unsupported_media_type);
+}
+
+TEST(RequestDecompressorTest, WrapStreamingHandler) {
+  auto const payload = NdJson(100);
+  auto handler = DecompressRequests(
+      StreamingHandler(
+          [](BeastRequest request, functions::HttpBodyReader reader) {
+            EXPECT_EQ(request.count(http::field::content_encoding), 0);
+            EXPECT_EQ(request.count(http::field::content_length), 0);
+            BeastResponse response;
+            response.body() = ReadAll(std::move(reader));
+            return response;
+          }),
+      ServerConfig{});
+  auto const compressed = Compress(payload, false);
+  BeastRequest request(http::verb::post, "/", 11);
+  request.set(http::field::content_encoding, "deflate");
+  request.content_length(compressed.size());
+  auto response = handler(
+      std::move(request),
+      functions::HttpBodyReader(std::make_unique<FakeReader>(compressed, 64)));
+  EXPECT_EQ(response.body(), payload);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,141 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/request_limiter.h"
+#include <algorithm>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+void RequestLimiter::Permit::Reset() {
+  if (limiter_ == nullptr) return;
+  auto* limiter = limiter_;
+  limiter_ = nullptr;
+  limiter->Release(start_);
+}
+
+RequestLimiter::RequestLimiter(std::size_t max_requests,
+                               std::size_t max_queued, ServerStats& stats,
+                               bool adaptive,
+                               std::chrono::milliseconds queue_timeout)
+    : max_queued_(max_queued),
+      queue_timeout_(queue_timeout),
+      stats_(stats),
+      limit_(max_requests) {
+  if (adaptive) {
+    auto const max_limit =
+        max_requests == 0 ? kDefaultMaxAdaptiveLimit : max_requests;
+    adaptive_.emplace(std::min(kInitialAdaptiveLimit, max_limit), 1,
+                      max_limit);
+    limit_ = adaptive_->limit();
+  }
+  UpdateStats();
+  if (max_queued_ != 0 && queue_timeout_.count() != 0) {
+    expirer_ = std::thread([this] { ExpireQueued(); });
+  }
+}
+
+RequestLimiter::~RequestLimiter() { Shutdown(); }
+
+RequestLimiter::Admission RequestLimiter::Admit(
+    Permit& permit, std::function<void(Permit)> resume) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (shutdown_) return Admission::kRejected;
+  if (HasRoom()) {
+    ++active_;
+    UpdateStats();
+    permit = Permit(this);
+    return Admission::kAdmitted;
+  }
+  if (queue_.size() < max_queued_) {
+    if (queue_.empty()) cv_.notify_one();
+    queue_.push_back(Waiter{std::chrono::steady_clock::now() + queue_timeout_,
+                            std::move(resume)});
+    UpdateStats();
+    return Admission::kQueued;
+  }
+  return Admission::kRejected;
+}
+
+void RequestLimiter::Shutdown() {
+  std::unique_lock<std::mutex> lk(mu_);
+  shutdown_ = true;
+  auto rejected = std::move(queue_);
+  queue_.clear();
+  UpdateStats();
+  lk.unlock();
+  cv_.notify_all();
+  if (expirer_.joinable()) expirer_.join();
+  for (auto& w : rejected) w.resume(Permit{});
+}
+
+std::size_t RequestLimiter::limit() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return limit_;
+}
+
+void RequestLimiter::Release(std::chrono::steady_clock::time_point start) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (adaptive_) {
+    adaptive_->OnSample(std::chrono::steady_clock::now() - start, active_);
+    limit_ = adaptive_->limit();
+  }
+  --active_;
+  // The next queued requests take over the released slot, and any slots added
+  // by a higher adaptive limit.
+  std::vector<std::function<void(Permit)>> next;
+  while (!queue_.empty() && HasRoom()) {
+    ++active_;
+    next.push_back(std::move(queue_.front().resume));
+    queue_.pop_front();
+  }
+  UpdateStats();
+  lk.unlock();
+  for (auto& f : next) f(Permit(this));
+}
+
+void RequestLimiter::ExpireQueued() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (!shutdown_) {
+    if (queue_.empty()) {
+      cv_.wait(lk);
+      continue;
+    }
+    auto const now = std::chrono::steady_clock::now();
+    auto const deadline = queue_.front().deadline;
+    if (now < deadline) {
+      cv_.wait_until(lk, deadline);
+      continue;
+    }
+    std::vector<std::function<void(Permit)>> expired;
+    while (!queue_.empty() && queue_.front().deadline <= now) {
+      expired.push_back(std::move(queue_.front().resume));
+      queue_.pop_front();
+    }
+    UpdateStats();
+    lk.unlock();
+    for (auto& f : expired) f(Permit{});
+    lk.lock();
+  }
+}
+
+void RequestLimiter::UpdateStats() {
+  stats_.requests_active.store(active_, std::memory_order_relaxed);
+  stats_.requests_queued.store(queue_.size(), std::memory_order_relaxed);
+  stats_.request_limit.store(limit_, std::memory_order_relaxed);
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
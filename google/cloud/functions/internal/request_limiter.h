@@ -0,0 +1,158 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_REQUEST_LIMITER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_REQUEST_LIMITER_H
+
+#include "google/cloud/functions/internal/adaptive_limit.h"
+#include "google/cloud/functions/internal/server_stats.h"
+#include "google/cloud/functions/version.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Limits the number of concurrent function invocations.
+ *
+ * Unlike the session limits, idle keep-alive connections do not count against
+ * this limit. A request runs immediately while there are fewer than
+ * `max_requests` requests running. Otherwise it waits, in FIFO order, for a
+ * running request to complete, up to `max_queued` requests. Further requests
+ * are rejected, and the session responds with `MakeOverloadedResponse()`
+ * without calling the function. With a queue timeout, requests that wait
+ * longer are also rejected.
+ *
+ * Each running request holds a `Permit`, the slot is released (or handed over
+ * to the next queued request) when the permit is destroyed.
+ *
+ * With an adaptive limit `max_requests` is only an upper bound, the actual
+ * limit follows the function latency, see `AdaptiveLimit`. The latency of each
+ * request is measured from the time it gets a slot until the permit is
+ * released.
+ */
+class RequestLimiter {
+ public:
+  /// Holds a request slot, see `Admit()`.
+  class Permit {
+   public:
+    Permit() = default;
+    ~Permit() { Reset(); }
+
+    Permit(Permit&& rhs) noexcept
+        : limiter_(rhs.limiter_), start_(rhs.start_) {
+      rhs.limiter_ = nullptr;
+    }
+    Permit& operator=(Permit&& rhs) noexcept {
+      if (this == &rhs) return *this;
+      Reset();
+      limiter_ = rhs.limiter_;
+      start_ = rhs.start_;
+      rhs.limiter_ = nullptr;
+      return *this;
+    }
+
+    Permit(Permit const&) = delete;
+    Permit& operator=(Permit const&) = delete;
+
+    explicit operator bool() const { return limiter_ != nullptr; }
+
+   private:
+    friend class RequestLimiter;
+    explicit Permit(RequestLimiter* l)
+        : limiter_(l), start_(std::chrono::steady_clock::now()) {}
+    void Reset();
+
+    RequestLimiter* limiter_ = nullptr;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  /// The result of `Admit()`.
+  enum class Admission { kAdmitted, kQueued, kRejected };
+
+  /**
+   * A @p max_requests value of 0 disables the limit, unless @p adaptive is
+   * set, in which case the limit is capped at `kDefaultMaxAdaptiveLimit`. A
+   * @p queue_timeout of 0 lets the queued requests wait indefinitely.
+   */
+  RequestLimiter(std::size_t max_requests, std::size_t max_queued,
+                 ServerStats& stats, bool adaptive = false,
+                 std::chrono::milliseconds queue_timeout = {});
+  ~RequestLimiter();
+
+  RequestLimiter(RequestLimiter const&) = delete;
+  RequestLimiter& operator=(RequestLimiter const&) = delete;
+
+  /**
+   * Admits a request, or queues it until there is a free slot.
+   *
+   * If the request is admitted immediately the slot is stored in @p permit.
+   * If the request is queued, @p resume is called (at most once, possibly
+   * from a different thread) with the permit once a slot is free, or with an
+   * empty permit if the request is rejected while it waits. Otherwise the
+   * request is rejected and @p resume is discarded.
+   */
+  Admission Admit(Permit& permit, std::function<void(Permit)> resume);
+
+  /**
+   * Rejects the queued requests, and any requests admitted after this call.
+   *
+   * The queued requests hold their sessions, they must be released while the
+   * sessions can still run.
+   */
+  void Shutdown();
+
+  /// The current limit, 0 if there is no limit.
+  std::size_t limit() const;
+
+  static std::size_t constexpr kInitialAdaptiveLimit = 20;
+  static std::size_t constexpr kDefaultMaxAdaptiveLimit = 1000;
+
+ private:
+  struct Waiter {
+    std::chrono::steady_clock::time_point deadline;
+    std::function<void(Permit)> resume;
+  };
+
+  void Release(std::chrono::steady_clock::time_point start);
+  bool HasRoom() const { return limit_ == 0 || active_ < limit_; }
+  void UpdateStats();
+  void ExpireQueued();
+
+  std::size_t const max_queued_;
+  std::chrono::milliseconds const queue_timeout_;
+  ServerStats& stats_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::optional<AdaptiveLimit> adaptive_;
+  std::size_t limit_;
+  std::size_t active_ = 0;
+  bool shutdown_ = false;
+  // All the requests wait for the same timeout, the queue is also sorted by
+  // deadline.
+  std::deque<Waiter> queue_;
+  std::thread expirer_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_REQUEST_LIMITER_H
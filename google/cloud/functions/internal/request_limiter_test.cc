@@ -0,0 +1,165 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/request_limiter.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using Admission = RequestLimiter::Admission;
+using Permit = RequestLimiter::Permit;
+
+TEST(RequestLimiterTest, AdmitsAndQueues) {
+  ServerStats stats;
+  RequestLimiter limiter(2, 2, stats);
+  std::vector<int> resumed;
+  std::vector<Permit> handed_over;
+  auto resume = [&](int id) {
+    return [&resumed, &handed_over, id](Permit p) {
+      resumed.push_back(id);
+      handed_over.push_back(std::move(p));
+    };
+  };
+  Permit a;
+  Permit b;
+  Permit c;
+  EXPECT_EQ(limiter.Admit(a, resume(1)), Admission::kAdmitted);
+  EXPECT_EQ(limiter.Admit(b, resume(2)), Admission::kAdmitted);
+  EXPECT_TRUE(a);
+  EXPECT_TRUE(b);
+  EXPECT_EQ(limiter.Admit(c, resume(3)), Admission::kQueued);
+  EXPECT_EQ(limiter.Admit(c, resume(4)), Admission::kQueued);
+  EXPECT_EQ(limiter.Admit(c, resume(5)), Admission::kRejected);
+  EXPECT_FALSE(c);
+  EXPECT_EQ(stats.requests_active.load(), 2);
+  EXPECT_EQ(stats.requests_queued.load(), 2);
+  EXPECT_TRUE(resumed.empty());
+
+  // Releasing a permit hands the slot to the queued requests, in FIFO order.
+  b = {};
+  EXPECT_THAT(resumed, ::testing::ElementsAre(3));
+  a = {};
+  EXPECT_THAT(resumed, ::testing::ElementsAre(3, 4));
+  EXPECT_EQ(stats.requests_active.load(), 2);
+  EXPECT_EQ(stats.requests_queued.load(), 0);
+
+  handed_over.clear();
+  EXPECT_EQ(stats.requests_active.load(), 0);
+}
+
+TEST(RequestLimiterTest, RejectsWithoutQueue) {
+  ServerStats stats;
+  RequestLimiter limiter(1, 0, stats);
+  Permit a;
+  Permit b;
+  EXPECT_EQ(limiter.Admit(a, [](Permit) {}), Admission::kAdmitted);
+  EXPECT_EQ(limiter.Admit(b, [](Permit) {}), Admission::kRejected);
+  a = {};
+  EXPECT_EQ(limiter.Admit(b, [](Permit) {}), Admission::kAdmitted);
+}
+
+TEST(RequestLimiterTest, QueueTimeout) {
+  ServerStats stats;
+  RequestLimiter limiter(1, 2, stats, /*adaptive=*/false,
+                         std::chrono::milliseconds(50));
+  std::promise<bool> resumed;
+  Permit a;
+  Permit b;
+  EXPECT_EQ(limiter.Admit(a, [](Permit) {}), Admission::kAdmitted);
+  EXPECT_EQ(limiter.Admit(b,
+                          [&resumed](Permit p) {
+                            resumed.set_value(static_cast<bool>(p));
+                          }),
+            Admission::kQueued);
+
+  // The queued request is rejected with an empty permit.
+  auto f = resumed.get_future();
+  ASSERT_EQ(f.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_FALSE(f.get());
+  EXPECT_EQ(stats.requests_queued.load(), 0);
+  EXPECT_EQ(stats.requests_active.load(), 1);
+}
+
+TEST(RequestLimiterTest, Shutdown) {
+  ServerStats stats;
+  RequestLimiter limiter(1, 2, stats);
+  std::vector<bool> resumed;
+  Permit a;
+  Permit b;
+  EXPECT_EQ(limiter.Admit(a, [](Permit) {}), Admission::kAdmitted);
+  EXPECT_EQ(limiter.Admit(b,
+                          [&resumed](Permit p) {
+                            resumed.push_back(static_cast<bool>(p));
+                          }),
+            Admission::kQueued);
+
+  // The queued requests are rejected, and so are any new requests.
+  limiter.Shutdown();
+  EXPECT_THAT(resumed, ::testing::ElementsAre(false));
+  EXPECT_EQ(stats.requests_queued.load(), 0);
+  a = {};
+  EXPECT_EQ(limiter.Admit(b, [](Permit) {}), Admission::kRejected);
+  EXPECT_EQ(stats.requests_active.load(), 0);
+}
+
+TEST(RequestLimiterTest, Unlimited) {
+  ServerStats stats;
+  RequestLimiter limiter(0, 0, stats);
+  std::vector<Permit> permits(100);
+  for (auto& p : permits) {
+    EXPECT_EQ(limiter.Admit(p, [](Permit) {}), Admission::kAdmitted);
+  }
+  EXPECT_EQ(stats.requests_active.load(), 100);
+}
+
+TEST(RequestLimiterTest, Adaptive) {
+  ServerStats stats;
+  RequestLimiter limiter(0, 0, stats, /*adaptive=*/true);
+  EXPECT_EQ(limiter.limit(), RequestLimiter::kInitialAdaptiveLimit);
+  EXPECT_EQ(stats.request_limit.load(), RequestLimiter::kInitialAdaptiveLimit);
+
+  // Requests over the adaptive limit are rejected.
+  std::vector<Permit> permits(limiter.limit());
+  for (auto& p : permits) {
+    EXPECT_EQ(limiter.Admit(p, [](Permit) {}), Admission::kAdmitted);
+  }
+  Permit rejected;
+  EXPECT_EQ(limiter.Admit(rejected, [](Permit) {}), Admission::kRejected);
+
+  // With stable latency and all the slots in use, the limit grows.
+  for (int i = 0; i != 20 * AdaptiveLimit::kWindowSamples; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    permits.back() = {};
+    EXPECT_EQ(limiter.Admit(permits.back(), [](Permit) {}),
+              Admission::kAdmitted);
+  }
+  EXPECT_GT(limiter.limit(), RequestLimiter::kInitialAdaptiveLimit);
+  EXPECT_EQ(stats.request_limit.load(), limiter.limit());
+}
+
+TEST(RequestLimiterTest, AdaptiveMax) {
+  ServerStats stats;
+  RequestLimiter limiter(8, 0, stats, /*adaptive=*/true);
+  EXPECT_EQ(limiter.limit(), 8);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
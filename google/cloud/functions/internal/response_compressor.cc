@@ -0,0 +1,242 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/response_compressor.h"
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <zlib.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = boost::beast::http;
+
+std::string_view Trim(std::string_view s) {
+  auto const begin = s.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) return {};
+  auto const end = s.find_last_not_of(" \t");
+  return s.substr(begin, end - begin + 1);
+}
+
+std::string ToLower(std::string_view s) {
+  std::string result(s);
+  for (auto& c : result) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return result;
+}
+
+// The quality value in the parameters of an `Accept-Encoding` element, e.g.
+// `;q=0.5`. Invalid values are treated as 0, so the coding is not used.
+double Quality(std::string_view parameters) {
+  while (!parameters.empty()) {
+    auto const pos = parameters.find(';');
+    auto const p = Trim(parameters.substr(0, pos));
+    parameters = pos == std::string_view::npos ? std::string_view{}
+                                               : parameters.substr(pos + 1);
+    if (p.size() < 2 || (p[0] != 'q' && p[0] != 'Q') || p[1] != '=') continue;
+    auto const value = std::string(p.substr(2));
+    char* end = nullptr;
+    auto const q = std::strtod(value.c_str(), &end);
+    if (end != value.c_str() + value.size() || q < 0 || q > 1) return 0;
+    return q;
+  }
+  return 1;
+}
+
+// A zlib stream, reused for all the responses compressed by a thread.
+class DeflateStream {
+ public:
+  DeflateStream(ContentCoding coding, int level) : level_(level) {
+    // 15 is the largest (and default) window, +16 selects the gzip wrapper.
+    auto const window_bits = coding == ContentCoding::kGzip ? 15 + 16 : 15;
+    ok_ = deflateInit2(&stream_, level, Z_DEFLATED, window_bits, 8,
+                       Z_DEFAULT_STRATEGY) == Z_OK;
+  }
+  ~DeflateStream() {
+    if (ok_) deflateEnd(&stream_);
+  }
+
+  DeflateStream(DeflateStream const&) = delete;
+  DeflateStream& operator=(DeflateStream const&) = delete;
+
+  int level() const { return level_; }
+
+  /// Compresses @p in into @p out, returns false on errors.
+  bool Compress(std::string const& in, std::string& out) {
+    if (!ok_ || deflateReset(&stream_) != Z_OK) return false;
+    out.resize(deflateBound(&stream_, static_cast<uLong>(in.size())));
+    // zlib does not modify the input, but its API predates `const`.
+    stream_.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));  // NOLINT
+    stream_.avail_in = static_cast<uInt>(in.size());
+    stream_.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream_.avail_out = static_cast<uInt>(out.size());
+    if (deflate(&stream_, Z_FINISH) != Z_STREAM_END) return false;
+    out.resize(stream_.total_out);
+    return true;
+  }
+
+ private:
+  z_stream stream_{};
+  int level_;
+  bool ok_ = false;
+};
+
+DeflateStream& ThreadStream(ContentCoding coding, int level) {
+  thread_local std::unique_ptr<DeflateStream> gzip;
+  thread_local std::unique_ptr<DeflateStream> deflate;
+  auto& stream = coding == ContentCoding::kGzip ? gzip : deflate;
+  if (!stream || stream->level() != level) {
+    stream = std::make_unique<DeflateStream>(coding, level);
+  }
+  return *stream;
+}
+
+void AddVary(BeastResponse& response) {
+  auto const vary = std::string(response[http::field::vary]);
+  if (vary.empty()) {
+    response.set(http::field::vary, "Accept-Encoding");
+    return;
+  }
+  auto const lower = ToLower(vary);
+  if (lower.find("accept-encoding") != std::string::npos) return;
+  if (Trim(lower) == "*") return;
+  response.set(http::field::vary, vary + ", Accept-Encoding");
+}
+
+}  // namespace
+
+ContentCoding NegotiateContentCoding(std::string_view accept_encoding) {
+  // -1 means the coding is not listed.
+  double gzip = -1;
+  double deflate = -1;
+  double any = -1;
+  while (!accept_encoding.empty()) {
+    auto const pos = accept_encoding.find(',');
+    auto const element = accept_encoding.substr(0, pos);
+    accept_encoding = pos == std::string_view::npos
+                          ? std::string_view{}
+                          : accept_encoding.substr(pos + 1);
+    auto const semicolon = element.find(';');
+    auto const coding = ToLower(Trim(element.substr(0, semicolon)));
+    auto const q = semicolon == std::string_view::npos
+                       ? 1.0
+                       : Quality(element.substr(semicolon + 1));
+    if (coding == "gzip" || coding == "x-gzip") {
+      gzip = q;
+    } else if (coding == "deflate") {
+      deflate = q;
+    } else if (coding == "*") {
+      any = q;
+    }
+  }
+  if (gzip < 0) gzip = any;
+  if (deflate < 0) deflate = any;
+  if (gzip <= 0 && deflate <= 0) return ContentCoding::kIdentity;
+  return gzip >= deflate ? ContentCoding::kGzip : ContentCoding::kDeflate;
+}
+
+ResponseCompressor::ResponseCompressor(ServerConfig const& config)
+    : level_(config.compression_level),
+      min_bytes_(config.compression_min_bytes) {
+  for (auto const& t : config.compression_types) types_.push_back(ToLower(t));
+}
+
+void ResponseCompressor::Compress(BeastResponse& response,
+                                  ContentCoding coding) const {
+  if (!IsCompressible(response)) return;
+  // Caches must not send the compressed response to other clients.
+  AddVary(response);
+  if (coding == ContentCoding::kIdentity) return;
+  if (response.body().size() > std::numeric_limits<uInt>::max()) return;
+
+  std::string compressed;
+  auto& stream = ThreadStream(coding, level_);
+  if (!stream.Compress(response.body(), compressed)) return;
+  if (compressed.size() >= response.body().size()) return;
+  response.body() = std::move(compressed);
+  response.set(http::field::content_encoding,
+               coding == ContentCoding::kGzip ? "gzip" : "deflate");
+  response.erase(http::field::content_length);
+  // The compressed body is not byte-for-byte identical to the original.
+  auto const etag = response[http::field::etag];
+  if (!etag.empty() && etag.substr(0, 2) != "W/") {
+    response.set(http::field::etag, "W/" + std::string(etag));
+  }
+}
+
+bool ResponseCompressor::IsCompressible(BeastResponse const& response) const {
+  auto const status = response.result_int();
+  if (status < 200 || status == 204 || status == 206 || status == 304) {
+    return false;
+  }
+  if (response.body().size() < min_bytes_) return false;
+  if (response.count(http::field::content_encoding) != 0) return false;
+  if (response.count(http::field::content_range) != 0) return false;
+  auto const cache_control = ToLower(response[http::field::cache_control]);
+  if (cache_control.find("no-transform") != std::string::npos) return false;
+
+  auto content_type = response[http::field::content_type];
+  content_type = Trim(content_type.substr(0, content_type.find(';')));
+  auto const type = ToLower(content_type);
+  for (auto const& t : types_) {
+    if (t == type) return true;
+    if (t.size() >= 2 && t.compare(t.size() - 2, 2, "/*") == 0 &&
+        type.compare(0, t.size() - 1, t, 0, t.size() - 1) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+
+ContentCoding RequestCoding(BeastRequest const& request) {
+  // The response to a HEAD request has no body, but its headers must match
+  // the (uncompressed) GET response, including `Content-Length`.
+  if (request.method() == http::verb::head) return ContentCoding::kIdentity;
+  return NegotiateContentCoding(request[http::field::accept_encoding]);
+}
+
+}  // namespace
+
+Handler CompressResponses(Handler handler, ServerConfig const& config) {
+  auto compressor = std::make_shared<ResponseCompressor const>(config);
+  return [handler = std::move(handler),
+          compressor = std::move(compressor)](BeastRequest request) {
+    auto const coding = RequestCoding(request);
+    auto response = handler(std::move(request));
+    compressor->Compress(response, coding);
+    return response;
+  };
+}
+
+StreamingHandler CompressResponses(StreamingHandler handler,
+                                   ServerConfig const& config) {
+  auto compressor = std::make_shared<ResponseCompressor const>(config);
+  return [handler = std::move(handler), compressor = std::move(compressor)](
+             BeastRequest request, functions::HttpBodyReader reader) {
+    auto const coding = RequestCoding(request);
+    auto response = handler(std::move(request), std::move(reader));
+    compressor->Compress(response, coding);
+    return response;
+  };
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
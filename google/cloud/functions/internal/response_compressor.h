@@ -0,0 +1,83 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_RESPONSE_COMPRESSOR_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_RESPONSE_COMPRESSOR_H
+
+#include "google/cloud/functions/internal/function_impl.h"
+#include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/version.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/// The content codings supported by `ResponseCompressor`.
+enum class ContentCoding {
+  kIdentity,
+  kGzip,
+  kDeflate,
+};
+
+/**
+ * Returns the preferred coding in an `Accept-Encoding` header value.
+ *
+ * Prefers the coding with the highest quality value, and `gzip` over
+ * `deflate` if both have the same quality. Codings with `q=0` are never
+ * selected, `*` matches any coding not listed explicitly.
+ */
+ContentCoding NegotiateContentCoding(std::string_view accept_encoding);
+
+/**
+ * Compresses response bodies, as negotiated via `Accept-Encoding`.
+ *
+ * Only responses with a body of at least `ServerConfig::compression_min_bytes`
+ * and a `Content-Type` in the configured allowlist are compressed. Responses
+ * that already have a `Content-Encoding`, partial content, and responses where
+ * compression does not reduce the size are sent unchanged.
+ *
+ * Each thread keeps its zlib streams across responses, and resets them before
+ * each use, so the (relatively expensive) stream initialization happens once
+ * per thread.
+ */
+class ResponseCompressor {
+ public:
+  explicit ResponseCompressor(ServerConfig const& config);
+
+  /// Compresses @p response with @p coding, if the response is eligible.
+  void Compress(BeastResponse& response, ContentCoding coding) const;
+
+ private:
+  bool IsCompressible(BeastResponse const& response) const;
+
+  int level_;
+  std::size_t min_bytes_;
+  std::vector<std::string> types_;
+};
+
+/// Wraps @p handler to compress its responses, see `ResponseCompressor`.
+Handler CompressResponses(Handler handler, ServerConfig const& config);
+
+/// Wraps @p handler to compress its responses, see `ResponseCompressor`.
+StreamingHandler CompressResponses(StreamingHandler handler,
+                                   ServerConfig const& config);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_RESPONSE_COMPRESSOR_H
@@ -0,0 +1,190 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/response_compressor.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <zlib.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = boost::beast::http;
+
+std::string Inflate(std::string const& data, ContentCoding coding) {
+  z_stream stream{};
+  auto const window_bits = coding == ContentCoding::kGzip ? 15 + 16 : 15;
+  EXPECT_EQ(inflateInit2(&stream, window_bits), Z_OK);
+  std::string out(64 * 1024, '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(  // NOLINT
+      const_cast<char*>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = reinterpret_cast<Bytef*>(out.data());
+  stream.avail_out = static_cast<uInt>(out.size());
+  EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+  out.resize(stream.total_out);
+  inflateEnd(&stream);
+  return out;
+}
+
+std::string JsonPayload() {
+  std::string payload = "[";
+  for (int i = 0; i != 100; ++i) {
+    payload += R"({"id": )" + std::to_string(i) + R"(, "name": "item"},)";
+  }
+  payload.back() = ']';
+  return payload;
+}
+
+BeastResponse MakeResponse(std::string payload,
+                           std::string const& content_type) {
+  BeastResponse response;
+  response.result(http::status::ok);
+  response.set(http::field::content_type, content_type);
+  response.body() = std::move(payload);
+  response.prepare_payload();
+  return response;
+}
+
+TEST(ResponseCompressorTest, Negotiate) {
+  EXPECT_EQ(NegotiateContentCoding(""), ContentCoding::kIdentity);
+  EXPECT_EQ(NegotiateContentCoding("identity"), ContentCoding::kIdentity);
+  EXPECT_EQ(NegotiateContentCoding("gzip"), ContentCoding::kGzip);
+  EXPECT_EQ(NegotiateContentCoding("GZip"), ContentCoding::kGzip);
+  EXPECT_EQ(NegotiateContentCoding("deflate"), ContentCoding::kDeflate);
+  EXPECT_EQ(NegotiateContentCoding("gzip, deflate, br"), ContentCoding::kGzip);
+  EXPECT_EQ(NegotiateContentCoding("deflate, gzip"), ContentCoding::kGzip);
+  EXPECT_EQ(NegotiateContentCoding("gzip;q=0.5, deflate"),
+            ContentCoding::kDeflate);
+  EXPECT_EQ(NegotiateContentCoding("gzip;q=0, deflate;q=0"),
+            ContentCoding::kIdentity);
+  EXPECT_EQ(NegotiateContentCoding("*"), ContentCoding::kGzip);
+  EXPECT_EQ(NegotiateContentCoding("gzip;q=0, *"), ContentCoding::kDeflate);
+  EXPECT_EQ(NegotiateContentCoding("*;q=0"), ContentCoding::kIdentity);
+  EXPECT_EQ(NegotiateContentCoding("gzip ; q=0.8 , deflate ; q=0.9"),
+            ContentCoding::kDeflate);
+  EXPECT_EQ(NegotiateContentCoding("gzip;q=invalid"),
+            ContentCoding::kIdentity);
+}
+
+TEST(ResponseCompressorTest, Gzip) {
+  ResponseCompressor const compressor(ServerConfig{});
+  auto const payload = JsonPayload();
+  auto response = MakeResponse(payload, "application/json; charset=utf-8");
+  response.set(http::field::etag, "\"v1\"");
+  compressor.Compress(response, ContentCoding::kGzip);
+  EXPECT_EQ(response[http::field::content_encoding], "gzip");
+  EXPECT_EQ(response[http::field::vary], "Accept-Encoding");
+  EXPECT_EQ(response[http::field::etag], "W/\"v1\"");
+  EXPECT_EQ(response.count(http::field::content_length), 0);
+  EXPECT_LT(response.body().size(), payload.size() / 5);
+  EXPECT_EQ(Inflate(response.body(), ContentCoding::kGzip), payload);
+
+  // The per-thread stream is reused for the next response.
+  auto second = MakeResponse(payload, "text/plain");
+  compressor.Compress(second, ContentCoding::kGzip);
+  EXPECT_EQ(Inflate(second.body(), ContentCoding::kGzip), payload);
+}
+
+TEST(ResponseCompressorTest, Deflate) {
+  ResponseCompressor const compressor(ServerConfig{});
+  auto const payload = JsonPayload();
+  auto response = MakeResponse(payload, "application/json");
+  compressor.Compress(response, ContentCoding::kDeflate);
+  EXPECT_EQ(response[http::field::content_encoding], "deflate");
+  EXPECT_EQ(Inflate(response.body(), ContentCoding::kDeflate), payload);
+}
+
+TEST(ResponseCompressorTest, Skipped) {
+  ServerConfig config;
+  config.compression_types = {"application/json"};
+  ResponseCompressor const compressor(config);
+  auto const payload = JsonPayload();
+
+  auto small = MakeResponse("{}", "application/json");
+  compressor.Compress(small, ContentCoding::kGzip);
+  EXPECT_EQ(small.body(), "{}");
+  EXPECT_EQ(small.count(http::field::vary), 0);
+
+  auto text = MakeResponse(payload, "text/plain");
+  compressor.Compress(text, ContentCoding::kGzip);
+  EXPECT_EQ(text.body(), payload);
+
+  auto encoded = MakeResponse(payload, "application/json");
+  encoded.set(http::field::content_encoding, "br");
+  compressor.Compress(encoded, ContentCoding::kGzip);
+  EXPECT_EQ(encoded.body(), payload);
+  EXPECT_EQ(encoded[http::field::content_encoding], "br");
+
+  auto no_transform = MakeResponse(payload, "application/json");
+  no_transform.set(http::field::cache_control, "public, no-transform");
+  compressor.Compress(no_transform, ContentCoding::kGzip);
+  EXPECT_EQ(no_transform.body(), payload);
+
+  auto not_modified = MakeResponse(payload, "application/json");
+  not_modified.result(http::status::not_modified);
+  compressor.Compress(not_modified, ContentCoding::kGzip);
+  EXPECT_EQ(not_modified.body(), payload);
+
+  // The response varies with `Accept-Encoding`, even if it is not compressed.
+  auto identity = MakeResponse(payload, "application/json");
+  identity.set(http::field::vary, "Origin");
+  compressor.Compress(identity, ContentCoding::kIdentity);
+  EXPECT_EQ(identity.body(), payload);
+  EXPECT_EQ(identity[http::field::vary], "Origin, Accept-Encoding");
+}
+
+TEST(ResponseCompressorTest, Incompressible) {
+  ResponseCompressor const compressor(ServerConfig{});
+  std::string payload;
+  std::uint32_t state = 42;
+  for (int i = 0; i != 2048; ++i) {
+    state = state * 1664525 + 1013904223;
+    payload.push_back(static_cast<char>(state >> 24));
+  }
+  auto response = MakeResponse(payload, "text/plain");
+  compressor.Compress(response, ContentCoding::kGzip);
+  EXPECT_EQ(response.body(), payload);
+  EXPECT_EQ(response.count(http::field::content_encoding), 0);
+}
+
+TEST(ResponseCompressorTest, WrapHandler) {
+  auto const payload = JsonPayload();
+  auto handler = CompressResponses(
+      Handler([&payload](BeastRequest const&) {
+        return MakeResponse(payload, "application/json");
+      }),
+      ServerConfig{});
+
+  BeastRequest request(http::verb::get, "/", 11);
+  request.set(http::field::accept_encoding, "gzip, deflate");
+  auto response = handler(request);
+  EXPECT_EQ(response[http::field::content_encoding], "gzip");
+  EXPECT_EQ(Inflate(response.body(), ContentCoding::kGzip), payload);
+
+  request.erase(http::field::accept_encoding);
+  response = handler(request);
+  EXPECT_EQ(response.count(http::field::content_encoding), 0);
+  EXPECT_EQ(response.body(), payload);
+
+  BeastRequest head(http::verb::head, "/", 11);
+  head.set(http::field::accept_encoding, "gzip");
+  response = handler(head);
+  EXPECT_EQ(response.count(http::field::content_encoding), 0);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
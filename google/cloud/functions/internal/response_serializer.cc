@@ -0,0 +1,82 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/response_serializer.h"
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+void ResponseSerializer::Append(BeastResponse const& response,
+                                StaticHeaders const* headers) {
+  // Render the header directly into the reusable buffer, splicing in the
+  // pre-rendered static fields. The result matches Beast's serializer, except
+  // for the additional fields.
+  auto const start = storage_.size();
+  auto const version = response.version();
+  auto const status = response.result_int();
+  storage_ += "HTTP/";
+  storage_ += static_cast<char>('0' + version / 10);
+  storage_ += '.';
+  storage_ += static_cast<char>('0' + version % 10);
+  storage_ += ' ';
+  storage_ += static_cast<char>('0' + status / 100 % 10);
+  storage_ += static_cast<char>('0' + status / 10 % 10);
+  storage_ += static_cast<char>('0' + status % 10);
+  storage_ += ' ';
+  storage_ += response.reason();
+  storage_ += "\r\n";
+  for (auto const& f : response) {
+    storage_ += f.name_string();
+    storage_ += ": ";
+    storage_ += f.value();
+    storage_ += "\r\n";
+  }
+  if (headers != nullptr) headers->AppendTo(storage_);
+  storage_ += "\r\n";
+  auto const& body = response.body();
+  auto const inline_body = body.size() <= kInlineBodySize;
+  if (inline_body) storage_ += body;
+  Commit(start);
+  if (inline_body) return;
+  segments_.push_back(Segment{body.data(), 0, body.size()});
+}
+
+std::vector<boost::asio::const_buffer> const& ResponseSerializer::buffers() {
+  // The reusable buffer may grow while appending, the buffers are computed
+  // once all the responses are serialized.
+  buffers_.clear();
+  for (auto const& s : segments_) {
+    auto const* data = s.data == nullptr ? storage_.data() + s.offset : s.data;
+    buffers_.emplace_back(data, s.size);
+  }
+  return buffers_;
+}
+
+void ResponseSerializer::Clear() {
+  storage_.clear();
+  segments_.clear();
+  buffers_.clear();
+}
+
+void ResponseSerializer::Commit(std::size_t start) {
+  auto const size = storage_.size() - start;
+  bytes_copied_ += size;
+  if (segments_.empty() || segments_.back().data != nullptr) {
+    segments_.push_back(Segment{nullptr, start, 0});
+  }
+  segments_.back().size += size;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
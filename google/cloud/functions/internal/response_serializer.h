@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_RESPONSE_SERIALIZER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_RESPONSE_SERIALIZER_H
+
+#include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/internal/static_headers.h"
+#include "google/cloud/functions/version.h"
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Serializes a batch of HTTP responses for a single gathered write.
+ *
+ * The response headers, and any small bodies, are copied into a buffer that is
+ * reused across batches. Larger bodies are referenced in place. Consecutive
+ * bytes in the reusable buffer form a single `const_buffer`, so a batch of
+ * small responses is usually sent with a single `writev()` entry.
+ *
+ * The responses must be prepared (e.g. with `prepare_payload()`) before they
+ * are appended, and must outlive the buffers returned by `buffers()`.
+ */
+class ResponseSerializer {
+ public:
+  /// Bodies up to this size are copied next to their header.
+  static std::size_t constexpr kInlineBodySize = 1024;
+
+  /// Appends @p response, and the fields in @p headers (if any), to the batch.
+  void Append(BeastResponse const& response,
+              StaticHeaders const* headers = nullptr);
+
+  /// The buffers for the batch, valid until the next call to `Clear()`.
+  std::vector<boost::asio::const_buffer> const& buffers();
+
+  /// Starts a new batch, keeping any allocated memory.
+  void Clear();
+
+  /// The number of bytes copied into the reusable buffer.
+  std::size_t bytes_copied() const { return bytes_copied_; }
+
+ private:
+  // A range in the reusable buffer if `data` is null, otherwise a range in a
+  // response body.
+  struct Segment {
+    char const* data;
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  // Adds the bytes appended to `storage_` since @p start to the batch.
+  void Commit(std::size_t start);
+
+  std::string storage_;
+  std::vector<Segment> segments_;
+  std::vector<boost::asio::const_buffer> buffers_;
+  std::size_t bytes_copied_ = 0;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_RESPONSE_SERIALIZER_H
@@ -0,0 +1,146 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/response_serializer.h"
+#include <benchmark/benchmark.h>
+#include <boost/asio/write.hpp>
+#include <boost/beast/http/write.hpp>
+#include <boost/beast/version.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = ::boost::beast::http;
+
+// `writes` is the number of `write_some()` calls (i.e. syscalls on a real
+// socket), `buffers` the number of iovec entries, and `copied` the bytes
+// copied by the serializer, all per response.
+
+/// A SyncWriteStream that counts the calls and buffers, and discards the data.
+class CountingStream {
+ public:
+  template <typename ConstBufferSequence>
+  std::size_t write_some(ConstBufferSequence const& buffers) {
+    ++writes_;
+    std::size_t n = 0;
+    for (auto i = boost::asio::buffer_sequence_begin(buffers);
+         i != boost::asio::buffer_sequence_end(buffers); ++i) {
+      ++buffers_;
+      n += boost::asio::const_buffer(*i).size();
+    }
+    return n;
+  }
+
+  template <typename ConstBufferSequence>
+  std::size_t write_some(ConstBufferSequence const& buffers,
+                         boost::system::error_code& ec) {
+    ec = {};
+    return write_some(buffers);
+  }
+
+  std::int64_t writes() const { return writes_; }
+  std::int64_t buffers() const { return buffers_; }
+
+ private:
+  std::int64_t writes_ = 0;
+  std::int64_t buffers_ = 0;
+};
+
+std::vector<BeastResponse> MakeResponses(std::int64_t count) {
+  std::vector<BeastResponse> responses;
+  for (std::int64_t i = 0; i != count; ++i) {
+    BeastResponse r{http::status::ok, 11};
+    r.set(http::field::content_type, "application/json");
+    r.body() = R"js({"status":"ok"})js";
+    r.prepare_payload();
+    responses.push_back(std::move(r));
+  }
+  return responses;
+}
+
+void SetCounters(benchmark::State& state, CountingStream const& stream,
+                 std::size_t copied) {
+  auto const responses = static_cast<double>(state.iterations() *
+                                             state.range(0));
+  state.counters["writes"] = static_cast<double>(stream.writes()) / responses;
+  state.counters["buffers"] =
+      static_cast<double>(stream.buffers()) / responses;
+  state.counters["copied"] = static_cast<double>(copied) / responses;
+}
+
+// The original write path: one `http::write()` per response.
+void BM_BeastWritePerResponse(benchmark::State& state) {
+  auto const responses = MakeResponses(state.range(0));
+  CountingStream stream;
+  for (auto _ : state) {
+    for (auto const& r : responses) http::write(stream, r);
+  }
+  SetCounters(state, stream, 0);
+}
+BENCHMARK(BM_BeastWritePerResponse)->Arg(1)->Arg(16);
+
+// The current write path: one gathered write per batch of responses.
+void BM_GatheredWrite(benchmark::State& state) {
+  auto const responses = MakeResponses(state.range(0));
+  CountingStream stream;
+  ResponseSerializer serializer;
+  for (auto _ : state) {
+    serializer.Clear();
+    for (auto const& r : responses) serializer.Append(r);
+    boost::asio::write(stream, serializer.buffers());
+  }
+  SetCounters(state, stream, serializer.bytes_copied());
+}
+BENCHMARK(BM_GatheredWrite)->Arg(1)->Arg(16);
+
+// Setting the `Server` header in each response, as the framework used to do.
+void BM_ServerHeaderPerResponse(benchmark::State& state) {
+  auto responses = MakeResponses(state.range(0));
+  CountingStream stream;
+  ResponseSerializer serializer;
+  for (auto _ : state) {
+    serializer.Clear();
+    for (auto& r : responses) {
+      r.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+      serializer.Append(r);
+      r.erase(http::field::server);
+    }
+    boost::asio::write(stream, serializer.buffers());
+  }
+  SetCounters(state, stream, serializer.bytes_copied());
+}
+BENCHMARK(BM_ServerHeaderPerResponse)->Arg(1)->Arg(16);
+
+// Splicing the pre-rendered `Server`, and optionally `Date`, headers into each
+// response.
+void BM_StaticHeaders(benchmark::State& state) {
+  auto const responses = MakeResponses(state.range(0));
+  StaticHeaders const headers({}, /*date=*/state.range(1) != 0);
+  CountingStream stream;
+  ResponseSerializer serializer;
+  for (auto _ : state) {
+    serializer.Clear();
+    for (auto const& r : responses) serializer.Append(r, &headers);
+    boost::asio::write(stream, serializer.buffers());
+  }
+  SetCounters(state, stream, serializer.bytes_copied());
+}
+BENCHMARK(BM_StaticHeaders)->Args({1, 0})->Args({16, 0})->Args({16, 1});
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,111 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/response_serializer.h"
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <gmock/gmock.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = ::boost::beast::http;
+
+BeastResponse MakeResponse(std::string body) {
+  BeastResponse response{http::status::ok, 11};
+  response.set(http::field::content_type, "text/plain");
+  response.body() = std::move(body);
+  response.prepare_payload();
+  return response;
+}
+
+std::string ToString(std::vector<boost::asio::const_buffer> const& buffers) {
+  return boost::beast::buffers_to_string(buffers);
+}
+
+TEST(ResponseSerializerTest, SmallResponse) {
+  auto const response = MakeResponse("Hello World");
+  ResponseSerializer serializer;
+  serializer.Append(response);
+  auto const& buffers = serializer.buffers();
+  // The header and the small body are in a single buffer.
+  ASSERT_EQ(buffers.size(), 1);
+  EXPECT_EQ(ToString(buffers),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Length: 11\r\n"
+            "\r\n"
+            "Hello World");
+  EXPECT_EQ(serializer.bytes_copied(), ToString(buffers).size());
+}
+
+TEST(ResponseSerializerTest, LargeBodyInPlace) {
+  auto const body = std::string(ResponseSerializer::kInlineBodySize + 1, 'x');
+  auto const response = MakeResponse(body);
+  ResponseSerializer serializer;
+  serializer.Append(response);
+  auto const& buffers = serializer.buffers();
+  ASSERT_EQ(buffers.size(), 2);
+  EXPECT_EQ(buffers[1].data(), response.body().data());
+  EXPECT_EQ(buffers[1].size(), body.size());
+  EXPECT_EQ(serializer.bytes_copied(), buffers[0].size());
+}
+
+TEST(ResponseSerializerTest, CoalescesSmallResponses) {
+  auto const large = std::string(ResponseSerializer::kInlineBodySize * 2, 'x');
+  std::vector<BeastResponse> responses{MakeResponse("a"), MakeResponse("b"),
+                                       MakeResponse(large), MakeResponse("c")};
+  ResponseSerializer serializer;
+  std::string expected;
+  for (auto const& r : responses) {
+    serializer.Append(r);
+    std::ostringstream os;
+    os << r;
+    expected += std::move(os).str();
+  }
+  // The first two responses and the header of the third share a buffer, the
+  // large body gets its own, and the last response gets one more.
+  EXPECT_EQ(serializer.buffers().size(), 3);
+  EXPECT_EQ(ToString(serializer.buffers()), expected);
+}
+
+TEST(ResponseSerializerTest, StaticHeaders) {
+  auto const response = MakeResponse("Hello World");
+  StaticHeaders const headers({"X-Instance: abc"}, /*date=*/false);
+  ResponseSerializer serializer;
+  serializer.Append(response, &headers);
+  std::string fields;
+  headers.AppendTo(fields);
+  EXPECT_EQ(ToString(serializer.buffers()),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Length: 11\r\n" +
+                fields +
+                "\r\n"
+                "Hello World");
+}
+
+TEST(ResponseSerializerTest, Clear) {
+  ResponseSerializer serializer;
+  serializer.Append(MakeResponse("first"));
+  serializer.Clear();
+  serializer.Append(MakeResponse("second"));
+  EXPECT_THAT(ToString(serializer.buffers()), ::testing::EndsWith("second"));
+  EXPECT_THAT(ToString(serializer.buffers()),
+              ::testing::Not(::testing::HasSubstr("first")));
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
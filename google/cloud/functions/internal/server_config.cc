@@ -0,0 +1,154 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/server_config.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+ServerConfig MakeServerConfig(boost::program_options::variables_map const& vm) {
+  ServerConfig config;
+  if (vm.count("unix-socket") != 0) {
+    config.unix_socket = vm["unix-socket"].as<std::string>();
+  }
+  if (vm.count("listen-backlog") != 0) {
+    config.listen_backlog = vm["listen-backlog"].as<int>();
+  }
+  if (vm.count("socket-receive-buffer") != 0) {
+    config.receive_buffer_bytes = vm["socket-receive-buffer"].as<int>();
+  }
+  if (vm.count("socket-send-buffer") != 0) {
+    config.send_buffer_bytes = vm["socket-send-buffer"].as<int>();
+  }
+  if (vm.count("tcp-nodelay") != 0) {
+    config.tcp_nodelay = vm["tcp-nodelay"].as<bool>();
+  }
+  if (vm.count("tcp-quickack") != 0) {
+    config.tcp_quickack = vm["tcp-quickack"].as<bool>();
+  }
+  if (vm.count("session-engine") != 0 &&
+      vm["session-engine"].as<std::string>() == "async") {
+    config.engine = SessionEngine::kAsync;
+  }
+  if (vm.count("io-threads") != 0) {
+    config.io_threads = vm["io-threads"].as<int>();
+  }
+  if (vm.count("handler-threads") != 0) {
+    config.handler_threads = vm["handler-threads"].as<int>();
+  }
+  if (vm.count("handler-queue-size") != 0) {
+    config.handler_queue_size =
+        static_cast<std::size_t>(vm["handler-queue-size"].as<int>());
+  }
+  if (vm.count("reactors") != 0) config.reactors = vm["reactors"].as<int>();
+  if (vm.count("max-sessions") != 0) {
+    config.max_sessions =
+        static_cast<std::size_t>(vm["max-sessions"].as<int>());
+  }
+  if (vm.count("max-queued-sessions") != 0) {
+    config.max_queued_sessions =
+        static_cast<std::size_t>(vm["max-queued-sessions"].as<int>());
+  }
+  if (vm.count("session-limit-action") != 0) {
+    config.reject_when_full =
+        vm["session-limit-action"].as<std::string>() == "reject";
+  }
+  if (vm.count("max-concurrent-requests") != 0) {
+    config.max_concurrent_requests =
+        static_cast<std::size_t>(vm["max-concurrent-requests"].as<int>());
+  }
+  if (vm.count("max-queued-requests") != 0) {
+    config.max_queued_requests =
+        static_cast<std::size_t>(vm["max-queued-requests"].as<int>());
+  }
+  if (vm.count("adaptive-concurrency") != 0) {
+    config.adaptive_concurrency = vm["adaptive-concurrency"].as<bool>();
+  }
+  if (vm.count("overload-status") != 0) {
+    config.overload_status = vm["overload-status"].as<int>();
+  }
+  if (vm.count("static-header") != 0) {
+    config.static_headers = vm["static-header"].as<std::vector<std::string>>();
+  }
+  if (vm.count("date-header") != 0) {
+    config.date_header = vm["date-header"].as<bool>();
+  }
+  if (vm.count("compression") != 0) {
+    config.compression = vm["compression"].as<bool>();
+  }
+  if (vm.count("compression-level") != 0) {
+    config.compression_level = vm["compression-level"].as<int>();
+  }
+  if (vm.count("compression-min-bytes") != 0) {
+    config.compression_min_bytes =
+        static_cast<std::size_t>(vm["compression-min-bytes"].as<int>());
+  }
+  if (vm.count("compression-type") != 0) {
+    config.compression_types =
+        vm["compression-type"].as<std::vector<std::string>>();
+  }
+  if (vm.count("output-flush") != 0) {
+    auto const& mode = vm["output-flush"].as<std::string>();
+    if (mode == "always") config.output_mode = OutputMode::kAlways;
+    if (mode == "on-output") config.output_mode = OutputMode::kOnOutput;
+    if (mode == "capture") config.output_mode = OutputMode::kCapture;
+  }
+  if (vm.count("max-body-bytes") != 0) {
+    config.max_body_bytes =
+        static_cast<std::uint64_t>(vm["max-body-bytes"].as<std::int64_t>());
+  }
+  if (vm.count("decompress-requests") != 0) {
+    config.decompress_requests = vm["decompress-requests"].as<bool>();
+  }
+  if (vm.count("max-decompressed-body-bytes") != 0) {
+    config.max_decompressed_body_bytes = static_cast<std::uint64_t>(
+        vm["max-decompressed-body-bytes"].as<std::int64_t>());
+  }
+  if (vm.count("max-header-bytes") != 0) {
+    config.max_header_bytes =
+        static_cast<std::uint32_t>(vm["max-header-bytes"].as<int>());
+  }
+  if (vm.count("h2c") != 0) config.h2c = vm["h2c"].as<bool>();
+  if (vm.count("handle-signals") != 0) {
+    config.handle_signals = vm["handle-signals"].as<bool>();
+  }
+  if (vm.count("stats-log-interval") != 0) {
+    config.stats_log_interval =
+        std::chrono::seconds(vm["stats-log-interval"].as<int>());
+  }
+  auto seconds = [&vm](char const* name, std::chrono::seconds& value) {
+    if (vm.count(name) == 0) return;
+    value = std::chrono::seconds(vm[name].as<int>());
+  };
+  seconds("tcp-defer-accept", config.defer_accept);
+  seconds("request-queue-timeout", config.request_queue_timeout);
+  seconds("drain-timeout", config.drain_timeout);
+  seconds("idle-timeout", config.idle_timeout);
+  seconds("header-read-timeout", config.header_read_timeout);
+  seconds("body-read-timeout", config.body_read_timeout);
+  seconds("write-timeout", config.write_timeout);
+  // hardware_concurrency() may return 0 if the value is not computable.
+  auto const cores =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  if (config.io_threads == 0) config.io_threads = cores;
+  if (config.reactors == 0) config.reactors = cores;
+  return config;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
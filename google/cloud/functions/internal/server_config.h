@@ -0,0 +1,153 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SERVER_CONFIG_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SERVER_CONFIG_H
+
+#include "google/cloud/functions/version.h"
+#include <boost/program_options/variables_map.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/// How the server maps connections to threads.
+enum class SessionEngine {
+  /// Run each connection in its own thread.
+  kThreads,
+  /// Multiplex all connections over a small pool of I/O threads.
+  kAsync,
+};
+
+/// How the server flushes the function output before each response.
+enum class OutputMode {
+  /// Flush `std::cout`, `std::clog` and `std::cerr` after each request.
+  kAlways,
+  /// Flush only if there was some output.
+  kOnOutput,
+  /// Capture the output in per-thread buffers, drained after each request.
+  kCapture,
+};
+
+/// The server configuration, as set by the command-line options.
+struct ServerConfig {
+  /// If not empty, listen on this Unix domain socket instead of a TCP port.
+  std::string unix_socket;
+  /// The listen backlog, 0 uses the system maximum (`SOMAXCONN`).
+  int listen_backlog = 0;
+  /// The `SO_RCVBUF` and `SO_SNDBUF` sizes, 0 keeps the system defaults.
+  int receive_buffer_bytes = 0;
+  int send_buffer_bytes = 0;
+  /// If true, disable Nagle's algorithm (set `TCP_NODELAY`) on connections.
+  bool tcp_nodelay = true;
+  /// If true, set `TCP_QUICKACK` on new connections (Linux only).
+  bool tcp_quickack = false;
+  /// Wake up the acceptor only once the client sends data, or after this
+  /// timeout, 0 disables `TCP_DEFER_ACCEPT` (Linux only).
+  std::chrono::seconds defer_accept{0};
+  SessionEngine engine = SessionEngine::kThreads;
+  /// The number of threads running the asynchronous session engine.
+  int io_threads = 1;
+  /// The number of threads running the user function, 0 runs the function in
+  /// the thread that read the request.
+  int handler_threads = 0;
+  /// The maximum number of requests waiting for a handler thread.
+  std::size_t handler_queue_size = 64;
+  /// The number of reactors, each with its own `SO_REUSEPORT` listener.
+  int reactors = 1;
+  /// The maximum number of concurrent sessions, 0 disables the limit. With
+  /// multiple reactors the limit is split evenly across the reactors.
+  std::size_t max_sessions = 160;
+  /// The maximum number of accepted connections waiting for a session slot.
+  std::size_t max_queued_sessions = 0;
+  /// If true, reject new connections once the session queue is full,
+  /// otherwise stop accepting new connections until a session completes.
+  bool reject_when_full = false;
+  /// The maximum number of concurrent function invocations, 0 disables the
+  /// limit. With multiple reactors the limit is split evenly across them.
+  std::size_t max_concurrent_requests = 0;
+  /// The maximum number of requests waiting for one of the
+  /// `max_concurrent_requests` slots.
+  std::size_t max_queued_requests = 0;
+  /// How long a request may wait for a slot, 0 waits indefinitely.
+  std::chrono::seconds request_queue_timeout{0};
+  /// If true, adjust the concurrency limit from the function latency, up to
+  /// `max_concurrent_requests`, see `AdaptiveLimit`.
+  bool adaptive_concurrency = false;
+  /// The status code for requests rejected due to overload, 429 or 503.
+  int overload_status = 503;
+  /// Additional header fields, in `Name: value` format, for every response.
+  std::vector<std::string> static_headers;
+  /// If true, include a `Date` header in every response.
+  bool date_header = false;
+  /// If true, compress the response bodies, see `ResponseCompressor`.
+  /// Requires a build with compression support.
+  bool compression = false;
+  /// The zlib compression level, from 1 (fastest) to 9 (smallest).
+  int compression_level = 6;
+  /// Only compress response bodies of at least this size.
+  std::size_t compression_min_bytes = 1024;
+  /// Only compress responses with these media types, `type/*` matches any
+  /// subtype.
+  std::vector<std::string> compression_types = {
+      "text/*", "application/json", "application/javascript",
+      "application/xml", "image/svg+xml"};
+  OutputMode output_mode = OutputMode::kOnOutput;
+  /// The maximum size of a request body, 0 disables the limit. Requests with a
+  /// larger body receive a `413 Payload Too Large` response.
+  std::uint64_t max_body_bytes = 1024 * 1024;
+  /// If true, decode request bodies sent with `Content-Encoding: gzip` or
+  /// `deflate`. Requires a build with compression support.
+  bool decompress_requests = false;
+  /// The maximum size of a decoded request body, 0 disables the limit.
+  std::uint64_t max_decompressed_body_bytes = 10 * 1024 * 1024;
+  /// The maximum size of the request line and header fields, 0 disables the
+  /// limit. Requests with a larger header receive a `431 Request Header Fields
+  /// Too Large` response.
+  std::uint32_t max_header_bytes = 8 * 1024;
+  /// If true, accept HTTP/2 cleartext (h2c) connections, with prior knowledge
+  /// or via `Upgrade: h2c`. Requires a build with HTTP/2 support.
+  bool h2c = false;
+  /// If true, drain the server on `SIGINT` or `SIGTERM`.
+  bool handle_signals = true;
+  /// How long to wait for the requests in flight after a termination signal.
+  std::chrono::seconds drain_timeout{10};
+  /// How often to log the server stats, 0 disables logging.
+  std::chrono::seconds stats_log_interval{0};
+  /**
+   * @name Connection deadlines, 0 disables the deadline.
+   *
+   * A connection is idle until it receives the first bytes of a request. The
+   * header and body deadlines start when the client starts sending the request
+   * header and body, respectively.
+   */
+  ///@{
+  std::chrono::seconds idle_timeout{0};
+  std::chrono::seconds header_read_timeout{0};
+  std::chrono::seconds body_read_timeout{0};
+  std::chrono::seconds write_timeout{0};
+  ///@}
+};
+
+/// Extract the server configuration from the parsed command-line options.
+ServerConfig MakeServerConfig(boost::program_options::variables_map const& vm);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SERVER_CONFIG_H
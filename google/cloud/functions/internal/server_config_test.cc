@@ -0,0 +1,284 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/server_config.h"
+#include "google/cloud/functions/internal/parse_options.h"
+#include "google/cloud/functions/internal/setenv.h"
+#include <gmock/gmock.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Ge;
+
+TEST(ServerConfigTest, Defaults) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.engine, SessionEngine::kThreads);
+  EXPECT_THAT(config.io_threads, Ge(1));
+}
+
+TEST(ServerConfigTest, AsyncEngine) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--session-engine=async", "--io-threads=3"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.engine, SessionEngine::kAsync);
+  EXPECT_EQ(config.io_threads, 3);
+}
+
+TEST(ServerConfigTest, Reactors) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--session-engine=async", "--reactors=4",
+                        "--stats-log-interval=30"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.reactors, 4);
+  EXPECT_EQ(config.stats_log_interval, std::chrono::seconds(30));
+}
+
+TEST(ServerConfigTest, ReactorPerCore) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--session-engine=async", "--reactors=0"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_THAT(config.reactors, Ge(1));
+}
+
+TEST(ServerConfigTest, Timeouts) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--idle-timeout=1", "--header-read-timeout=2",
+                        "--body-read-timeout=3", "--write-timeout=4"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.idle_timeout, std::chrono::seconds(1));
+  EXPECT_EQ(config.header_read_timeout, std::chrono::seconds(2));
+  EXPECT_EQ(config.body_read_timeout, std::chrono::seconds(3));
+  EXPECT_EQ(config.write_timeout, std::chrono::seconds(4));
+}
+
+TEST(ServerConfigTest, UnixSocket) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--unix-socket=/run/function.sock"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.unix_socket, "/run/function.sock");
+
+  char const* defaults[] = {"unused"};
+  auto const d = MakeServerConfig(
+      ParseOptions(sizeof(defaults) / sizeof(defaults[0]), defaults));
+  EXPECT_EQ(d.unix_socket, "");
+}
+
+TEST(ServerConfigTest, SocketOptions) {
+  SetEnv("PORT", std::nullopt);
+  char const* defaults[] = {"unused"};
+  auto const d = MakeServerConfig(
+      ParseOptions(sizeof(defaults) / sizeof(defaults[0]), defaults));
+  EXPECT_TRUE(d.tcp_nodelay);
+  EXPECT_FALSE(d.tcp_quickack);
+  EXPECT_EQ(d.listen_backlog, 0);
+  EXPECT_EQ(d.receive_buffer_bytes, 0);
+  EXPECT_EQ(d.send_buffer_bytes, 0);
+  EXPECT_EQ(d.defer_accept, std::chrono::seconds(0));
+
+  char const* argv[] = {"unused",
+                        "--tcp-nodelay=false",
+                        "--listen-backlog=128",
+                        "--socket-receive-buffer=65536",
+                        "--socket-send-buffer=131072",
+                        "--tcp-defer-accept=5"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_FALSE(config.tcp_nodelay);
+  EXPECT_EQ(config.listen_backlog, 128);
+  EXPECT_EQ(config.receive_buffer_bytes, 65536);
+  EXPECT_EQ(config.send_buffer_bytes, 131072);
+  EXPECT_EQ(config.defer_accept, std::chrono::seconds(5));
+}
+
+TEST(ServerConfigTest, SocketOptionsFromEnv) {
+  SetEnv("PORT", std::nullopt);
+  SetEnv("FUNCTION_TCP_NODELAY", "false");
+  SetEnv("FUNCTION_LISTEN_BACKLOG", "64");
+  SetEnv("FUNCTION_SOCKET_SEND_BUFFER", "32768");
+  char const* argv[] = {"unused", "--listen-backlog=256"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  SetEnv("FUNCTION_TCP_NODELAY", std::nullopt);
+  SetEnv("FUNCTION_LISTEN_BACKLOG", std::nullopt);
+  SetEnv("FUNCTION_SOCKET_SEND_BUFFER", std::nullopt);
+  EXPECT_FALSE(config.tcp_nodelay);
+  EXPECT_EQ(config.send_buffer_bytes, 32768);
+  // The command-line overrides the environment.
+  EXPECT_EQ(config.listen_backlog, 256);
+}
+
+TEST(ServerConfigTest, Compression) {
+  SetEnv("PORT", std::nullopt);
+  char const* defaults[] = {"unused"};
+  auto const d = MakeServerConfig(
+      ParseOptions(sizeof(defaults) / sizeof(defaults[0]), defaults));
+  EXPECT_FALSE(d.compression);
+  EXPECT_EQ(d.compression_level, 6);
+  EXPECT_EQ(d.compression_min_bytes, 1024);
+  EXPECT_THAT(d.compression_types,
+              ElementsAre("text/*", "application/json",
+                          "application/javascript", "application/xml",
+                          "image/svg+xml"));
+
+  char const* argv[] = {"unused", "--compression-level=1",
+                        "--compression-min-bytes=256",
+                        "--compression-type=application/json",
+                        "--compression-type=text/csv"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.compression_level, 1);
+  EXPECT_EQ(config.compression_min_bytes, 256);
+  EXPECT_THAT(config.compression_types,
+              ElementsAre("application/json", "text/csv"));
+}
+
+TEST(ServerConfigTest, DecompressRequests) {
+  SetEnv("PORT", std::nullopt);
+  char const* defaults[] = {"unused"};
+  auto const d = MakeServerConfig(
+      ParseOptions(sizeof(defaults) / sizeof(defaults[0]), defaults));
+  EXPECT_FALSE(d.decompress_requests);
+  EXPECT_EQ(d.max_decompressed_body_bytes, 10 * 1024 * 1024);
+
+  char const* argv[] = {"unused", "--max-decompressed-body-bytes=4096"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.max_decompressed_body_bytes, 4096);
+}
+
+TEST(ServerConfigTest, DrainTimeout) {
+  SetEnv("PORT", std::nullopt);
+  char const* defaults[] = {"unused"};
+  EXPECT_EQ(MakeServerConfig(ParseOptions(1, defaults)).drain_timeout,
+            std::chrono::seconds(10));
+  char const* argv[] = {"unused", "--drain-timeout=25"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.drain_timeout, std::chrono::seconds(25));
+}
+
+TEST(ServerConfigTest, HandleSignals) {
+  SetEnv("PORT", std::nullopt);
+  char const* defaults[] = {"unused"};
+  EXPECT_TRUE(MakeServerConfig(ParseOptions(1, defaults)).handle_signals);
+  char const* argv[] = {"unused", "--handle-signals=false"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_FALSE(config.handle_signals);
+}
+
+TEST(ServerConfigTest, SessionLimits) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--max-sessions=8",
+                        "--max-queued-sessions=4",
+                        "--session-limit-action=reject"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.max_sessions, 8);
+  EXPECT_EQ(config.max_queued_sessions, 4);
+  EXPECT_TRUE(config.reject_when_full);
+}
+
+TEST(ServerConfigTest, RequestLimits) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--max-concurrent-requests=80",
+                        "--max-queued-requests=16", "--overload-status=429",
+                        "--request-queue-timeout=5"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.max_concurrent_requests, 80);
+  EXPECT_EQ(config.max_queued_requests, 16);
+  EXPECT_EQ(config.request_queue_timeout, std::chrono::seconds(5));
+  EXPECT_EQ(config.overload_status, 429);
+  EXPECT_FALSE(config.adaptive_concurrency);
+
+  char const* defaults[] = {"unused"};
+  auto const d = MakeServerConfig(
+      ParseOptions(sizeof(defaults) / sizeof(defaults[0]), defaults));
+  EXPECT_EQ(d.max_concurrent_requests, 0);
+  EXPECT_EQ(d.max_queued_requests, 0);
+  EXPECT_EQ(d.request_queue_timeout, std::chrono::seconds(0));
+  EXPECT_EQ(d.overload_status, 503);
+
+  char const* adaptive[] = {"unused", "--adaptive-concurrency"};
+  auto const a = MakeServerConfig(
+      ParseOptions(sizeof(adaptive) / sizeof(adaptive[0]), adaptive));
+  EXPECT_TRUE(a.adaptive_concurrency);
+}
+
+TEST(ServerConfigTest, StaticHeaders) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--static-header=X-A: a",
+                        "--static-header", "X-B: b", "--date-header"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_THAT(config.static_headers, ElementsAre("X-A: a", "X-B: b"));
+  EXPECT_TRUE(config.date_header);
+}
+
+TEST(ServerConfigTest, SessionLimitsDefault) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.max_sessions, 160);
+  EXPECT_EQ(config.max_queued_sessions, 0);
+  EXPECT_FALSE(config.reject_when_full);
+  EXPECT_THAT(config.static_headers, ::testing::IsEmpty());
+  EXPECT_FALSE(config.date_header);
+}
+
+TEST(ServerConfigTest, OutputMode) {
+  SetEnv("PORT", std::nullopt);
+  auto mode = [](char const* option) {
+    char const* argv[] = {"unused", option};
+    return MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv))
+        .output_mode;
+  };
+  EXPECT_EQ(mode("--output-flush=always"), OutputMode::kAlways);
+  EXPECT_EQ(mode("--output-flush=on-output"), OutputMode::kOnOutput);
+  EXPECT_EQ(mode("--output-flush=capture"), OutputMode::kCapture);
+  EXPECT_EQ(mode("--port=8080"), OutputMode::kOnOutput);
+}
+
+TEST(ServerConfigTest, MessageLimits) {
+  SetEnv("PORT", std::nullopt);
+  char const* argv[] = {"unused", "--max-body-bytes=8589934592",
+                        "--max-header-bytes=16384"};
+  auto const config =
+      MakeServerConfig(ParseOptions(sizeof(argv) / sizeof(argv[0]), argv));
+  EXPECT_EQ(config.max_body_bytes, 8589934592ULL);
+  EXPECT_EQ(config.max_header_bytes, 16384U);
+
+  char const* defaults[] = {"unused"};
+  auto const d = MakeServerConfig(
+      ParseOptions(sizeof(defaults) / sizeof(defaults[0]), defaults));
+  EXPECT_EQ(d.max_body_bytes, 1024 * 1024U);
+  EXPECT_EQ(d.max_header_bytes, 8 * 1024U);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
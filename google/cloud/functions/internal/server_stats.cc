@@ -0,0 +1,73 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/server_stats.h"
+#include <nlohmann/json.hpp>
+#include <iostream>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+std::string FormatServerStats(std::string const& name,
+                              ServerStats const& stats) {
+  auto const load = [](std::atomic<std::uint64_t> const& v) {
+    return v.load(std::memory_order_relaxed);
+  };
+  return nlohmann::json{
+      {"severity", "INFO"},
+      {"message", "functions framework server stats"},
+      {"name", name},
+      {"connections_accepted", load(stats.connections_accepted)},
+      {"requests", load(stats.requests)},
+      {"requests_rejected", load(stats.requests_rejected)},
+      {"sessions_timed_out", load(stats.sessions_timed_out)},
+      {"sessions_active", load(stats.sessions_active)},
+      {"sessions_queued", load(stats.sessions_queued)},
+      {"sessions_rejected", load(stats.sessions_rejected)},
+      {"requests_active", load(stats.requests_active)},
+      {"requests_queued", load(stats.requests_queued)},
+      {"request_limit", load(stats.request_limit)},
+  }
+      .dump();
+}
+
+StatsLogger::StatsLogger(
+    std::chrono::seconds interval,
+    std::vector<std::pair<std::string, ServerStats const*>> stats)
+    : interval_(interval), stats_(std::move(stats)) {
+  thread_ = std::thread([this] {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (!cv_.wait_for(lk, interval_, [this] { return shutdown_; })) {
+      Log();
+    }
+  });
+}
+
+StatsLogger::~StatsLogger() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void StatsLogger::Log() const {
+  for (auto const& [name, stats] : stats_) {
+    std::cerr << FormatServerStats(name, *stats) << std::endl;
+  }
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
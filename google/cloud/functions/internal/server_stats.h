@@ -0,0 +1,91 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SERVER_STATS_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SERVER_STATS_H
+
+#include "google/cloud/functions/version.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Counters describing the server activity.
+ *
+ * Each reactor owns a separate instance, aligned to avoid false sharing, so
+ * updating the counters does not require any cross-core synchronization.
+ */
+struct alignas(64) ServerStats {
+  std::atomic<std::uint64_t> connections_accepted{0};
+  std::atomic<std::uint64_t> requests{0};
+  std::atomic<std::uint64_t> requests_rejected{0};
+  std::atomic<std::uint64_t> sessions_timed_out{0};
+  /// The number of sessions currently running.
+  std::atomic<std::uint64_t> sessions_active{0};
+  /// The number of accepted connections waiting for a session slot.
+  std::atomic<std::uint64_t> sessions_queued{0};
+  std::atomic<std::uint64_t> sessions_rejected{0};
+  /// The number of function invocations currently running, only tracked with
+  /// `--max-concurrent-requests`.
+  std::atomic<std::uint64_t> requests_active{0};
+  /// The number of requests waiting for one of those slots.
+  std::atomic<std::uint64_t> requests_queued{0};
+  /// The current concurrency limit, 0 if there is no limit. With
+  /// `--adaptive-concurrency` this changes with the function latency.
+  std::atomic<std::uint64_t> request_limit{0};
+};
+
+/// Format @p stats as a structured log entry, as expected by Cloud Logging.
+std::string FormatServerStats(std::string const& name,
+                              ServerStats const& stats);
+
+/**
+ * Periodically logs the server stats.
+ *
+ * The entries are written to `std::cerr` as structured logs, one line per
+ * `ServerStats` object.
+ */
+class StatsLogger {
+ public:
+  StatsLogger(std::chrono::seconds interval,
+              std::vector<std::pair<std::string, ServerStats const*>> stats);
+  ~StatsLogger();
+
+  StatsLogger(StatsLogger const&) = delete;
+  StatsLogger& operator=(StatsLogger const&) = delete;
+
+ private:
+  void Log() const;
+
+  std::chrono::seconds interval_;
+  std::vector<std::pair<std::string, ServerStats const*>> stats_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool shutdown_ = false;
+  std::thread thread_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SERVER_STATS_H
@@ -0,0 +1,57 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/server_stats.h"
+#include <gmock/gmock.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(ServerStatsTest, Format) {
+  ServerStats stats;
+  stats.connections_accepted = 3;
+  stats.requests = 5;
+  stats.requests_rejected = 2;
+  stats.sessions_timed_out = 7;
+  stats.sessions_active = 11;
+  stats.sessions_queued = 13;
+  stats.sessions_rejected = 17;
+  stats.requests_active = 19;
+  stats.requests_queued = 23;
+  stats.request_limit = 29;
+  auto const actual = FormatServerStats("reactor-1", stats);
+  EXPECT_THAT(actual, HasSubstr(R"js("severity":"INFO")js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("name":"reactor-1")js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("connections_accepted":3)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("requests":5)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("requests_rejected":2)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("sessions_timed_out":7)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("sessions_active":11)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("sessions_queued":13)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("sessions_rejected":17)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("requests_active":19)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("requests_queued":23)js"));
+  EXPECT_THAT(actual, HasSubstr(R"js("request_limit":29)js"));
+}
+
+TEST(ServerStatsTest, Aligned) {
+  EXPECT_EQ(alignof(ServerStats), 64);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -0,0 +1,109 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/session_registry.h"
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+SessionRegistry::SessionRegistry(std::size_t max_sessions,
+                                 std::size_t max_queued, bool reject_when_full,
+                                 ServerStats& stats)
+    : max_sessions_(max_sessions),
+      max_queued_(max_queued),
+      reject_when_full_(reject_when_full),
+      stats_(stats) {}
+
+SessionRegistry::Admission SessionRegistry::Admit(
+    std::function<void()> start) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (shutdown_) {
+    stats_.sessions_rejected.fetch_add(1, std::memory_order_relaxed);
+    return Admission::kRejected;
+  }
+  if (max_sessions_ == 0 || active_ < max_sessions_) {
+    ++active_;
+    UpdateStats();
+    lk.unlock();
+    start();
+    return Admission::kStarted;
+  }
+  if (queue_.size() < max_queued_) {
+    queue_.push_back(std::move(start));
+    UpdateStats();
+    return Admission::kQueued;
+  }
+  stats_.sessions_rejected.fetch_add(1, std::memory_order_relaxed);
+  return Admission::kRejected;
+}
+
+void SessionRegistry::Release() {
+  std::unique_lock<std::mutex> lk(mu_);
+  std::function<void()> next;
+  if (queue_.empty()) {
+    --active_;
+  } else {
+    // The next queued session takes over the slot released by this session.
+    next = std::move(queue_.front());
+    queue_.pop_front();
+  }
+  UpdateStats();
+  auto resume = std::move(resume_);
+  resume_ = nullptr;
+  // Notify while holding the lock, `WaitForIdle()` callers may destroy the
+  // registry as soon as they return.
+  cv_.notify_all();
+  lk.unlock();
+  if (next) next();
+  if (resume) resume();
+}
+
+bool SessionRegistry::PauseAccept(std::function<void()> resume) {
+  if (reject_when_full_) return false;
+  std::lock_guard<std::mutex> lk(mu_);
+  if (shutdown_ || !Full()) return false;
+  resume_ = std::move(resume);
+  return true;
+}
+
+void SessionRegistry::Shutdown() {
+  std::unique_lock<std::mutex> lk(mu_);
+  shutdown_ = true;
+  auto discarded = std::move(queue_);
+  queue_.clear();
+  resume_ = nullptr;
+  stats_.sessions_rejected.fetch_add(discarded.size(),
+                                     std::memory_order_relaxed);
+  UpdateStats();
+  lk.unlock();
+  // The queued connections are closed as `discarded` goes out of scope.
+}
+
+void SessionRegistry::WaitForIdle() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return active_ == 0; });
+}
+
+bool SessionRegistry::Full() const {
+  return max_sessions_ != 0 && active_ >= max_sessions_ &&
+         queue_.size() >= max_queued_;
+}
+
+void SessionRegistry::UpdateStats() {
+  stats_.sessions_active.store(active_, std::memory_order_relaxed);
+  stats_.sessions_queued.store(queue_.size(), std::memory_order_relaxed);
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
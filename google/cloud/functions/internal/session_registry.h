@@ -0,0 +1,104 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SESSION_REGISTRY_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SESSION_REGISTRY_H
+
+#include "google/cloud/functions/internal/server_stats.h"
+#include "google/cloud/functions/version.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Tracks the active sessions and enforces the session limits.
+ *
+ * New connections start immediately while there are fewer than
+ * `max_sessions` active sessions. Otherwise they wait, in FIFO order, for a
+ * session to complete, up to `max_queued` connections. Once the queue is full
+ * the server either stops accepting new connections, leaving them in the
+ * listen backlog, or rejects them, depending on `reject_when_full`.
+ *
+ * Sessions notify the registry when they complete via `Release()`, which
+ * starts the next queued connection (if any) and resumes accepting.
+ *
+ * With multiple reactors each reactor has its own registry, so the session
+ * accounting does not require any cross-reactor synchronization.
+ */
+class SessionRegistry {
+ public:
+  /// The result of `Admit()`.
+  enum class Admission { kStarted, kQueued, kRejected };
+
+  /// A @p max_sessions value of 0 disables the session limit.
+  SessionRegistry(std::size_t max_sessions, std::size_t max_queued,
+                  bool reject_when_full, ServerStats& stats);
+
+  /**
+   * Starts a new session, or queues it until there is room for it.
+   *
+   * @p start is called (at most once, possibly from a different thread) when
+   * the session can start. Once started, the session must call `Release()`
+   * exactly once when it completes.
+   */
+  Admission Admit(std::function<void()> start);
+
+  /// Called by each session when it completes.
+  void Release();
+
+  /**
+   * Pauses the accept loop if there is no room for new connections.
+   *
+   * If the registry is full, this function returns `true` and calls @p resume
+   * once there is room for a new connection. Otherwise it returns `false` and
+   * @p resume is discarded.
+   */
+  bool PauseAccept(std::function<void()> resume);
+
+  /**
+   * Discards any queued connections and stops admitting new connections.
+   *
+   * The sessions already running are not affected, they still call
+   * `Release()` when they complete.
+   */
+  void Shutdown();
+
+  /// Blocks until all the running sessions complete.
+  void WaitForIdle();
+
+ private:
+  bool Full() const;
+  void UpdateStats();
+
+  std::size_t const max_sessions_;
+  std::size_t const max_queued_;
+  bool const reject_when_full_;
+  ServerStats& stats_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::size_t active_ = 0;
+  std::deque<std::function<void()>> queue_;
+  std::function<void()> resume_;
+  bool shutdown_ = false;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_SESSION_REGISTRY_H
@@ -0,0 +1,108 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/session_registry.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <thread>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using Admission = SessionRegistry::Admission;
+
+TEST(SessionRegistryTest, StartsAndQueues) {
+  ServerStats stats;
+  SessionRegistry registry(2, 1, /*reject_when_full=*/false, stats);
+  int started = 0;
+  auto start = [&started] { ++started; };
+  EXPECT_EQ(registry.Admit(start), Admission::kStarted);
+  EXPECT_EQ(registry.Admit(start), Admission::kStarted);
+  EXPECT_EQ(registry.Admit(start), Admission::kQueued);
+  EXPECT_EQ(started, 2);
+  EXPECT_EQ(stats.sessions_active.load(), 2);
+  EXPECT_EQ(stats.sessions_queued.load(), 1);
+
+  // Completing a session starts the queued session in its slot.
+  registry.Release();
+  EXPECT_EQ(started, 3);
+  EXPECT_EQ(stats.sessions_active.load(), 2);
+  EXPECT_EQ(stats.sessions_queued.load(), 0);
+
+  registry.Release();
+  registry.Release();
+  EXPECT_EQ(stats.sessions_active.load(), 0);
+  registry.WaitForIdle();
+}
+
+TEST(SessionRegistryTest, RejectsWhenFull) {
+  ServerStats stats;
+  SessionRegistry registry(1, 0, /*reject_when_full=*/true, stats);
+  EXPECT_EQ(registry.Admit([] {}), Admission::kStarted);
+  EXPECT_FALSE(registry.PauseAccept([] {}));
+  EXPECT_EQ(registry.Admit([] {}), Admission::kRejected);
+  EXPECT_EQ(stats.sessions_rejected.load(), 1);
+  registry.Release();
+}
+
+TEST(SessionRegistryTest, Unlimited) {
+  ServerStats stats;
+  SessionRegistry registry(0, 0, /*reject_when_full=*/false, stats);
+  for (int i = 0; i != 1000; ++i) {
+    EXPECT_EQ(registry.Admit([] {}), Admission::kStarted);
+  }
+  EXPECT_FALSE(registry.PauseAccept([] {}));
+  EXPECT_EQ(stats.sessions_active.load(), 1000);
+}
+
+TEST(SessionRegistryTest, PauseAndResume) {
+  ServerStats stats;
+  SessionRegistry registry(1, 0, /*reject_when_full=*/false, stats);
+  EXPECT_FALSE(registry.PauseAccept([] {}));
+  EXPECT_EQ(registry.Admit([] {}), Admission::kStarted);
+  int resumed = 0;
+  EXPECT_TRUE(registry.PauseAccept([&resumed] { ++resumed; }));
+  EXPECT_EQ(resumed, 0);
+  registry.Release();
+  EXPECT_EQ(resumed, 1);
+  EXPECT_FALSE(registry.PauseAccept([] {}));
+}
+
+TEST(SessionRegistryTest, ShutdownDiscardsQueue) {
+  ServerStats stats;
+  SessionRegistry registry(1, 2, /*reject_when_full=*/false, stats);
+  int started = 0;
+  auto start = [&started] { ++started; };
+  EXPECT_EQ(registry.Admit(start), Admission::kStarted);
+  EXPECT_EQ(registry.Admit(start), Admission::kQueued);
+  EXPECT_EQ(registry.Admit(start), Admission::kQueued);
+
+  registry.Shutdown();
+  EXPECT_EQ(stats.sessions_queued.load(), 0);
+  EXPECT_EQ(stats.sessions_rejected.load(), 2);
+  EXPECT_EQ(registry.Admit(start), Admission::kRejected);
+
+  auto waiter =
+      std::async(std::launch::async, [&registry] { registry.WaitForIdle(); });
+  EXPECT_EQ(waiter.wait_for(std::chrono::milliseconds(50)),
+            std::future_status::timeout);
+  registry.Release();
+  waiter.get();
+  EXPECT_EQ(started, 1);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
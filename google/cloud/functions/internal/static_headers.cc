@@ -0,0 +1,127 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/static_headers.h"
+#include <boost/beast/version.hpp>
+#include <array>
+#include <cstdio>
+#include <ctime>
+#include <stdexcept>
+#include <string_view>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// RFC 7230 `tchar`, the characters allowed in a header name.
+bool IsTokenChar(char c) {
+  if (c >= '0' && c <= '9') return true;
+  if (c >= 'a' && c <= 'z') return true;
+  if (c >= 'A' && c <= 'Z') return true;
+  for (auto const t : std::string_view("!#$%&'*+-.^_`|~")) {
+    if (c == t) return true;
+  }
+  return false;
+}
+
+std::string_view TrimLeft(std::string_view s) {
+  auto const pos = s.find_first_not_of(" \t");
+  return pos == std::string_view::npos ? std::string_view{} : s.substr(pos);
+}
+
+// The `Date: ...\r\n` line for the current second, cached in each thread.
+std::string const& CurrentDateLine() {
+  thread_local std::time_t cached_time = 0;
+  thread_local std::string cached_line;
+  auto const now = std::chrono::system_clock::now();
+  auto const t = std::chrono::system_clock::to_time_t(now);
+  if (t != cached_time || cached_line.empty()) {
+    cached_time = t;
+    cached_line = "Date: " + FormatHttpDate(now) + "\r\n";
+  }
+  return cached_line;
+}
+
+}  // namespace
+
+StaticHeaders::StaticHeaders(std::vector<std::string> const& headers,
+                             bool date)
+    : date_(date) {
+  block_ = std::string("Server: ") + BOOST_BEAST_VERSION_STRING + "\r\n";
+  names_.emplace_back("Server");
+  if (date_) names_.emplace_back("Date");
+  for (auto const& h : headers) {
+    auto const colon = h.find(':');
+    auto const name = std::string_view(h).substr(0, colon);
+    names_.emplace_back(name);
+    auto const value = TrimLeft(std::string_view(h).substr(colon + 1));
+    block_.append(name.data(), name.size());
+    block_ += ": ";
+    block_.append(value.data(), value.size());
+    block_ += "\r\n";
+  }
+}
+
+void StaticHeaders::AppendTo(std::string& out) const {
+  out += block_;
+  if (date_) out += CurrentDateLine();
+}
+
+void StaticHeaders::EraseFrom(BeastResponse& response) const {
+  // Beast compares the field names without regard to case.
+  for (auto const& name : names_) response.erase(name);
+}
+
+std::string FormatHttpDate(std::chrono::system_clock::time_point tp) {
+  static std::array<char const*, 7> const kDays = {
+      "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+  static std::array<char const*, 12> const kMonths = {
+      "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+      "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  auto const t = std::chrono::system_clock::to_time_t(tp);
+  std::tm tm{};
+#ifdef _WIN32
+  (void)gmtime_s(&tm, &t);
+#else
+  (void)gmtime_r(&t, &tm);
+#endif  // _WIN32
+  // Avoid `strftime()`, the day and month names depend on the locale.
+  std::array<char, 32> buffer{};
+  auto const n = std::snprintf(buffer.data(), buffer.size(),
+                               "%s, %02d %s %04d %02d:%02d:%02d GMT",
+                               kDays[tm.tm_wday], tm.tm_mday,
+                               kMonths[tm.tm_mon], tm.tm_year + 1900,
+                               tm.tm_hour, tm.tm_min, tm.tm_sec);
+  return std::string(buffer.data(), n);
+}
+
+void ValidateStaticHeader(std::string const& header) {
+  auto const colon = header.find(':');
+  if (colon == std::string::npos || colon == 0) {
+    throw std::invalid_argument("Invalid static header (" + header +
+                                "), expected `Name: value`.");
+  }
+  for (auto const c : header.substr(0, colon)) {
+    if (IsTokenChar(c)) continue;
+    throw std::invalid_argument("Invalid static header name (" + header +
+                                ").");
+  }
+  if (header.find_first_of("\r\n") != std::string::npos) {
+    throw std::invalid_argument(
+        "Static headers cannot contain CR or LF characters.");
+  }
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
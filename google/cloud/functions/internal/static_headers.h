@@ -0,0 +1,78 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_STATIC_HEADERS_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_STATIC_HEADERS_H
+
+#include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/version.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * The header fields included in every response.
+ *
+ * The fields are rendered once, when the server starts, and copied verbatim
+ * into each serialized response. This includes the `Server` header, any
+ * instance-wide headers configured by the application, and optionally the
+ * `Date` header.
+ *
+ * The `Date` header is rendered at most once per second, in each thread, so
+ * it requires no synchronization between threads.
+ *
+ * The static fields replace any fields with the same name set by the function.
+ * The sessions call `EraseFrom()` before serializing each response.
+ */
+class StaticHeaders {
+ public:
+  /**
+   * Creates the static header block.
+   *
+   * @param headers additional fields, in `Name: value` format, as validated by
+   *     `ValidateStaticHeader()`.
+   * @param date if true, include a `Date` header in each response.
+   */
+  StaticHeaders(std::vector<std::string> const& headers, bool date);
+
+  /// Appends the static fields to @p out, each terminated by CRLF.
+  void AppendTo(std::string& out) const;
+
+  /// Removes the fields that `AppendTo()` adds from @p response.
+  void EraseFrom(BeastResponse& response) const;
+
+ private:
+  std::string block_;
+  std::vector<std::string> names_;
+  bool date_;
+};
+
+/// Formats @p tp as an RFC 7231 date, e.g. `Sun, 06 Nov 1994 08:49:37 GMT`.
+std::string FormatHttpDate(std::chrono::system_clock::time_point tp);
+
+/**
+ * Validates a static header in `Name: value` format.
+ *
+ * @throws std::invalid_argument if the name is empty or not a valid token, or
+ *     if the header contains a CR or LF character.
+ */
+void ValidateStaticHeader(std::string const& header);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_STATIC_HEADERS_H
@@ -0,0 +1,92 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/static_headers.h"
+#include <boost/beast/version.hpp>
+#include <gmock/gmock.h>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::ContainsRegex;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+TEST(StaticHeadersTest, Server) {
+  StaticHeaders headers({}, /*date=*/false);
+  std::string actual;
+  headers.AppendTo(actual);
+  EXPECT_EQ(actual,
+            std::string("Server: ") + BOOST_BEAST_VERSION_STRING + "\r\n");
+}
+
+TEST(StaticHeadersTest, Additional) {
+  StaticHeaders headers({"X-Instance: abc", "Cache-Control:no-store"},
+                        /*date=*/false);
+  std::string actual;
+  headers.AppendTo(actual);
+  EXPECT_THAT(actual, HasSubstr("\r\nX-Instance: abc\r\n"));
+  EXPECT_THAT(actual, HasSubstr("\r\nCache-Control: no-store\r\n"));
+  EXPECT_THAT(actual, Not(HasSubstr("Date:")));
+}
+
+TEST(StaticHeadersTest, Date) {
+  StaticHeaders headers({}, /*date=*/true);
+  std::string actual;
+  headers.AppendTo(actual);
+  EXPECT_THAT(actual, ContainsRegex("\r\nDate: [A-Z][a-z][a-z], [0-9][0-9] "
+                                    "[A-Z][a-z][a-z] [0-9]+ [0-9:]+ GMT\r\n$"));
+}
+
+TEST(StaticHeadersTest, EraseFrom) {
+  namespace http = boost::beast::http;
+  StaticHeaders headers({"X-Instance: abc"}, /*date=*/true);
+  BeastResponse response;
+  response.set(http::field::server, "function");
+  response.set(http::field::date, "Mon, 01 Jan 2001 00:00:00 GMT");
+  response.set("x-instance", "function");
+  response.set(http::field::content_type, "text/plain");
+  headers.EraseFrom(response);
+  EXPECT_EQ(response.count(http::field::server), 0);
+  EXPECT_EQ(response.count(http::field::date), 0);
+  EXPECT_EQ(response.count("X-Instance"), 0);
+  EXPECT_EQ(response[http::field::content_type], "text/plain");
+
+  // Without `date` the function's `Date` header is kept.
+  StaticHeaders no_date({}, /*date=*/false);
+  response.set(http::field::date, "Mon, 01 Jan 2001 00:00:00 GMT");
+  no_date.EraseFrom(response);
+  EXPECT_EQ(response[http::field::date], "Mon, 01 Jan 2001 00:00:00 GMT");
+}
+
+TEST(StaticHeadersTest, FormatHttpDate) {
+  // The example from RFC 7231, section 7.1.1.1
+  auto const tp = std::chrono::system_clock::from_time_t(784111777);
+  EXPECT_EQ(FormatHttpDate(tp), "Sun, 06 Nov 1994 08:49:37 GMT");
+}
+
+TEST(StaticHeadersTest, Validate) {
+  EXPECT_NO_THROW(ValidateStaticHeader("X-Test: value"));
+  EXPECT_NO_THROW(ValidateStaticHeader("X-Empty:"));
+  EXPECT_THROW(ValidateStaticHeader("no-colon"), std::invalid_argument);
+  EXPECT_THROW(ValidateStaticHeader(": no-name"), std::invalid_argument);
+  EXPECT_THROW(ValidateStaticHeader("Bad Name: value"), std::invalid_argument);
+  EXPECT_THROW(ValidateStaticHeader("X-Test: a\r\nX-Injected: b"),
+               std::invalid_argument);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -14,9 +14,29 @@
 
 #include "google/cloud/functions/internal/wrap_request.h"
 #include "google/cloud/functions/http_request.h"
+#include <algorithm>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+class StringBodyReader : public functions::HttpBodyReader::Impl {
+ public:
+  explicit StringBodyReader(std::string body) : body_(std::move(body)) {}
+
+  std::size_t Read(char* buffer, std::size_t size) override {
+    auto const n = std::min(size, body_.size() - offset_);
+    std::copy_n(body_.data() + offset_, n, buffer);
+    offset_ += n;
+    return n;
+  }
+
+ private:
+  std::string body_;
+  std::size_t offset_ = 0;
+};
+
+}  // namespace
 
 ::google::cloud::functions::HttpRequest MakeHttpRequest(BeastRequest request) {
   auto constexpr kBeastHttpVersionFactor = 10;
@@ -33,5 +53,11 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
   return r;
 }
 
+::google::cloud::functions::HttpBodyReader MakeHttpBodyReader(
+    std::string body) {
+  return ::google::cloud::functions::HttpBodyReader(
+      std::make_unique<StringBodyReader>(std::move(body)));
+}
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
@@ -16,8 +16,11 @@
 #define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_INTERNAL_WRAP_REQUEST_H
 
 #include "google/cloud/functions/internal/http_message_types.h"
+#include "google/cloud/functions/http_body_reader.h"
 #include "google/cloud/functions/http_request.h"
+#include "google/cloud/functions/http_request_view.h"
 #include "google/cloud/functions/version.h"
+#include <string>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -25,6 +28,53 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
 /// Wrap a Boost.Beast request into a functions framework HTTP request.
 ::google::cloud::functions::HttpRequest MakeHttpRequest(BeastRequest request);
 
+/**
+ * Views a Boost.Beast request as a functions framework HTTP request.
+ *
+ * The view returns references into @p request, which must outlive the view.
+ * Header lookups use the Boost.Beast index, which ignores the case.
+ */
+class WrapRequestView : public functions::HttpRequestView::Impl {
+ public:
+  explicit WrapRequestView(BeastRequest const& request) : request_(request) {}
+  ~WrapRequestView() override = default;
+
+  [[nodiscard]] std::string_view verb() const override {
+    return request_.method_string();
+  }
+  [[nodiscard]] std::string_view target() const override {
+    return request_.target();
+  }
+  [[nodiscard]] std::string_view payload() const override {
+    return request_.body();
+  }
+
+  static inline auto constexpr kBeastHttpVersionFactor = 10;
+  [[nodiscard]] int version_major() const override {
+    return static_cast<int>(request_.version()) / kBeastHttpVersionFactor;
+  }
+  [[nodiscard]] int version_minor() const override {
+    return static_cast<int>(request_.version()) % kBeastHttpVersionFactor;
+  }
+
+  [[nodiscard]] std::optional<std::string_view> header(
+      std::string_view name) const override {
+    auto const f = request_.find(name);
+    if (f == request_.end()) return std::nullopt;
+    return f->value();
+  }
+  void ForEachHeader(functions::HttpRequestView::HeaderVisitor const& visitor)
+      const override {
+    for (auto const& f : request_) visitor(f.name_string(), f.value());
+  }
+
+ private:
+  BeastRequest const& request_;
+};
+
+/// Returns a reader for a request body that is already in memory.
+::google::cloud::functions::HttpBodyReader MakeHttpBodyReader(std::string body);
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
 
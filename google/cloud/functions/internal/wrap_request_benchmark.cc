@@ -0,0 +1,85 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/internal/call_user_function.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace google::cloud::functions_internal {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace http = ::boost::beast::http;
+
+// Each iteration calls a function that reads two headers, as most functions
+// only look at a handful of the headers added by the Google frontend. Both
+// include the time to release the Boost.Beast request.
+
+/// A request with @p count headers, similar to those added by a proxy.
+BeastRequest MakeRequest(int count) {
+  BeastRequest request(http::verb::post, "/api/v1/items?page=2", 11);
+  request.set(http::field::host, "example-abcdef-uc.a.run.app");
+  request.set(http::field::content_type, "application/json");
+  for (int i = 0; i != count; ++i) {
+    request.insert("x-forwarded-header-" + std::to_string(i),
+                   "value-" + std::to_string(i) + "-0123456789abcdef");
+  }
+  request.body() = R"js({"id": 42})js";
+  request.prepare_payload();
+  return request;
+}
+
+void BM_HttpRequest(benchmark::State& state) {
+  auto const request = MakeRequest(static_cast<int>(state.range(0)));
+  functions::UserHttpFunction function =
+      [](functions::HttpRequest const& r) {
+        auto const& headers = r.headers();
+        auto const host = headers.find("Host");
+        auto const type = headers.find("Content-Type");
+        benchmark::DoNotOptimize(host);
+        benchmark::DoNotOptimize(type);
+        return functions::HttpResponse{};
+      };
+  for (auto _ : state) {
+    // The framework moves the parsed request, copy it outside the function.
+    state.PauseTiming();
+    auto copy = request;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(CallUserFunction(function, std::move(copy)));
+  }
+}
+BENCHMARK(BM_HttpRequest)->Arg(0)->Arg(20)->Arg(40);
+
+void BM_HttpRequestView(benchmark::State& state) {
+  auto const request = MakeRequest(static_cast<int>(state.range(0)));
+  functions::UserHttpViewFunction function =
+      [](functions::HttpRequestView const& r) {
+        auto const host = r.header("host");
+        auto const type = r.header("content-type");
+        benchmark::DoNotOptimize(host);
+        benchmark::DoNotOptimize(type);
+        return functions::HttpResponse{};
+      };
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto copy = request;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(CallUserFunction(function, copy));
+  }
+}
+BENCHMARK(BM_HttpRequestView)->Arg(0)->Arg(20)->Arg(40);
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions_internal
@@ -14,6 +14,9 @@
 
 #include "google/cloud/functions/internal/wrap_request.h"
 #include <gmock/gmock.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -40,6 +43,57 @@ TEST(WrapRequestTest, Basic) {
   EXPECT_EQ(actual.version_minor(), 1);
 }
 
+TEST(WrapRequestTest, View) {
+  BeastRequest br;
+  br.set("Content-Type", "application/json");
+  br.insert("x-repeated", "1");
+  br.insert("x-repeated", "2");
+  br.body() = "Hello World\n";
+  br.target("/some/random/target");
+  br.method(boost::beast::http::verb::put);
+  auto constexpr kHttp10 = 10;
+  br.version(kHttp10);
+
+  WrapRequestView const impl(br);
+  functions::HttpRequestView const actual(impl);
+  EXPECT_EQ(actual.target(), "/some/random/target");
+  EXPECT_EQ(actual.verb(), "PUT");
+  EXPECT_EQ(actual.payload(), "Hello World\n");
+  EXPECT_EQ(actual.payload().data(), br.body().data());
+  EXPECT_EQ(actual.header("content-type"), "application/json");
+  EXPECT_EQ(actual.header("X-Repeated"), "1");
+  EXPECT_EQ(actual.header("x-missing"), std::nullopt);
+  EXPECT_EQ(actual.version_major(), 1);
+  EXPECT_EQ(actual.version_minor(), 0);
+
+  std::vector<std::pair<std::string, std::string>> headers;
+  actual.ForEachHeader([&headers](std::string_view k, std::string_view v) {
+    headers.emplace_back(k, v);
+  });
+  EXPECT_THAT(headers,
+              ElementsAre(std::make_pair("Content-Type", "application/json"),
+                          std::make_pair("x-repeated", "1"),
+                          std::make_pair("x-repeated", "2")));
+
+  auto const copy = actual.ToHttpRequest();
+  EXPECT_EQ(copy.target(), "/some/random/target");
+  EXPECT_EQ(copy.payload(), "Hello World\n");
+  EXPECT_EQ(copy.headers().size(), 3);
+}
+
+TEST(WrapRequestTest, BodyReader) {
+  auto reader = MakeHttpBodyReader("Hello World\n");
+  std::string buffer(5, '\0');
+  std::string actual;
+  for (auto n = reader.Read(buffer.data(), buffer.size()); n != 0;
+       n = reader.Read(buffer.data(), buffer.size())) {
+    EXPECT_LE(n, buffer.size());
+    actual.append(buffer.data(), n);
+  }
+  EXPECT_EQ(actual, "Hello World\n");
+  EXPECT_EQ(reader.Read(buffer.data(), buffer.size()), 0);
+}
+
 }  // namespace
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
@@ -13,14 +13,53 @@
 // limitations under the License.
 
 #include "google/cloud/functions/internal/wrap_response.h"
+#include <stdexcept>
 
 namespace google::cloud::functions_internal {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+class BufferedResponseWriter : public functions::HttpResponseWriter::Impl {
+ public:
+  explicit BufferedResponseWriter(BeastResponse& response)
+      : response_(response) {}
+
+  void set_result(int code) override {
+    CheckHeadersNotSent();
+    response_.result(code);
+  }
+  void set_header(std::string_view name, std::string_view value) override {
+    CheckHeadersNotSent();
+    response_.set(name, value);
+  }
+  void SendHeaders() override { headers_sent_ = true; }
+  void Write(std::string_view data) override {
+    headers_sent_ = true;
+    response_.body().append(data.data(), data.size());
+  }
+
+ private:
+  void CheckHeadersNotSent() const {
+    if (!headers_sent_) return;
+    throw std::logic_error("the response headers were already sent");
+  }
+
+  BeastResponse& response_;
+  bool headers_sent_ = false;
+};
+
+}  // namespace
 
 /// Wrap a Boost.Beast request into a functions framework HTTP request.
 std::shared_ptr<functions::HttpResponse::Impl> MakeHttpResponse() {
   return std::make_shared<WrapResponseImpl>();
 }
 
+functions::HttpResponseWriter MakeBufferedResponseWriter(
+    BeastResponse& response) {
+  return functions::HttpResponseWriter(
+      std::make_unique<BufferedResponseWriter>(response));
+}
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
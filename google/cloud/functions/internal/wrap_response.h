@@ -17,6 +17,7 @@
 
 #include "google/cloud/functions/internal/http_message_types.h"
 #include "google/cloud/functions/http_response.h"
+#include "google/cloud/functions/http_response_writer.h"
 #include "google/cloud/functions/version.h"
 
 namespace google::cloud::functions_internal {
@@ -40,16 +41,14 @@ class WrapResponseImpl : public google::cloud::functions::HttpResponse::Impl {
     return static_cast<int>(response_.result_int());
   }
 
+  // The headers are copied to the Boost.Beast response once the function
+  // returns, see `UnwrapResponse`, so `headers()` does not need to copy them.
+  // `set_header()` is the only way to add fields to the wrapped response, so
+  // `headers()` returns all of them.
   void set_header(std::string_view name, std::string_view value) override {
-    response_.set(name, value);
-  }
-  [[nodiscard]] Headers headers() const override {
-    Headers h;
-    for (auto const& f : response_) {
-      h.emplace(f.name_string(), f.value());
-    }
-    return h;
+    headers_.set(std::string(name), std::string(value));
   }
+  [[nodiscard]] Headers const& headers() const override { return headers_; }
 
   static inline auto constexpr kBeastHttpVersionFactor = 10;
   void set_version(int major, int minor) override {
@@ -65,11 +64,16 @@ class WrapResponseImpl : public google::cloud::functions::HttpResponse::Impl {
  private:
   friend struct UnwrapResponse;
   BeastResponse response_;
+  Headers headers_;
 };
 
 /// Wrap a Boost.Beast request into a functions framework HTTP request.
 std::shared_ptr<functions::HttpResponse::Impl> MakeHttpResponse();
 
+/// Returns a writer that stores the full response in @p response.
+functions::HttpResponseWriter MakeBufferedResponseWriter(
+    BeastResponse& response);
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions_internal
 
@@ -0,0 +1,116 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_JSON_BODY_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_JSON_BODY_H
+
+#include "google/cloud/functions/version.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A JSON request body.
+ *
+ * Functions look up values using JSON pointers (RFC 6901), e.g. `/topic` or
+ * `/message/attributes/id`. The lookup functions return `std::nullopt` if the
+ * value does not exist, or has a different type.
+ *
+ * The framework parses the body with nlohmann/json by default. Builds with
+ * `FUNCTIONS_FRAMEWORK_CPP_ENABLE_SIMDJSON=ON` use the simdjson On-Demand
+ * API instead: it indexes the body once, and each lookup only parses the
+ * values on the way to the requested field. Functions that read a few fields
+ * of a large body do not pay for a full document tree.
+ *
+ * With either backend the lookup functions are safe to call from multiple
+ * threads.
+ *
+ * @par Example
+ * @code
+ * auto const topic = request.json().GetString("/topic");
+ * if (!topic) throw std::invalid_argument("missing topic in the request");
+ * @endcode
+ */
+class JsonBody {
+ public:
+  /**
+   * Parses @p payload.
+   *
+   * @throws std::invalid_argument if @p payload is not valid JSON. The
+   *     simdjson backend finds some errors only as it parses the values, any
+   *     lookup may throw in that case. It does not validate the values that
+   *     no lookup reads.
+   */
+  explicit JsonBody(std::string_view payload);
+
+  /// The string at @p pointer.
+  [[nodiscard]] std::optional<std::string> GetString(
+      std::string_view pointer) const {
+    return impl_->GetString(pointer);
+  }
+
+  /// The integer at @p pointer, if it is representable as `std::int64_t`.
+  [[nodiscard]] std::optional<std::int64_t> GetInt64(
+      std::string_view pointer) const {
+    return impl_->GetInt64(pointer);
+  }
+
+  /// The number at @p pointer.
+  [[nodiscard]] std::optional<double> GetDouble(
+      std::string_view pointer) const {
+    return impl_->GetDouble(pointer);
+  }
+
+  /// The boolean at @p pointer.
+  [[nodiscard]] std::optional<bool> GetBool(std::string_view pointer) const {
+    return impl_->GetBool(pointer);
+  }
+
+  /**
+   * The value at @p pointer as JSON text, e.g. for objects and arrays.
+   *
+   * The formatting depends on the backend, use a JSON parser to read the
+   * result.
+   */
+  [[nodiscard]] std::optional<std::string> GetJson(
+      std::string_view pointer) const {
+    return impl_->GetJson(pointer);
+  }
+
+  class Impl {
+   public:
+    virtual ~Impl() = 0;
+    virtual std::optional<std::string> GetString(std::string_view pointer) = 0;
+    virtual std::optional<std::int64_t> GetInt64(std::string_view pointer) = 0;
+    virtual std::optional<double> GetDouble(std::string_view pointer) = 0;
+    virtual std::optional<bool> GetBool(std::string_view pointer) = 0;
+    virtual std::optional<std::string> GetJson(std::string_view pointer) = 0;
+  };
+
+  explicit JsonBody(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_JSON_BODY_H
@@ -0,0 +1,120 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/functions/json_body.h"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// Both benchmarks read two fields from the payload. BM_NlohmannParse builds
+// the full document, as `examples/site/tips_gcp_apis` does. BM_JsonBody uses
+// the backend selected at build time. Arg(0) is the legacy Firebase Auth
+// event from `parse_cloud_event_legacy_test.cc`, Arg(1) the Cloud Storage
+// object from `parse_cloud_event_storage_test.cc`, and Arg(2) a listing with
+// 100 of those objects.
+
+auto constexpr kFirebaseAuth = R"js({
+    "data": {
+      "email": "test@nowhere.com",
+      "metadata": {
+        "createdAt": "2020-05-26T10:42:27Z",
+        "lastSignedInAt": "2020-10-24T11:00:00Z"
+      },
+      "providerData": [
+        {
+          "email": "test@nowhere.com",
+          "providerId": "password",
+          "uid": "test@nowhere.com"
+        }
+      ],
+      "uid": "UUpby3s4spZre6kHsgVSPetzQ8l2"
+    },
+    "eventId": "aaaaaa-1111-bbbb-2222-cccccccccccc",
+    "eventType": "providers/firebase.auth/eventTypes/user.create",
+    "notSupported": {
+    },
+    "resource": "projects/my-project-id",
+    "timestamp": "2020-09-29T11:32:00.000Z"
+  })js";
+
+auto constexpr kStorageObject = R"js({
+      "bucket": "some-bucket",
+      "contentType": "text/plain",
+      "crc32c": "rTVTeQ==",
+      "etag": "CNHZkbuF/ugCEAE=",
+      "generation": "1587627537231057",
+      "id": "some-bucket/folder/Test.cs/1587627537231057",
+      "kind": "storage#object",
+      "md5Hash": "kF8MuJ5+CTJxvyhHS1xzRg==",
+      "mediaLink": "https://www.googleapis.com/download/storage/v1/b/some-bucket/o/folder%2FTest.cs?generation=1587627537231057&alt=media",
+      "metageneration": "1",
+      "name": "folder/Test.cs",
+      "selfLink": "https://www.googleapis.com/storage/v1/b/some-bucket/o/folder/Test.cs",
+      "size": "352",
+      "storageClass": "MULTI_REGIONAL",
+      "timeCreated": "2020-04-23T07:38:57.230Z",
+      "timeStorageClassUpdated": "2020-04-23T07:38:57.230Z",
+      "updated": "2020-04-23T07:38:57.230Z"
+    })js";
+
+struct Input {
+  std::string payload;
+  std::string first;
+  std::string second;
+};
+
+Input MakeInput(std::int64_t arg) {
+  if (arg == 0) return {kFirebaseAuth, "/eventType", "/data/uid"};
+  if (arg == 1) return {kStorageObject, "/bucket", "/name"};
+  std::string payload = R"js({"kind": "storage#objects", "items": [)js";
+  for (int i = 0; i != 100; ++i) {
+    if (i != 0) payload += ",";
+    payload += kStorageObject;
+  }
+  payload += "]}";
+  return {std::move(payload), "/kind", "/items/0/name"};
+}
+
+void BM_NlohmannParse(benchmark::State& state) {
+  auto const input = MakeInput(state.range(0));
+  auto const first = nlohmann::json::json_pointer(input.first);
+  auto const second = nlohmann::json::json_pointer(input.second);
+  for (auto _ : state) {
+    auto const json = nlohmann::json::parse(input.payload);
+    benchmark::DoNotOptimize(json.at(first).get<std::string>());
+    benchmark::DoNotOptimize(json.at(second).get<std::string>());
+  }
+}
+BENCHMARK(BM_NlohmannParse)->DenseRange(0, 2);
+
+void BM_JsonBody(benchmark::State& state) {
+  auto const input = MakeInput(state.range(0));
+  for (auto _ : state) {
+    JsonBody const json(input.payload);
+    benchmark::DoNotOptimize(json.GetString(input.first));
+    benchmark::DoNotOptimize(json.GetString(input.second));
+  }
+}
+BENCHMARK(BM_JsonBody)->DenseRange(0, 2);
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,118 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/functions/json_body.h"
+#include <gmock/gmock.h>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::Optional;
+
+// A legacy Firebase Auth event, as in `parse_cloud_event_legacy_test.cc`.
+auto constexpr kPayload = R"js({
+    "data": {
+      "email": "test@nowhere.com",
+      "metadata": {
+        "createdAt": "2020-05-26T10:42:27Z",
+        "lastSignedInAt": "2020-10-24T11:00:00Z"
+      },
+      "providerData": [
+        {
+          "email": "test@nowhere.com",
+          "providerId": "password",
+          "uid": "test@nowhere.com"
+        }
+      ],
+      "uid": "UUpby3s4spZre6kHsgVSPetzQ8l2",
+      "a/b": "escaped",
+      "disabled": false,
+      "loginCount": 42,
+      "score": 0.5,
+      "large": 18446744073709551615
+    },
+    "eventId": "aaaaaa-1111-bbbb-2222-cccccccccccc",
+    "eventType": "providers/firebase.auth/eventTypes/user.create",
+    "resource": "projects/my-project-id",
+    "timestamp": "2020-09-29T11:32:00.000Z"
+  })js";
+
+TEST(JsonBodyTest, GetString) {
+  JsonBody const body(kPayload);
+  EXPECT_THAT(body.GetString("/eventId"),
+              Optional(std::string("aaaaaa-1111-bbbb-2222-cccccccccccc")));
+  EXPECT_THAT(body.GetString("/data/metadata/createdAt"),
+              Optional(std::string("2020-05-26T10:42:27Z")));
+  EXPECT_THAT(body.GetString("/data/providerData/0/providerId"),
+              Optional(std::string("password")));
+  EXPECT_THAT(body.GetString("/data/a~1b"), Optional(std::string("escaped")));
+  // Lookups may happen in any order.
+  EXPECT_THAT(body.GetString("/data/uid"),
+              Optional(std::string("UUpby3s4spZre6kHsgVSPetzQ8l2")));
+}
+
+TEST(JsonBodyTest, GetNumbersAndBooleans) {
+  JsonBody const body(kPayload);
+  EXPECT_THAT(body.GetInt64("/data/loginCount"), Optional(42));
+  EXPECT_THAT(body.GetDouble("/data/loginCount"), Optional(42.0));
+  EXPECT_THAT(body.GetDouble("/data/score"), Optional(0.5));
+  EXPECT_THAT(body.GetBool("/data/disabled"), Optional(false));
+  EXPECT_EQ(body.GetInt64("/data/score"), std::nullopt);
+  EXPECT_EQ(body.GetInt64("/data/large"), std::nullopt);
+}
+
+TEST(JsonBodyTest, Missing) {
+  JsonBody const body(kPayload);
+  EXPECT_EQ(body.GetString("/missing"), std::nullopt);
+  EXPECT_EQ(body.GetString("/data/metadata/missing"), std::nullopt);
+  EXPECT_EQ(body.GetString("/data/providerData/1/providerId"), std::nullopt);
+  EXPECT_EQ(body.GetString("/data/loginCount"), std::nullopt);
+  EXPECT_EQ(body.GetBool("/data/email"), std::nullopt);
+  EXPECT_EQ(body.GetJson("/eventId/x"), std::nullopt);
+}
+
+TEST(JsonBodyTest, GetJson) {
+  JsonBody const body(kPayload);
+  auto const metadata = body.GetJson("/data/metadata");
+  ASSERT_TRUE(metadata.has_value());
+  EXPECT_EQ(nlohmann::json::parse(*metadata),
+            nlohmann::json({{"createdAt", "2020-05-26T10:42:27Z"},
+                            {"lastSignedInAt", "2020-10-24T11:00:00Z"}}));
+  auto const all = body.GetJson("");
+  ASSERT_TRUE(all.has_value());
+  EXPECT_EQ(nlohmann::json::parse(*all), nlohmann::json::parse(kPayload));
+}
+
+TEST(JsonBodyTest, Errors) {
+  JsonBody const body(kPayload);
+  EXPECT_THROW((void)body.GetString("eventId"), std::invalid_argument);
+
+  // Some backends only detect errors as they parse the values.
+  auto parse = [](std::string_view payload) {
+    JsonBody const body(payload);
+    return body.GetString("/b");
+  };
+  EXPECT_THROW(parse(R"js({"a": 1, "b": "x)js"), std::invalid_argument);
+  EXPECT_THROW(parse(R"js({"a": 1, "b": "x")js"), std::invalid_argument);
+  EXPECT_THROW(parse(R"js({"a": 1 "b": "x"})js"), std::invalid_argument);
+  EXPECT_THROW(parse(""), std::invalid_argument);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,347 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/multipart_parser.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// RFC 2046 5.1.1 limits the boundary to 70 characters.
+auto constexpr kMaxBoundarySize = std::size_t{70};
+auto constexpr kReadSize = std::size_t{64 * 1024};
+
+std::string_view Trim(std::string_view s) {
+  auto const begin = s.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) return {};
+  auto const end = s.find_last_not_of(" \t");
+  return s.substr(begin, end - begin + 1);
+}
+
+std::string ToLower(std::string_view s) {
+  std::string result(s);
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+  }
+  return result;
+}
+
+/**
+ * The parameters in a header value, e.g. `form-data; name="a"; filename=b`.
+ *
+ * The parameter names are converted to lowercase, and the quoted values are
+ * unescaped.
+ */
+std::vector<std::pair<std::string, std::string>> Parameters(
+    std::string_view value) {
+  std::vector<std::pair<std::string, std::string>> result;
+  auto pos = value.find(';');
+  while (pos != std::string_view::npos) {
+    value.remove_prefix(pos + 1);
+    auto const eq = value.find_first_of("=;");
+    if (eq == std::string_view::npos || value[eq] == ';') {
+      pos = eq;
+      continue;
+    }
+    auto name = ToLower(Trim(value.substr(0, eq)));
+    value.remove_prefix(eq + 1);
+    auto const begin = value.find_first_not_of(" \t");
+    value.remove_prefix(std::min(begin, value.size()));
+    std::string v;
+    if (!value.empty() && value.front() == '"') {
+      std::size_t i = 1;
+      for (; i < value.size() && value[i] != '"'; ++i) {
+        if (value[i] == '\\' && i + 1 < value.size()) ++i;
+        v.push_back(value[i]);
+      }
+      value.remove_prefix(std::min(i + 1, value.size()));
+      pos = value.find(';');
+    } else {
+      pos = value.find(';');
+      v = std::string(Trim(value.substr(0, pos)));
+    }
+    result.emplace_back(std::move(name), std::move(v));
+  }
+  return result;
+}
+
+HttpHeaders ParsePartHeaders(std::string_view block) {
+  HttpHeaders headers;
+  std::string name;
+  std::string value;
+  auto flush = [&] {
+    if (name.empty()) return;
+    headers.insert(std::move(name), std::move(value));
+    name.clear();
+    value.clear();
+  };
+  while (!block.empty()) {
+    auto const eol = block.find("\r\n");
+    auto const line = block.substr(0, eol);
+    block = eol == std::string_view::npos ? std::string_view{}
+                                          : block.substr(eol + 2);
+    if (line.empty()) continue;
+    if (line.front() == ' ' || line.front() == '\t') {
+      // Obsolete line folding (RFC 7230 3.2.4), join the lines.
+      if (name.empty()) throw std::invalid_argument("invalid part header");
+      value += ' ';
+      value += Trim(line);
+      continue;
+    }
+    flush();
+    auto const colon = line.find(':');
+    if (colon == 0 || colon == std::string_view::npos ||
+        line.substr(0, colon).find_first_of(" \t") != std::string_view::npos) {
+      throw std::invalid_argument("invalid part header");
+    }
+    name = std::string(line.substr(0, colon));
+    value = std::string(Trim(line.substr(colon + 1)));
+  }
+  flush();
+  return headers;
+}
+
+}  // namespace
+
+MultipartPart::MultipartPart(HttpHeaders headers)
+    : headers_(std::move(headers)) {
+  auto const disposition = headers_.find("content-disposition");
+  if (disposition != headers_.end()) {
+    for (auto& [key, value] : Parameters(disposition->second)) {
+      if (key == "name") name_ = std::move(value);
+      if (key == "filename") filename_ = std::move(value);
+    }
+  }
+  auto const type = headers_.find("content-type");
+  if (type != headers_.end()) content_type_ = type->second;
+}
+
+MultipartParser::MultipartParser(std::string_view boundary,
+                                 PartCallback on_part, DataCallback on_data,
+                                 PartCallback on_part_end)
+    : delimiter_("\r\n--" + std::string(boundary)),
+      on_part_(std::move(on_part)),
+      on_data_(std::move(on_data)),
+      on_part_end_(std::move(on_part_end)),
+      // The body may start with the first boundary, without a preamble. This
+      // is the same as a preamble with the CRLF in the delimiter.
+      pending_("\r\n") {
+  if (boundary.empty() || boundary.size() > kMaxBoundarySize) {
+    throw std::invalid_argument("invalid multipart boundary");
+  }
+  // The Boyer-Moore-Horspool skip table for the delimiter.
+  auto const m = delimiter_.size();
+  skip_.fill(m);
+  for (std::size_t i = 0; i + 1 < m; ++i) {
+    skip_[static_cast<unsigned char>(delimiter_[i])] = m - 1 - i;
+  }
+}
+
+std::optional<std::string> MultipartParser::BoundaryFromContentType(
+    std::string_view content_type) {
+  for (auto& [key, value] : Parameters(content_type)) {
+    if (key == "boundary" && !value.empty()) return std::move(value);
+  }
+  return std::nullopt;
+}
+
+void MultipartParser::Parse(std::string_view chunk) {
+  while (!chunk.empty()) {
+    switch (state_) {
+      case State::kPreamble:
+      case State::kBody:
+        chunk = ParseDelimited(chunk);
+        break;
+      case State::kDelimiterLine:
+        chunk = ParseDelimiterLine(chunk);
+        break;
+      case State::kHeaders:
+        chunk = ParseHeaders(chunk);
+        break;
+      case State::kEpilogue:
+        return;
+    }
+  }
+}
+
+void MultipartParser::Parse(HttpBodyReader& reader) {
+  std::vector<char> buffer(kReadSize);
+  for (auto n = reader.Read(buffer.data(), buffer.size()); n != 0;
+       n = reader.Read(buffer.data(), buffer.size())) {
+    Parse(std::string_view(buffer.data(), n));
+  }
+  Finish();
+}
+
+void MultipartParser::Finish() const {
+  if (state_ != State::kEpilogue) {
+    throw std::invalid_argument("the multipart body is incomplete");
+  }
+}
+
+std::size_t MultipartParser::Find(std::string_view text) const {
+  auto const m = delimiter_.size();
+  auto const last = delimiter_.back();
+  for (std::size_t pos = 0; pos + m <= text.size();) {
+    auto const c = text[pos + m - 1];
+    if (c == last &&
+        std::memcmp(text.data() + pos, delimiter_.data(), m - 1) == 0) {
+      return pos;
+    }
+    pos += skip_[static_cast<unsigned char>(c)];
+  }
+  return std::string_view::npos;
+}
+
+std::size_t MultipartParser::PartialMatch(std::string_view text) const {
+  for (auto k = std::min(delimiter_.size() - 1, text.size()); k != 0; --k) {
+    if (text.substr(text.size() - k) ==
+        std::string_view(delimiter_).substr(0, k)) {
+      return k;
+    }
+  }
+  return 0;
+}
+
+std::string_view MultipartParser::ParseDelimited(std::string_view chunk) {
+  if (!pending_.empty()) {
+    auto const state = state_;
+    ResolvePending(chunk);
+    if (state_ != state || !pending_.empty()) return chunk;
+  }
+  auto const pos = Find(chunk);
+  if (pos != std::string_view::npos) {
+    OnData(chunk.substr(0, pos));
+    OnDelimiter();
+    return chunk.substr(pos + delimiter_.size());
+  }
+  // Hold back the end of the chunk if it may be the start of a delimiter.
+  auto const k = PartialMatch(chunk);
+  OnData(chunk.substr(0, chunk.size() - k));
+  pending_.assign(chunk.substr(chunk.size() - k));
+  return {};
+}
+
+void MultipartParser::ResolvePending(std::string_view& chunk) {
+  while (!pending_.empty() && !chunk.empty()) {
+    auto const offset = pending_.size();
+    auto const n = std::min(delimiter_.size() - offset, chunk.size());
+    if (chunk.substr(0, n) == std::string_view(delimiter_).substr(offset, n)) {
+      pending_.append(chunk.data(), n);
+      chunk.remove_prefix(n);
+      if (pending_.size() != delimiter_.size()) return;
+      pending_.clear();
+      OnDelimiter();
+      return;
+    }
+    // The pending bytes are part of the body, except for any suffix that may
+    // still start a delimiter.
+    std::size_t i = 1;
+    while (i != offset && delimiter_.compare(0, offset - i, pending_, i) != 0) {
+      ++i;
+    }
+    OnData(std::string_view(pending_).substr(0, i));
+    pending_.erase(0, i);
+  }
+}
+
+void MultipartParser::OnDelimiter() {
+  if (state_ == State::kBody && on_part_end_) on_part_end_(part_);
+  state_ = State::kDelimiterLine;
+  buffer_.clear();
+}
+
+void MultipartParser::OnData(std::string_view data) {
+  if (state_ == State::kBody && !data.empty()) on_data_(data);
+}
+
+std::string_view MultipartParser::ParseDelimiterLine(std::string_view chunk) {
+  // The delimiter is followed by `--` in the closing delimiter, otherwise by
+  // optional whitespace and a CRLF.
+  while (!chunk.empty()) {
+    auto const c = chunk.front();
+    chunk.remove_prefix(1);
+    auto const last = buffer_.empty() ? '\0' : buffer_.back();
+    if (last == '-' && c == '-') {
+      state_ = State::kEpilogue;
+      return {};
+    }
+    if (last == '\r' && c == '\n') {
+      state_ = State::kHeaders;
+      buffer_.clear();
+      return chunk;
+    }
+    auto const valid = (c == '-' && buffer_.empty()) ||
+                       ((c == ' ' || c == '\t' || c == '\r') && last != '-' &&
+                        last != '\r');
+    if (!valid || buffer_.size() > kMaxHeaderBytes) {
+      throw std::invalid_argument("invalid multipart delimiter");
+    }
+    buffer_.push_back(c);
+  }
+  return chunk;
+}
+
+std::string_view MultipartParser::ParseHeaders(std::string_view chunk) {
+  auto const offset = buffer_.size();
+  auto const n = std::min(chunk.size(), kMaxHeaderBytes + 4 - offset);
+  buffer_.append(chunk.data(), n);
+  // A part without headers starts with the empty line.
+  auto end = std::string::npos;
+  if (buffer_.compare(0, 2, "\r\n") == 0) {
+    end = 2;
+  } else {
+    auto const p = buffer_.find("\r\n\r\n", offset < 3 ? 0 : offset - 3);
+    if (p != std::string::npos) end = p + 4;
+  }
+  if (end == std::string::npos) {
+    if (buffer_.size() > kMaxHeaderBytes) {
+      throw std::invalid_argument("the part headers are too large");
+    }
+    return chunk.substr(n);
+  }
+  part_ = MultipartPart(
+      ParsePartHeaders(std::string_view(buffer_).substr(0, end)));
+  buffer_.clear();
+  state_ = State::kBody;
+  on_part_(part_);
+  return chunk.substr(end - offset);
+}
+
+std::vector<MultipartPartView> ParseMultipart(std::string_view body,
+                                              std::string_view boundary) {
+  std::vector<MultipartPartView> parts;
+  MultipartParser parser(
+      boundary,
+      [&](MultipartPart const& part) {
+        parts.push_back({part, body.substr(body.size())});
+      },
+      [&](std::string_view data) {
+        // With a single call to `Parse()` the pieces of each part are
+        // contiguous in `body`.
+        auto& b = parts.back().body;
+        b = b.empty() ? data
+                      : std::string_view(b.data(), b.size() + data.size());
+      });
+  parser.Parse(body);
+  parser.Finish();
+  return parts;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,181 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_MULTIPART_PARSER_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_MULTIPART_PARSER_H
+
+#include "google/cloud/functions/http_body_reader.h"
+#include "google/cloud/functions/http_headers.h"
+#include "google/cloud/functions/version.h"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/// The headers of a part in a `multipart/form-data` body (RFC 7578).
+class MultipartPart {
+ public:
+  MultipartPart() = default;
+  explicit MultipartPart(HttpHeaders headers);
+
+  /// All the headers in the part, usually `Content-Disposition` and
+  /// `Content-Type`.
+  [[nodiscard]] HttpHeaders const& headers() const { return headers_; }
+
+  /// The `name` parameter in the `Content-Disposition` header.
+  [[nodiscard]] std::string const& name() const { return name_; }
+
+  /// The `filename` parameter in the `Content-Disposition` header, if any.
+  [[nodiscard]] std::optional<std::string> const& filename() const {
+    return filename_;
+  }
+
+  /// The `Content-Type` header, `text/plain` if the part does not have one.
+  [[nodiscard]] std::string const& content_type() const {
+    return content_type_;
+  }
+
+ private:
+  HttpHeaders headers_;
+  std::string name_;
+  std::optional<std::string> filename_;
+  std::string content_type_ = "text/plain";
+};
+
+/**
+ * Parses a `multipart/form-data` body incrementally.
+ *
+ * The parser receives the body in chunks of any size, e.g. as a
+ * `UserHttpStreamingFunction` reads it, and reports each part through
+ * callbacks. The body of each part is delivered as a sequence of
+ * `std::string_view` pieces that point into the chunks passed to `Parse()`,
+ * without copies. Functions can write large parts (e.g. file uploads) to a
+ * file or another sink as they arrive, without keeping the full body in
+ * memory.
+ *
+ * @par Example
+ * @code
+ * auto boundary = MultipartParser::BoundaryFromContentType(content_type);
+ * std::ofstream file;
+ * MultipartParser parser(
+ *     *boundary, [&](MultipartPart const& part) { file.open(part.name()); },
+ *     [&](std::string_view data) { file.write(data.data(), data.size()); },
+ *     [&](MultipartPart const&) { file.close(); });
+ * parser.Parse(reader);
+ * @endcode
+ */
+class MultipartParser {
+ public:
+  /// Called with the headers of each part, before any of its body.
+  using PartCallback = std::function<void(MultipartPart const&)>;
+
+  /// Called with the next piece of the current part body. The data is only
+  /// valid during the call.
+  using DataCallback = std::function<void(std::string_view)>;
+
+  /// The maximum size of the headers in each part.
+  static auto constexpr kMaxHeaderBytes = std::size_t{16 * 1024};
+
+  /**
+   * Creates a parser for a body delimited by @p boundary.
+   *
+   * @param on_part called at the start of each part.
+   * @param on_data called with each piece of the part body.
+   * @param on_part_end called at the end of each part, may be empty.
+   * @throws std::invalid_argument if @p boundary is empty, or longer than the
+   *     70 characters allowed by RFC 2046.
+   */
+  MultipartParser(std::string_view boundary, PartCallback on_part,
+                  DataCallback on_data, PartCallback on_part_end = {});
+
+  /**
+   * Returns the `boundary` parameter in a `Content-Type` header, e.g.
+   * `multipart/form-data; boundary="abc"`.
+   */
+  static std::optional<std::string> BoundaryFromContentType(
+      std::string_view content_type);
+
+  /**
+   * Parses the next chunk of the body.
+   *
+   * @throws std::invalid_argument if the body is malformed.
+   */
+  void Parse(std::string_view chunk);
+
+  /// Reads and parses the full body from @p reader, then calls `Finish()`.
+  void Parse(HttpBodyReader& reader);
+
+  /**
+   * Verifies the body was complete.
+   *
+   * @throws std::invalid_argument if the body ended before the closing
+   *     boundary.
+   */
+  void Finish() const;
+
+  /// True once the parser has seen the closing boundary.
+  [[nodiscard]] bool done() const { return state_ == State::kEpilogue; }
+
+ private:
+  enum class State { kPreamble, kDelimiterLine, kHeaders, kBody, kEpilogue };
+
+  std::size_t Find(std::string_view text) const;
+  std::size_t PartialMatch(std::string_view text) const;
+  std::string_view ParseDelimited(std::string_view chunk);
+  std::string_view ParseDelimiterLine(std::string_view chunk);
+  std::string_view ParseHeaders(std::string_view chunk);
+  void ResolvePending(std::string_view& chunk);
+  void OnDelimiter();
+  void OnData(std::string_view data);
+
+  // "\r\n--" followed by the boundary, see RFC 2046 5.1.1.
+  std::string delimiter_;
+  std::array<std::size_t, 256> skip_{};
+  PartCallback on_part_;
+  DataCallback on_data_;
+  PartCallback on_part_end_;
+  State state_ = State::kPreamble;
+  // A prefix of the delimiter at the end of the previous chunk.
+  std::string pending_;
+  std::string buffer_;
+  MultipartPart part_;
+};
+
+/// A part of a buffered multipart body.
+struct MultipartPartView {
+  MultipartPart part;
+  /// A view into the body passed to `ParseMultipart()`.
+  std::string_view body;
+};
+
+/**
+ * Parses a complete `multipart/form-data` body.
+ *
+ * The part bodies are views into @p body, which must outlive the result.
+ *
+ * @throws std::invalid_argument if the body is malformed.
+ */
+std::vector<MultipartPartView> ParseMultipart(std::string_view body,
+                                              std::string_view boundary);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_MULTIPART_PARSER_H
@@ -0,0 +1,176 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/multipart_parser.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// BM_Example is the parser in examples/site/http_form_data, it needs the full
+// body. BM_MultipartParser receives the body in 64 KiB chunks, as a streaming
+// function would read it. The argument is the size of the uploaded file in
+// KiB, the body also has three small fields.
+
+auto constexpr kBoundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+auto constexpr kContentType =
+    "multipart/form-data; boundary=----WebKitFormBoundary7MA4YWxkTrZu0gW";
+
+std::string MakeBody(std::size_t file_size) {
+  std::string const b = kBoundary;
+  std::string body;
+  for (auto const* name : {"title", "author", "description"}) {
+    body += "--" + b + "\r\n";
+    body += "Content-Disposition: form-data; name=\"" + std::string(name) +
+            "\"\r\n\r\n";
+    body += "some value for the field\r\n";
+  }
+  body += "--" + b + "\r\n";
+  body += "Content-Disposition: form-data; name=\"upload\";";
+  body += " filename=\"image.png\"\r\n";
+  body += "Content-Type: image/png\r\n\r\n";
+  std::uint32_t state = 42;
+  for (std::size_t i = 0; i != file_size; ++i) {
+    state = state * 1664525 + 1013904223;
+    body.push_back(static_cast<char>(state >> 24));
+  }
+  body += "\r\n--" + b + "--\r\n";
+  return body;
+}
+
+// The parser in examples/site/http_form_data, using the standard library
+// instead of `absl::StrSplit()`.
+class ExampleParser {
+ public:
+  using Searcher =
+      std::boyer_moore_horspool_searcher<std::string::const_iterator>;
+
+  explicit ExampleParser(std::string const& header)
+      : part_marker_("\r\n--" + Boundary(header) + "\r\n"),
+        body_marker_("\r\n--" + Boundary(header) + "--\r\n"),
+        part_searcher_(part_marker_.begin(), part_marker_.end()),
+        body_searcher_(body_marker_.begin(), body_marker_.end()) {}
+
+  std::size_t Parse(std::string const& payload) const {
+    std::size_t total = 0;
+    auto pos = payload.begin();
+    while (pos != payload.end()) {
+      auto [end, next] = Find(pos, payload.end());
+      if (end != pos) {
+        total += ParsePart(std::string_view(&*pos, std::distance(pos, end)));
+      }
+      pos = next;
+    }
+    return total;
+  }
+
+ private:
+  static std::string Boundary(std::string const& header) {
+    static auto const kBoundaryRE =
+        std::regex(R"re([;[:space:]]boundary=([^;[:space:]]+))re",
+                   std::regex::icase | std::regex::extended);
+    std::smatch m;
+    std::regex_search(header.begin(), header.end(), m, kBoundaryRE);
+    return m[1];
+  }
+
+  std::pair<std::string::const_iterator, std::string::const_iterator> Find(
+      std::string::const_iterator begin,
+      std::string::const_iterator end) const {
+    auto found = std::search(begin, end, part_searcher_);
+    if (found != end) return {found, found + part_marker_.size()};
+    found = std::search(begin, end, body_searcher_);
+    if (found != end) return {found, found + body_marker_.size()};
+    return {end, end};
+  }
+
+  static std::size_t ParsePart(std::string_view part) {
+    static auto const kContentDispositionRE = std::regex(
+        R"re(^content-disposition:)re",
+        std::regex::extended | std::regex::icase | std::regex::optimize);
+    static auto const kNameRE =
+        std::regex(R"re([;[:space:]]name=([^[:space:];]+))re",
+                   std::regex::extended | std::regex::icase);
+    auto const separator = part.find("\r\n\r\n");
+    auto const headers = part.substr(0, separator);
+    // The example copies each header line into a new string.
+    std::vector<std::string> lines;
+    for (std::size_t p = 0; p != std::string_view::npos;) {
+      auto const eol = headers.find("\r\n", p);
+      lines.emplace_back(headers.substr(p, eol - p));
+      p = eol == std::string_view::npos ? eol : eol + 2;
+    }
+    std::size_t size = 0;
+    for (auto const& h : lines) {
+      if (!std::regex_search(h.begin(), h.end(), kContentDispositionRE)) {
+        continue;
+      }
+      std::smatch m;
+      if (std::regex_search(h.begin(), h.end(), m, kNameRE)) {
+        size += m[1].length();
+      }
+    }
+    return size + part.size() - separator;
+  }
+
+  std::string part_marker_;
+  std::string body_marker_;
+  Searcher part_searcher_;
+  Searcher body_searcher_;
+};
+
+void BM_Example(benchmark::State& state) {
+  auto const body = MakeBody(state.range(0) * 1024);
+  for (auto _ : state) {
+    ExampleParser parser(kContentType);
+    benchmark::DoNotOptimize(parser.Parse(body));
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(body.size()));
+}
+BENCHMARK(BM_Example)->Arg(1)->Arg(64)->Arg(1024);
+
+void BM_MultipartParser(benchmark::State& state) {
+  auto const body = MakeBody(state.range(0) * 1024);
+  auto constexpr kChunkSize = std::size_t{64 * 1024};
+  for (auto _ : state) {
+    std::size_t total = 0;
+    auto boundary = MultipartParser::BoundaryFromContentType(kContentType);
+    MultipartParser parser(
+        *boundary,
+        [&](MultipartPart const& part) { total += part.name().size(); },
+        [&](std::string_view data) { total += data.size(); });
+    for (std::size_t offset = 0; offset < body.size(); offset += kChunkSize) {
+      parser.Parse(std::string_view(body).substr(offset, kChunkSize));
+    }
+    parser.Finish();
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(body.size()));
+}
+BENCHMARK(BM_MultipartParser)->Arg(1)->Arg(64)->Arg(1024);
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,201 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/multipart_parser.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+
+auto constexpr kBoundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+
+std::string MakeBody() {
+  std::string const b = kBoundary;
+  return "preamble, ignored\r\n"
+         "--" + b + "\r\n"
+         "Content-Disposition: form-data; name=\"title\"\r\n"
+         "\r\n"
+         "Hello World\r\n"
+         "--" + b + "  \r\n"
+         "content-disposition: form-data; name=\"upload\";"
+         " filename=\"a \\\"b\\\".txt\"\r\n"
+         "Content-Type: application/octet-stream\r\n"
+         "\r\n"
+         "line 1\r\n--" + b.substr(0, 10) + "\r\n\r\n--\r\r\n-\r\n"
+         "--" + b + "\r\n"
+         "\r\n"
+         "no headers\r\n"
+         "--" + b + "--\r\n"
+         "epilogue, ignored";
+}
+
+std::string const kFile = "line 1\r\n--" + std::string(kBoundary, 10) +
+                          "\r\n\r\n--\r\r\n-";
+
+struct Part {
+  std::string name;
+  std::string body;
+  bool ended = false;
+};
+
+std::vector<Part> ParseInChunks(std::string const& body, std::size_t size) {
+  std::vector<Part> parts;
+  MultipartParser parser(
+      kBoundary,
+      [&](MultipartPart const& part) { parts.push_back({part.name(), {}}); },
+      [&](std::string_view data) { parts.back().body += data; },
+      [&](MultipartPart const& part) {
+        EXPECT_EQ(part.name(), parts.back().name);
+        parts.back().ended = true;
+      });
+  for (std::size_t offset = 0; offset < body.size(); offset += size) {
+    parser.Parse(std::string_view(body).substr(offset, size));
+  }
+  EXPECT_TRUE(parser.done());
+  parser.Finish();
+  return parts;
+}
+
+TEST(MultipartParserTest, BoundaryFromContentType) {
+  EXPECT_THAT(MultipartParser::BoundaryFromContentType(
+                  "multipart/form-data; boundary=abc"),
+              Optional(std::string("abc")));
+  EXPECT_THAT(MultipartParser::BoundaryFromContentType(
+                  "multipart/form-data;charset=utf-8; BOUNDARY=\"a b;c\""),
+              Optional(std::string("a b;c")));
+  EXPECT_EQ(MultipartParser::BoundaryFromContentType("multipart/form-data"),
+            std::nullopt);
+  EXPECT_EQ(MultipartParser::BoundaryFromContentType(
+                "multipart/form-data; boundary="),
+            std::nullopt);
+}
+
+TEST(MultipartParserTest, ParseMultipart) {
+  auto const body = MakeBody();
+  auto const parts = ParseMultipart(body, kBoundary);
+  ASSERT_EQ(parts.size(), 3);
+
+  EXPECT_EQ(parts[0].part.name(), "title");
+  EXPECT_EQ(parts[0].part.filename(), std::nullopt);
+  EXPECT_EQ(parts[0].part.content_type(), "text/plain");
+  EXPECT_EQ(parts[0].body, "Hello World");
+
+  EXPECT_EQ(parts[1].part.name(), "upload");
+  EXPECT_THAT(parts[1].part.filename(), Optional(std::string("a \"b\".txt")));
+  EXPECT_EQ(parts[1].part.content_type(), "application/octet-stream");
+  EXPECT_EQ(parts[1].part.headers().size(), 2);
+  EXPECT_EQ(parts[1].body, kFile);
+  // The bodies are views into the payload.
+  EXPECT_GE(parts[1].body.data(), body.data());
+  EXPECT_LE(parts[1].body.data() + parts[1].body.size(),
+            body.data() + body.size());
+
+  EXPECT_THAT(parts[2].part.headers(), IsEmpty());
+  EXPECT_EQ(parts[2].body, "no headers");
+}
+
+TEST(MultipartParserTest, Chunks) {
+  auto const body = MakeBody();
+  for (std::size_t size : {1, 2, 3, 5, 7, 11, 16, 41, 64, 1024}) {
+    SCOPED_TRACE("chunk size=" + std::to_string(size));
+    auto const parts = ParseInChunks(body, size);
+    ASSERT_EQ(parts.size(), 3);
+    EXPECT_EQ(parts[0].name, "title");
+    EXPECT_EQ(parts[0].body, "Hello World");
+    EXPECT_EQ(parts[1].name, "upload");
+    EXPECT_EQ(parts[1].body, kFile);
+    EXPECT_EQ(parts[2].body, "no headers");
+    for (auto const& p : parts) EXPECT_TRUE(p.ended);
+  }
+}
+
+TEST(MultipartParserTest, NoPreamble) {
+  std::string const b = kBoundary;
+  auto const body = "--" + b + "\r\n" +
+                    "Content-Disposition: form-data; name=a\r\n" +
+                    "X-Folded: 1\r\n 2\r\n\r\n\r\n--" + b + "--";
+  auto const parts = ParseMultipart(body, kBoundary);
+  ASSERT_EQ(parts.size(), 1);
+  EXPECT_EQ(parts[0].part.name(), "a");
+  EXPECT_EQ(parts[0].part.headers().find("x-folded")->second, "1 2");
+  EXPECT_THAT(parts[0].body, IsEmpty());
+
+  EXPECT_THAT(ParseMultipart("--" + b + "--\r\n", kBoundary), IsEmpty());
+}
+
+/// Returns the data in chunks of at most `size` bytes.
+class FakeReader : public HttpBodyReader::Impl {
+ public:
+  FakeReader(std::string data, std::size_t size)
+      : data_(std::move(data)), size_(size) {}
+
+  std::size_t Read(char* buffer, std::size_t size) override {
+    auto const n = std::min({size, size_, data_.size() - offset_});
+    std::copy_n(data_.data() + offset_, n, buffer);
+    offset_ += n;
+    return n;
+  }
+
+ private:
+  std::string data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+};
+
+TEST(MultipartParserTest, Reader) {
+  std::vector<std::string> names;
+  std::string data;
+  MultipartParser parser(
+      kBoundary, [&](MultipartPart const& p) { names.push_back(p.name()); },
+      [&](std::string_view d) { data += d; });
+  HttpBodyReader reader(std::make_unique<FakeReader>(MakeBody(), 13));
+  parser.Parse(reader);
+  EXPECT_THAT(names, ElementsAre("title", "upload", ""));
+  EXPECT_EQ(data, "Hello World" + kFile + "no headers");
+}
+
+TEST(MultipartParserTest, Errors) {
+  auto noop = [](auto const&) {};
+  EXPECT_THROW(MultipartParser("", noop, noop), std::invalid_argument);
+  EXPECT_THROW(MultipartParser(std::string(71, 'a'), noop, noop),
+               std::invalid_argument);
+
+  std::string const b = kBoundary;
+  auto const truncated = MakeBody().substr(0, 200);
+  EXPECT_THROW(ParseMultipart(truncated, kBoundary), std::invalid_argument);
+  EXPECT_THROW(ParseMultipart("no boundary", kBoundary), std::invalid_argument);
+  EXPECT_THROW(ParseMultipart("--" + b + "x\r\n\r\n\r\n--" + b + "--", b),
+               std::invalid_argument);
+  EXPECT_THROW(
+      ParseMultipart("--" + b + "\r\nno colon\r\n\r\n--" + b + "--", b),
+      std::invalid_argument);
+  auto const large = "--" + b + "\r\nX-Large: " +
+                     std::string(MultipartParser::kMaxHeaderBytes, 'a') +
+                     "\r\n\r\n\r\n--" + b + "--";
+  EXPECT_THROW(ParseMultipart(large, b), std::invalid_argument);
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
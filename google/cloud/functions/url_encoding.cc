@@ -0,0 +1,98 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/url_encoding.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// The value of each hex digit, -1 for any other character.
+constexpr std::array<int, 256> MakeHexTable() {
+  std::array<int, 256> table{};
+  for (auto& v : table) v = -1;
+  for (int i = 0; i != 10; ++i) table['0' + i] = i;
+  for (int i = 0; i != 6; ++i) {
+    table['a' + i] = 10 + i;
+    table['A' + i] = 10 + i;
+  }
+  return table;
+}
+
+auto constexpr kHexTable = MakeHexTable();
+
+int HexValue(char c) { return kHexTable[static_cast<unsigned char>(c)]; }
+
+std::string Decode(std::string_view encoded, bool plus_as_space) {
+  // The decoded string is never longer than the input, write directly into a
+  // buffer of that size and trim it at the end.
+  std::string result(encoded.size(), '\0');
+  auto* out = result.data();
+  auto const* in = encoded.data();
+  auto const* const end = in + encoded.size();
+  while (in != end) {
+    // Copy the text before the next escape in a single step, `memchr()` is
+    // vectorized in most C libraries, and most values have few escapes.
+    auto const* escape = static_cast<char const*>(
+        std::memchr(in, '%', static_cast<std::size_t>(end - in)));
+    if (escape == nullptr) escape = end;
+    out = std::copy(in, escape, out);
+    if (plus_as_space) std::replace(out - (escape - in), out, '+', ' ');
+    in = escape;
+    if (in == end) break;
+
+    auto const hi = end - in < 3 ? -1 : HexValue(in[1]);
+    auto const lo = end - in < 3 ? -1 : HexValue(in[2]);
+    if (hi < 0 || lo < 0) {
+      *out++ = *in++;
+      continue;
+    }
+    *out++ = static_cast<char>(hi * 16 + lo);
+    in += 3;
+  }
+  result.resize(static_cast<std::size_t>(out - result.data()));
+  return result;
+}
+
+}  // namespace
+
+std::string PercentDecode(std::string_view encoded) {
+  return Decode(encoded, /*plus_as_space=*/false);
+}
+
+std::string FormDecode(std::string_view encoded) {
+  return Decode(encoded, /*plus_as_space=*/true);
+}
+
+QueryParameters ParseFormUrlEncoded(std::string_view text) {
+  QueryParameters result;
+  while (!text.empty()) {
+    auto const end = text.find('&');
+    auto const field = text.substr(0, end);
+    text = end == std::string_view::npos ? std::string_view{}
+                                         : text.substr(end + 1);
+    if (field.empty()) continue;
+    auto const eq = field.find('=');
+    auto const value = eq == std::string_view::npos ? std::string_view{}
+                                                    : field.substr(eq + 1);
+    result.emplace(FormDecode(field.substr(0, eq)), FormDecode(value));
+  }
+  return result;
+}
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
@@ -0,0 +1,62 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_URL_ENCODING_H
+#define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_URL_ENCODING_H
+
+#include "google/cloud/functions/version.h"
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * The decoded name and value pairs in a query string or form.
+ *
+ * Repeated names keep their order, use `equal_range()` to get all the values.
+ * Lookups accept any string type, e.g. `params.find("name")` does not
+ * allocate.
+ */
+using QueryParameters = std::multimap<std::string, std::string, std::less<>>;
+
+/**
+ * Decodes the `%XX` escapes (RFC 3986 2.1) in @p encoded.
+ *
+ * Malformed escapes, such as `%zz` or a trailing `%`, are copied unchanged.
+ */
+std::string PercentDecode(std::string_view encoded);
+
+/**
+ * Decodes a name or value in `application/x-www-form-urlencoded` data.
+ *
+ * This is the same as `PercentDecode()`, except that `+` decodes as a space.
+ */
+std::string FormDecode(std::string_view encoded);
+
+/**
+ * Parses `application/x-www-form-urlencoded` data, e.g. a query string or the
+ * payload of an HTML form.
+ *
+ * The fields are separated by `&`. Fields without a `=` have an empty value,
+ * and empty fields are ignored.
+ */
+QueryParameters ParseFormUrlEncoded(std::string_view text);
+
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
+
+#endif  // FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_URL_ENCODING_H
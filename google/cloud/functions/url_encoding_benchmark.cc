@@ -0,0 +1,78 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/url_encoding.h"
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <string>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// The naive decoder copies one character at a time, as functions that
+// implement their own decoding often do. Arg(0) has no escapes, Arg(1) has
+// an escape every 8 characters.
+
+std::string MakeInput(bool escapes) {
+  std::string input;
+  for (int i = 0; i != 64; ++i) {
+    input += escapes ? "abcd%20e" : "abcdefgh";
+  }
+  return input;
+}
+
+std::string NaiveDecode(std::string const& encoded) {
+  std::string result;
+  for (std::size_t i = 0; i != encoded.size(); ++i) {
+    if (encoded[i] != '%' || i + 3 > encoded.size()) {
+      result.push_back(encoded[i]);
+      continue;
+    }
+    char value;
+    auto const* end = encoded.data() + i + 3;
+    auto r = std::from_chars(encoded.data() + i + 1, end, value, 16);
+    if (r.ec == std::errc{} && r.ptr == end) {
+      result.push_back(value);
+      i += 2;
+    } else {
+      result.push_back(encoded[i]);
+    }
+  }
+  return result;
+}
+
+void BM_NaiveDecode(benchmark::State& state) {
+  auto const input = MakeInput(state.range(0) != 0);
+  for (auto _ : state) benchmark::DoNotOptimize(NaiveDecode(input));
+}
+BENCHMARK(BM_NaiveDecode)->Arg(0)->Arg(1);
+
+void BM_PercentDecode(benchmark::State& state) {
+  auto const input = MakeInput(state.range(0) != 0);
+  for (auto _ : state) benchmark::DoNotOptimize(PercentDecode(input));
+}
+BENCHMARK(BM_PercentDecode)->Arg(0)->Arg(1);
+
+void BM_ParseFormUrlEncoded(benchmark::State& state) {
+  auto const input = std::string(
+      "name=Jane+Doe&email=jane%40example.com&city=S%C3%A3o%20Paulo"
+      "&page=2&sort=date&tag=a&tag=b&q=hello+world");
+  for (auto _ : state) benchmark::DoNotOptimize(ParseFormUrlEncoded(input));
+}
+BENCHMARK(BM_ParseFormUrlEncoded);
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
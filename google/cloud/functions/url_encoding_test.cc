@@ -0,0 +1,68 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/functions/url_encoding.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google::cloud::functions {
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+
+TEST(UrlEncodingTest, PercentDecode) {
+  EXPECT_EQ(PercentDecode(""), "");
+  EXPECT_EQ(PercentDecode("/index.html"), "/index.html");
+  EXPECT_EQ(PercentDecode("a%20b%2Fc"), "a b/c");
+  EXPECT_EQ(PercentDecode("%e2%82%AC"), "\xe2\x82\xac");
+  EXPECT_EQ(PercentDecode("a+b"), "a+b");
+  EXPECT_EQ(PercentDecode("%00"), std::string(1, '\0'));
+}
+
+TEST(UrlEncodingTest, PercentDecodeMalformed) {
+  EXPECT_EQ(PercentDecode("%"), "%");
+  EXPECT_EQ(PercentDecode("abc%4"), "abc%4");
+  EXPECT_EQ(PercentDecode("%zz%41"), "%zzA");
+  EXPECT_EQ(PercentDecode("100%"), "100%");
+  EXPECT_EQ(PercentDecode("%%41"), "%A");
+}
+
+TEST(UrlEncodingTest, FormDecode) {
+  EXPECT_EQ(FormDecode("a+b%2Bc"), "a b+c");
+  EXPECT_EQ(FormDecode("+%20+"), "   ");
+}
+
+TEST(UrlEncodingTest, ParseFormUrlEncoded) {
+  EXPECT_THAT(ParseFormUrlEncoded(""), IsEmpty());
+  EXPECT_THAT(ParseFormUrlEncoded("name=Jane+Doe&city=S%C3%A3o%20Paulo"),
+              ElementsAre(Pair("city", "S\xc3\xa3o Paulo"),
+                          Pair("name", "Jane Doe")));
+  EXPECT_THAT(ParseFormUrlEncoded("a=1&&b&c=&=d&e=x=y"),
+              ElementsAre(Pair("", "d"), Pair("a", "1"), Pair("b", ""),
+                          Pair("c", ""), Pair("e", "x=y")));
+
+  auto const repeated = ParseFormUrlEncoded("tag=b&x=1&tag=a&tag=c");
+  auto const [begin, end] = repeated.equal_range("tag");
+  std::vector<std::string> tags;
+  for (auto i = begin; i != end; ++i) tags.push_back(i->second);
+  EXPECT_THAT(tags, ElementsAre("b", "a", "c"));
+}
+
+}  // namespace
+FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud::functions
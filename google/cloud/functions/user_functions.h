@@ -16,10 +16,14 @@
 #define FUNCTIONS_FRAMEWORK_CPP_GOOGLE_CLOUD_FUNCTIONS_USER_FUNCTIONS_H
 
 #include "google/cloud/functions/cloud_event.h"
+#include "google/cloud/functions/http_body_reader.h"
 #include "google/cloud/functions/http_request.h"
+#include "google/cloud/functions/http_request_view.h"
 #include "google/cloud/functions/http_response.h"
+#include "google/cloud/functions/http_response_writer.h"
 #include "google/cloud/functions/version.h"
 #include <functional>
+#include <optional>
 
 namespace google::cloud::functions {
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
@@ -27,8 +31,51 @@ FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_BEGIN
 using UserHttpFunction =
     std::function<functions::HttpResponse(functions::HttpRequest)>;
 
+/**
+ * An HTTP function that reads the request without copying it.
+ *
+ * The `HttpRequestView` refers to the buffers where the framework parsed the
+ * request, it is only valid while the function runs.
+ */
+using UserHttpViewFunction =
+    std::function<functions::HttpResponse(functions::HttpRequestView)>;
+
+/**
+ * An HTTP function that reads the request body incrementally.
+ *
+ * The `HttpRequest` contains the request header, its payload is empty. The
+ * function reads the body using the `HttpBodyReader`.
+ */
+using UserHttpStreamingFunction = std::function<functions::HttpResponse(
+    functions::HttpRequest, functions::HttpBodyReader)>;
+
+/**
+ * An HTTP function that writes its response incrementally.
+ *
+ * The function sends the response using the `HttpResponseWriter`, the client
+ * receives each write as soon as it is made.
+ */
+using UserHttpWriterFunction = std::function<void(
+    functions::HttpRequest, functions::HttpResponseWriter)>;
+
 using UserCloudEventFunction = std::function<void(functions::CloudEvent)>;
 
+/**
+ * Inspects an HTTP request before the framework reads its body.
+ *
+ * The `HttpRequest` contains the request line and header, its payload is
+ * empty. The hook returns `std::nullopt` to accept the request, or a response
+ * to reject it without reading the body, e.g., with a `401 Unauthorized`,
+ * `413 Payload Too Large`, or `415 Unsupported Media Type` status.
+ *
+ * Clients that send `Expect: 100-continue` receive `100 Continue` only once
+ * the hook accepts the request, so rejected clients never send the body.
+ *
+ * The hook runs in the thread that reads the request, it should not block.
+ */
+using UserPreBodyHook = std::function<std::optional<functions::HttpResponse>(
+    functions::HttpRequest const&)>;
+
 FUNCTIONS_FRAMEWORK_CPP_INLINE_NAMESPACE_END
 }  // namespace google::cloud::functions
 